@@ -14,6 +14,8 @@
 
 #include <stdint.h>
 
+#include "conf_transport.h"
+
 /**
  * @brief ESP32 specific configs
  *
@@ -21,18 +23,11 @@
 const uint8_t LED_BUILTIN = 2;
 
 /**
- * @brief Selection of robot kinematics.
- * MECANUM_4WHEEL: Kinematics of a four wheeled mecanum drive.
- * SWERVE_3WHEEL: Kinematics of a robot with three swerve drives.
- */
-#define MECANUM_4WHEEL
-// #define SWERVE_3WHEEL
-
-#ifdef MECANUM_4WHEEL
-/**
- * @brief Definitions of hardware parameters. Leghts in meters, angles in
- * degree.
+ * @brief Definitions of hardware parameters of the four wheeled mecanum drive
+ * run by the firmware. Leghts in meters, angles in degree.
  *
+ * The other models of kinematics/kinematics.hpp, e.g. swerve, are kinematics
+ * only, the firmware has no outputs for steering actuators.
  */
 
 const float WHEEL_RADIUS = 0.06; // 0.0835; // radius of wheels
@@ -41,6 +36,10 @@ const float WHEEL_BASE =
 const float TRACK_WIDTH =
     0.38; // distance between wheel contact point in y direction
 
+// Commands above it are scaled down, below the no-load speed of the motors
+// to leave the feedback some headroom
+const float MAX_WHEEL_SPEED = 25.0; // rad/s
+
 //--------------------------pinout
 // definitions------------------------------------
 
@@ -70,9 +69,9 @@ const uint8_t M1_PWM_CNL = 1;
 const uint8_t M2_PWM_CNL = 2;
 const uint8_t M3_PWM_CNL = 3;
 
+// The LEDC timer runs at 80 MHz, 2^M_PWM_RES * M_PWM_FRQ must stay below
 const uint16_t M_PWM_FRQ = 15000; // Hz
-const uint8_t M_PWM_RES = 8;      // 2^n Bits
-#endif
+const uint8_t M_PWM_RES = 12;     // 2^n Bits
 
 // Uncomment if encoders should be used in the system
 #define ENCODERS
@@ -100,4 +99,106 @@ const uint16_t M3_ENC_RESOLUTION = 360;
 
 #endif
 
+/**
+ * @brief Wheel PIDs and minimum output of the motors, used until a motor was
+ * tuned (see utils/autotune_storage.hpp).
+ *
+ */
+const float WHEEL_PID_KP = 0.105;
+const float WHEEL_PID_KI = 0.125;
+const float WHEEL_PID_KD = 0.005;
+const float WHEEL_PID_MAX_SAMPLING_TIME = 0.2; // s
+const float WHEEL_PID_MAX_INTEGRAL = 5.2;
+const float MOTOR_MIN_OUTPUT = 0.35; // A stopped motor stalls below it
+
+/**
+ * @brief Configuration of the real-time control task. The control loop runs
+ * at a fixed rate on its own core, while micro-ROS runs in the Arduino loop on
+ * the other core (see ARDUINO_RUNNING_CORE in platformio.ini).
+ *
+ * @note The control frequency can not exceed the FreeRTOS tick rate (1 kHz).
+ */
+const uint16_t CONTROL_TASK_FREQUENCY = 1000;  // Hz
+const uint8_t CONTROL_TASK_CORE = 1;           // Core 0 runs micro-ROS
+const uint8_t CONTROL_TASK_PRIORITY = 10;      // Arduino loop runs at 1
+const uint32_t CONTROL_TASK_STACK_SIZE = 4096; // bytes
+
+/**
+ * @brief Rate groups of the control task (see ControlRates in
+ * rtos/control_task.hpp). The frequencies are rounded to divisors of
+ * CONTROL_TASK_FREQUENCY, a run longer than its deadline counts as an overrun.
+ */
+const uint16_t CONTROL_SETPOINT_FREQUENCY = 100;   // Hz
+const uint32_t CONTROL_SETPOINT_DEADLINE_US = 50;
+const uint16_t CONTROL_KINEMATICS_FREQUENCY = 200; // Hz
+const uint32_t CONTROL_KINEMATICS_DEADLINE_US = 100;
+const uint16_t CONTROL_MOTOR_FREQUENCY = 1000;     // Hz
+const uint32_t CONTROL_MOTOR_DEADLINE_US = 400;
+const uint16_t CONTROL_ODOMETRY_FREQUENCY = 200;   // Hz
+const uint32_t CONTROL_ODOMETRY_DEADLINE_US = 100;
+
+/**
+ * @brief Limits of the setpoint generator in the control task (see
+ * utils/setpoint_generator.hpp). cmd_vel is ramped to at most these
+ * accelerations and jerks at the setpoint rate, 0 disables a limit. Without a
+ * new cmd_vel within CMD_VEL_TIMEOUT, the robot is ramped to a stop. The
+ * watchdog can't be disabled, the timeout is at least one setpoint cycle.
+ *
+ */
+const float MAX_LINEAR_ACCELERATION = 1.0;  // m/s^2
+const float MAX_ANGULAR_ACCELERATION = 3.0; // rad/s^2
+const float MAX_LINEAR_JERK = 10.0;         // m/s^3
+const float MAX_ANGULAR_JERK = 30.0;        // rad/s^3
+const uint32_t CMD_VEL_TIMEOUT = 500000;    // us
+static_assert(uint64_t(CMD_VEL_TIMEOUT) * CONTROL_SETPOINT_FREQUENCY >= 1000000,
+              "CMD_VEL_TIMEOUT must be at least one setpoint cycle");
+
+/**
+ * @brief Publishing rates of the micro-ROS topics. They are independent of the
+ * control frequency, values measured in between are averaged or dropped (see
+ * core.cpp). A rate of 0 publishes only on change or on request.
+ *
+ * The rates fit the link of the transport profile (see fit_publish_rate() in
+ * conf_transport.h): odom at 4.7 Hz and joint_states at 7.5 Hz at 115200
+ * baud, 37 Hz and 20 Hz at 921600 baud, 50 Hz and 20 Hz from 2000000 baud.
+ * wanted_joint_states takes the remaining 10 % of the budget.
+ */
+const float ODOM_MESSAGE_BYTES = 740;       // Serialized, with XRCE header
+const float JOINT_STATE_MESSAGE_BYTES = 230; // Serialized, with XRCE header
+const float ODOM_PUBLISH_RATE =
+    fit_publish_rate(50.0, 0.6, ODOM_MESSAGE_BYTES);        // Hz
+const float JOINT_STATE_PUBLISH_RATE =
+    fit_publish_rate(20.0, 0.3, JOINT_STATE_MESSAGE_BYTES); // Hz
+const float WANTED_JOINT_STATE_PUBLISH_RATE = 0.0;          // Hz, on change
+// During a ramp the set velocities change every cycle, changes are then
+// published at most at this rate
+const float WANTED_JOINT_STATE_MAX_RATE =
+    fit_publish_rate(20.0, 0.1, JOINT_STATE_MESSAGE_BYTES); // Hz
+
+/**
+ * @brief Compact binary telemetry of the control loop on the "telemetry" topic
+ * (see communication/telemetry.hpp). Every TELEMETRY_DECIMATION-th control
+ * cycle is recorded, 0 disables the topic. TELEMETRY_BATCH_SIZE samples are
+ * sent per message, 4 samples (476 bytes) fit the default 512 byte MTU.
+ *
+ */
+const uint16_t TELEMETRY_DECIMATION = 0;
+const uint8_t TELEMETRY_BATCH_SIZE = 4;
+
+/**
+ * @brief Full rate trace of the control loop (see utils/trace_buffer.hpp).
+ * The last TRACE_CAPACITY cycles are recorded, in PSRAM if available. The
+ * "trace/trigger" service or a tracking error above TRACE_TRIGGER_THRESHOLD
+ * (rad/s, 0 disables it) freezes the trace TRACE_POST_TRIGGER cycles later.
+ * It is then sent on the "trace" topic in chunks of TRACE_CHUNK_SIZE records
+ * (7 records, 492 bytes, fit the default 512 byte MTU) at TRACE_CHUNK_RATE.
+ * A capacity of 0 disables the trace. Each record takes 68 bytes.
+ *
+ */
+const uint16_t TRACE_CAPACITY = 512; // Must be a power of two
+const uint16_t TRACE_POST_TRIGGER = 256;
+const float TRACE_TRIGGER_THRESHOLD = 0.0; // rad/s
+const uint8_t TRACE_CHUNK_SIZE = 7;
+const float TRACE_CHUNK_RATE = 50.0; // Hz
+
 #endif // CONF_HARDWARE_H
\ No newline at end of file
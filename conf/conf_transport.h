@@ -0,0 +1,94 @@
+/**
+ * @file conf_transport.h
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Selection of the micro-ROS transport profile.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONF_TRANSPORT_H
+#define CONF_TRANSPORT_H
+
+#include <stdint.h>
+
+/**
+ * @brief The transport profile is selected with build flags, see the
+ * esp32-serial-* and esp32-wifi environments in platformio.ini.
+ *
+ * MICRO_ROS_TRANSPORT_WIFI: UDP over WiFi with best effort publishers. Needs
+ * conf_network.h (see conf_network_example.h) and
+ * board_microros_transport = wifi.
+ * Otherwise: UART with MICRO_ROS_SERIAL_BAUD. The agent must be started with
+ * the same baud rate, e.g. micro_ros_agent serial --dev /dev/ttyUSB0 -b 921600
+ *
+ * @note The CP2102 of the ESP32 DevKit v1 is specified up to 921600 baud,
+ * 2000000 baud needs a faster USB-UART bridge (e.g. CP2102N or CH343).
+ */
+// #define MICRO_ROS_TRANSPORT_WIFI
+
+#ifndef MICRO_ROS_SERIAL_BAUD
+#define MICRO_ROS_SERIAL_BAUD 115200
+#endif
+
+/**
+ * @brief Bytes per second the periodic topics may publish, half of the link.
+ * The rest is left for cmd_vel, the services, the diagnostics and the XRCE
+ * acknowledgements. A UART frame takes 10 bits per byte, WiFi is assumed to
+ * carry at least 1 MB/s.
+ *
+ */
+#ifdef MICRO_ROS_TRANSPORT_WIFI
+constexpr float PUBLISH_BYTES_PER_SECOND = 0.5f * 1000000.0f;
+#else
+constexpr float PUBLISH_BYTES_PER_SECOND =
+    0.5f * MICRO_ROS_SERIAL_BAUD / 10.0f;
+#endif
+
+/**
+ * @brief The rate of a topic, limited so it takes at most its share of
+ * PUBLISH_BYTES_PER_SECOND.
+ *
+ * @param max_rate The rate in Hz on a fast link.
+ * @param share The share of the publish budget, 0 to 1.
+ * @param message_bytes The serialized size of a message.
+ * @return float The rate in Hz.
+ */
+constexpr float fit_publish_rate(const float max_rate, const float share,
+                                 const float message_bytes)
+{
+    return share * PUBLISH_BYTES_PER_SECOND / message_bytes < max_rate
+               ? share * PUBLISH_BYTES_PER_SECOND / message_bytes
+               : max_rate;
+}
+
+/**
+ * @brief QoS of the topics. A reliable publish waits for the acknowledgement of
+ * the agent and can block the loop, a best effort publish never blocks. On
+ * WiFi, all topics are best effort regardless of these settings.
+ *
+ */
+const bool ODOM_BEST_EFFORT = true;
+const bool JOINT_STATE_BEST_EFFORT = true;
+const bool WANTED_JOINT_STATE_BEST_EFFORT = true;
+const bool DIAGNOSTICS_BEST_EFFORT = true;
+const bool CMD_VEL_BEST_EFFORT = true;
+const bool TELEMETRY_BEST_EFFORT = true;
+// A trace is only useful if complete, its chunks are sent at a low rate
+const bool TRACE_BEST_EFFORT = false;
+
+/**
+ * @brief Supervision of the agent session, see ConnectionManager. While no
+ * agent answers, it is pinged every AGENT_PING_INTERVAL_MS. While connected,
+ * a heartbeat of AGENT_HEARTBEAT_ATTEMPTS unanswered pings in a row ends the
+ * session, which is then created again once the agent is back.
+ *
+ */
+const uint32_t AGENT_PING_INTERVAL_MS = 500;
+const uint32_t AGENT_HEARTBEAT_INTERVAL_MS = 1000;
+const int AGENT_PING_TIMEOUT_MS = 20;
+const uint8_t AGENT_HEARTBEAT_ATTEMPTS = 3;
+
+#endif // CONF_TRANSPORT_H
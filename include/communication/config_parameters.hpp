@@ -0,0 +1,98 @@
+/**
+ * @file config_parameters.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief ROS parameters of the robot configuration.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONFIG_PARAMETERS_H
+#define CONFIG_PARAMETERS_H
+
+#include <rclc_parameter/rclc_parameter.h>
+
+#include "utils/config_store.hpp"
+
+/**
+ * @brief The ConfigParameters class exposes the limits and the hardware of a
+ * RobotConfig as parameters of the rclc parameter server. The gain schedule
+ * has its own parameters, see GainScheduleParameters.
+ *
+ * Applied while running, at the start of the next control cycle:
+ *
+ *   config.max_linear_acceleration    in m/s^2, 0 is unlimited
+ *   config.max_angular_acceleration   in rad/s^2, 0 is unlimited
+ *   config.max_linear_jerk            in m/s^3, 0 is unlimited
+ *   config.max_angular_jerk           in rad/s^3, 0 is unlimited
+ *   config.cmd_vel_timeout            in s, at least one setpoint cycle
+ *   config.max_wheel_speed            in rad/s, 0 is unlimited
+ *   config.saturation_policy          integer, see SaturationPolicy
+ *
+ * Applied on the next boot, once the configuration was saved:
+ *
+ *   config.wheel_radius, config.wheel_base, config.track_width   in m, > 0
+ *   config.pwm_frequency              integer in Hz
+ *   config.pwm_resolution             integer in bits
+ *   config.motor_<i>.in1, .in2, .ena, .pwm_channel, .encoder_a,
+ *   config.motor_<i>.encoder_b        integer pins and channel, in1, in2
+ *                                     and ena are outputs, at most GPIO 33
+ *   config.motor_<i>.encoder_resolution   integer pulses per revolution
+ *   config.motor_<i>.min_output       0 to 1, the stiction once tuned
+ *
+ * E.g. ros2 param set /roboost_pmc_node config.max_linear_acceleration 0.5
+ *
+ * @tparam WheelCount The number of wheels, at most 10.
+ */
+template <int WheelCount>
+class ConfigParameters
+{
+public:
+    static constexpr size_t PARAMETER_COUNT = 12 + 8 * WheelCount;
+
+    /**
+     * @brief Construct a new Config Parameters object.
+     *
+     * @param config The initial values of the parameters.
+     */
+    ConfigParameters(const RobotConfig<WheelCount>& config);
+
+    /**
+     * @brief Add all parameters to a parameter server and set them to the
+     * values of the configuration.
+     *
+     * @param parameter_server The initialized parameter server. Must be able
+     * to hold PARAMETER_COUNT more parameters.
+     * @return rcl_ret_t RCL_RET_OK on success.
+     */
+    rcl_ret_t declare(rclc_parameter_server_t* parameter_server) const;
+
+    /**
+     * @brief Apply a changed parameter to the configuration.
+     *
+     * @param parameter The new value of the parameter.
+     * @return true If the parameter belongs to the configuration and was
+     * applied.
+     * @return false If the parameter is unknown, of another type or out of
+     * range.
+     */
+    bool apply(const Parameter& parameter);
+
+    /**
+     * @brief Get the configuration.
+     *
+     * @return const RobotConfig<WheelCount>& The configuration with all
+     * applied parameters.
+     */
+    const RobotConfig<WheelCount>& get_config() const;
+
+private:
+    bool apply_double(const char* name, const scalar_t value);
+    bool apply_integer(const char* name, const int64_t value);
+
+    RobotConfig<WheelCount> config_;
+};
+
+#endif // CONFIG_PARAMETERS_H
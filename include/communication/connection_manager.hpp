@@ -0,0 +1,124 @@
+/**
+ * @file connection_manager.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Supervision of the session with the micro-ROS agent.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONNECTION_MANAGER_H
+#define CONNECTION_MANAGER_H
+
+#include <stdint.h>
+
+/**
+ * @brief State of the session with the agent.
+ *
+ * WAITING_AGENT: The agent is pinged until it answers.
+ * AGENT_AVAILABLE: The agent answered, the entities are created next.
+ * CONNECTED: The entities exist, the agent is pinged as a heartbeat.
+ * DISCONNECTED: The heartbeat or the creation failed, the entities are
+ * destroyed next.
+ */
+enum class ConnectionState : uint8_t
+{
+    WAITING_AGENT,
+    AGENT_AVAILABLE,
+    CONNECTED,
+    DISCONNECTED
+};
+
+/**
+ * @brief Timing of the agent pings.
+ *
+ */
+struct ConnectionConfig
+{
+    uint32_t ping_interval_ms = 500;       // While waiting for the agent
+    uint32_t heartbeat_interval_ms = 1000; // While connected
+    int ping_timeout_ms = 20;              // Per attempt
+    uint8_t heartbeat_attempts = 3;        // Failed in a row before the loss
+};
+
+/**
+ * @brief The ConnectionManager class brings the micro-ROS session up in the
+ * background and re-establishes it after the agent was lost, e.g. when it was
+ * restarted or the cable was unplugged.
+ *
+ *   WAITING_AGENT -> AGENT_AVAILABLE -> CONNECTED -> DISCONNECTED
+ *         ^                 |                             |
+ *         +-----------------+-----------------------------+
+ *
+ * Each update() does at most one step and only blocks for a ping or for the
+ * creation of the entities, so the loop keeps running while no agent is
+ * reachable. The destroy callback must tolerate partially created entities,
+ * it is also called after a failed creation.
+ *
+ * @note Must only be used from the task running micro-ROS.
+ */
+class ConnectionManager
+{
+public:
+    typedef bool (*CreateCallback)();
+    typedef void (*DestroyCallback)();
+
+    /**
+     * @brief Construct a new Connection Manager object. The agent is pinged
+     * with the first update().
+     *
+     * @param create Creates all entities, returns false if one failed.
+     * @param destroy Destroys all entities created so far.
+     * @param config The timing of the pings.
+     */
+    ConnectionManager(CreateCallback create, DestroyCallback destroy,
+                      const ConnectionConfig& config = ConnectionConfig());
+
+    /**
+     * @brief Advance the state machine by at most one step.
+     *
+     * @param now_ms The current time in milliseconds.
+     * @return ConnectionState The state after the step.
+     */
+    ConnectionState update(const uint32_t now_ms);
+
+    /**
+     * @brief Get the state of the session.
+     *
+     * @return ConnectionState The state after the last update().
+     */
+    ConnectionState get_state() const;
+
+    /**
+     * @brief Check whether the entities exist and the agent answers.
+     *
+     * @return true If the state is CONNECTED.
+     */
+    bool is_connected() const;
+
+    /**
+     * @brief Get the number of sessions established since boot.
+     *
+     * @return uint32_t The number of transitions to CONNECTED.
+     */
+    uint32_t get_connection_count() const;
+
+private:
+    /**
+     * @brief Check whether an interval elapsed since the last ping.
+     */
+    bool is_due(const uint32_t now_ms, const uint32_t interval_ms) const;
+
+    CreateCallback create_;
+    DestroyCallback destroy_;
+    const ConnectionConfig config_;
+
+    ConnectionState state_ = ConnectionState::WAITING_AGENT;
+    bool pinged_ = false; // No ping yet in the current state
+    uint32_t last_ping_ms_ = 0;
+    uint32_t connection_count_ = 0;
+};
+
+#endif // CONNECTION_MANAGER_H
@@ -0,0 +1,79 @@
+/**
+ * @file gain_schedule_parameters.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief ROS parameters of the gain schedule.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef GAIN_SCHEDULE_PARAMETERS_H
+#define GAIN_SCHEDULE_PARAMETERS_H
+
+#include <rclc_parameter/rclc_parameter.h>
+
+#include "utils/gain_schedule.hpp"
+
+/**
+ * @brief The GainScheduleParameters class exposes a GainSchedule as double
+ * parameters of the rclc parameter server, since rclc does not support array
+ * parameters:
+ *
+ *   gain_schedule.rotation_radius
+ *   gain_schedule.wheel_speed_<i>     breakpoints in rad/s
+ *   gain_schedule.twist_<j>           breakpoints in m/s
+ *   gain_schedule.kp_<i>_<j>, gain_schedule.ki_<i>_<j>,
+ *   gain_schedule.kd_<i>_<j>          gains at wheel speed i and twist j
+ *
+ * E.g. ros2 param set /roboost_pmc_node gain_schedule.ki_0_2 0.25
+ *
+ * While breakpoints are being changed one by one, the schedule may be invalid
+ * in between, see GainSchedule::is_valid().
+ */
+class GainScheduleParameters
+{
+public:
+    static constexpr size_t PARAMETER_COUNT =
+        1 + 2 * GainSchedule::BREAKPOINTS +
+        3 * GainSchedule::BREAKPOINTS * GainSchedule::BREAKPOINTS;
+
+    /**
+     * @brief Construct a new Gain Schedule Parameters object.
+     *
+     * @param schedule The initial values of the parameters.
+     */
+    GainScheduleParameters(const GainSchedule& schedule);
+
+    /**
+     * @brief Add all parameters to a parameter server and set them to the
+     * values of the schedule.
+     *
+     * @param parameter_server The initialized parameter server. Must be able
+     * to hold PARAMETER_COUNT more parameters.
+     * @return rcl_ret_t RCL_RET_OK on success.
+     */
+    rcl_ret_t declare(rclc_parameter_server_t* parameter_server) const;
+
+    /**
+     * @brief Apply a changed parameter to the schedule.
+     *
+     * @param parameter The new value of the parameter.
+     * @return true If the parameter belongs to the schedule and was applied.
+     * @return false If the parameter is unknown, not a double or negative.
+     */
+    bool apply(const Parameter& parameter);
+
+    /**
+     * @brief Get the schedule.
+     *
+     * @return const GainSchedule& The schedule with all applied parameters.
+     */
+    const GainSchedule& get_schedule() const;
+
+private:
+    GainSchedule schedule_;
+};
+
+#endif // GAIN_SCHEDULE_PARAMETERS_H
@@ -0,0 +1,93 @@
+/**
+ * @file latency_report.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Numeric latency summaries as a diagnostic_msgs/DiagnosticStatus.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LATENCY_REPORT_H
+#define LATENCY_REPORT_H
+
+#include <diagnostic_msgs/msg/diagnostic_status.h>
+#include <diagnostic_msgs/msg/key_value.h>
+#include <stdint.h>
+
+#include "utils/instrumentation.hpp"
+
+/**
+ * @brief The LatencyReport class collects latency summaries and counters as
+ * key/value pairs of a DiagnosticStatus message.
+ *
+ * A stage summary is added as the keys "<stage>.count", "<stage>.min_us",
+ * "<stage>.max_us", "<stage>.mean_us" and "<stage>.p99_us". All strings live in
+ * fixed buffers of the report, so building the message does not allocate.
+ */
+class LatencyReport
+{
+public:
+    static constexpr uint8_t MAX_VALUES = 48;
+    static constexpr uint8_t KEY_LENGTH = 32;
+
+    /**
+     * @brief Construct a new Latency Report object.
+     *
+     * @param name The name of the diagnostic status.
+     */
+    LatencyReport(const char* name);
+
+    /**
+     * @brief Add the summary of a stage.
+     *
+     * @param stage The name of the stage.
+     * @param summary The latency summary of the stage.
+     * @return true If the values were added.
+     * @return false If the report is full.
+     */
+    bool add(const char* stage, const LatencySummary& summary);
+
+    /**
+     * @brief Add a single value.
+     *
+     * @param key The key of the value.
+     * @param value The value.
+     * @return true If the value was added.
+     * @return false If the report is full.
+     */
+    bool add(const char* key, const uint32_t value);
+
+    /**
+     * @brief Remove all values and reset the level to OK.
+     *
+     */
+    void clear();
+
+    /**
+     * @brief Set the level of the diagnostic status.
+     *
+     * @param level One of the diagnostic_msgs__msg__DiagnosticStatus levels.
+     */
+    void set_level(const uint8_t level);
+
+    /**
+     * @brief Get the message to publish.
+     *
+     * @return const diagnostic_msgs__msg__DiagnosticStatus& The message.
+     */
+    const diagnostic_msgs__msg__DiagnosticStatus& get_message() const;
+
+private:
+    static constexpr uint8_t VALUE_LENGTH = 11; // Fits any uint32_t
+
+    void set_string(rosidl_runtime_c__String& string, char* buffer);
+
+    diagnostic_msgs__msg__DiagnosticStatus message_;
+    diagnostic_msgs__msg__KeyValue values_[MAX_VALUES];
+    char keys_[MAX_VALUES][KEY_LENGTH];
+    char value_strings_[MAX_VALUES][VALUE_LENGTH];
+};
+
+#endif // LATENCY_REPORT_H
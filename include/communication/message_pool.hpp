@@ -0,0 +1,101 @@
+/**
+ * @file message_pool.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Statically preallocated storage of all ROS messages of the node.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MESSAGE_POOL_H
+#define MESSAGE_POOL_H
+
+#include <geometry_msgs/msg/twist.h>
+#include <nav_msgs/msg/odometry.h>
+#include <sensor_msgs/msg/joint_state.h>
+#include <stdint.h>
+
+/**
+ * @brief The MessagePool class owns every message the node publishes or
+ * receives, together with the memory of their strings and sequences.
+ *
+ * All messages are fully initialized in the constructor. Afterwards, only
+ * values are written into them, so publishing never touches the heap.
+ *
+ * @tparam JointCount The number of wheel joints.
+ */
+template <int JointCount>
+class MessagePool
+{
+public:
+    static constexpr uint8_t MAX_NAME_LENGTH = 32; // Including the terminator
+
+    /**
+     * @brief Construct a new Message Pool object.
+     *
+     * @param odom_frame_id The frame of the odometry.
+     * @param base_frame_id The frame of the robot base.
+     * @param joint_names The names of the wheel joints.
+     * @param covariance_diagonal The diagonal of the pose and twist covariance
+     * (x, y, z, rotation about X, Y and Z).
+     *
+     * @note Longer names are truncated to MAX_NAME_LENGTH - 1 characters.
+     */
+    MessagePool(const char* odom_frame_id, const char* base_frame_id,
+                const char* const (&joint_names)[JointCount],
+                const double (&covariance_diagonal)[6]);
+
+    /**
+     * @brief Get the odometry message.
+     *
+     * @return nav_msgs__msg__Odometry& The message.
+     */
+    nav_msgs__msg__Odometry& get_odometry();
+
+    /**
+     * @brief Get the joint state message with position and velocity of every
+     * joint.
+     *
+     * @return sensor_msgs__msg__JointState& The message.
+     */
+    sensor_msgs__msg__JointState& get_joint_state();
+
+    /**
+     * @brief Get the wanted joint state message with the velocity of every
+     * joint.
+     *
+     * @return sensor_msgs__msg__JointState& The message.
+     */
+    sensor_msgs__msg__JointState& get_wanted_joint_state();
+
+    /**
+     * @brief Get the message the cmd_vel subscription receives into.
+     *
+     * @return geometry_msgs__msg__Twist& The message.
+     */
+    geometry_msgs__msg__Twist& get_twist();
+
+private:
+    static void set_string(rosidl_runtime_c__String& string, char* buffer,
+                           const char* value);
+    static void set_sequence(rosidl_runtime_c__double__Sequence& sequence,
+                             double* buffer, const size_t size);
+
+    nav_msgs__msg__Odometry odometry_;
+    sensor_msgs__msg__JointState joint_state_;
+    sensor_msgs__msg__JointState wanted_joint_state_;
+    geometry_msgs__msg__Twist twist_;
+
+    char odom_frame_id_[MAX_NAME_LENGTH];
+    char base_frame_id_[MAX_NAME_LENGTH];
+    // The names are only read when publishing, so both joint states share them
+    char joint_names_[JointCount][MAX_NAME_LENGTH];
+    rosidl_runtime_c__String joint_name_strings_[JointCount];
+    double joint_positions_[JointCount];
+    double joint_velocities_[JointCount];
+    double wanted_joint_velocities_[JointCount];
+};
+
+#endif // MESSAGE_POOL_H
@@ -0,0 +1,185 @@
+/**
+ * @file publisher_scheduler.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Rate based scheduling of micro-ROS publishers.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef PUBLISHER_SCHEDULER_H
+#define PUBLISHER_SCHEDULER_H
+
+#include <stdint.h>
+
+#include "utils/scalar.h"
+
+/**
+ * @brief How a DecimatedValue reduces the samples of a decimation window.
+ *
+ */
+enum class SampleMode
+{
+    LATEST,  // The most recent sample
+    AVERAGE, // The mean of all samples since the last reset
+};
+
+/**
+ * @brief Reduces the samples between two publications to a single value.
+ *
+ * @tparam T The sample type. Must support +=, / scalar_t and copy assignment
+ * (e.g. scalar_t or fixed size Eigen vectors).
+ */
+template <typename T>
+class DecimatedValue
+{
+public:
+    /**
+     * @brief Construct a new Decimated Value object.
+     *
+     * @param mode How the samples are reduced.
+     * @param initial_value The value returned before the first sample.
+     */
+    DecimatedValue(const SampleMode mode, const T& initial_value);
+
+    /**
+     * @brief Add a sample to the current window.
+     *
+     * @param sample The sample.
+     */
+    void add(const T& sample);
+
+    /**
+     * @brief Get the value of the current window.
+     *
+     * @return T The latest sample or the mean of the window. If the window is
+     * empty, the value of the previous window.
+     */
+    T get() const;
+
+    /**
+     * @brief Start a new window.
+     *
+     */
+    void reset();
+
+private:
+    const SampleMode mode_;
+    T value_; // Latest sample, or the mean of the last completed window
+    T sum_;
+    uint32_t count_ = 0;
+};
+
+/**
+ * @brief The PublisherScheduler class calls the publish callback of each topic
+ * at its own rate, independent of how often update() is called.
+ *
+ * Topics with a rate of 0 are only published on request(), e.g. when their
+ * value changed. Requests within the minimum interval of a topic are
+ * coalesced into one publication at its end, so a value changing in every
+ * control cycle does not publish at the control rate. The scheduler never
+ * publishes a topic more than once per update() call, so a slow update()
+ * drops publications instead of bursting.
+ *
+ * @note Must only be used from a single task.
+ */
+class PublisherScheduler
+{
+public:
+    static constexpr uint8_t MAX_TOPICS = 8;
+
+    typedef void (*PublishCallback)();
+
+    /**
+     * @brief Register a topic.
+     *
+     * @param rate The publishing rate in Hz, or 0 to publish on request only.
+     * @param callback The function publishing the topic.
+     * @param max_request_rate The highest rate in Hz of publications on
+     * request, 0 for no limit.
+     * @return int8_t The id of the topic, or -1 if MAX_TOPICS are registered.
+     */
+    int8_t add_topic(const float rate, PublishCallback callback,
+                     const float max_request_rate = 0.0f);
+
+    /**
+     * @brief Publish a topic with the next update() once its minimum interval
+     * since the last publication passed, regardless of its rate.
+     *
+     * @param topic The id of the topic.
+     */
+    void request(const int8_t topic);
+
+    /**
+     * @brief Publish all topics which are due or requested.
+     *
+     * @param now_us The current time in microseconds.
+     * @return uint8_t The number of published topics.
+     */
+    uint8_t update(const unsigned long now_us);
+
+private:
+    struct Topic
+    {
+        unsigned long period_us;   // 0 if published on request only
+        unsigned long next_due_us; // Time of the next scheduled publication
+        unsigned long min_interval_us;   // Between publications on request
+        unsigned long last_published_us; // Valid once published is set
+        bool published;
+        bool requested;
+        PublishCallback callback;
+    };
+
+    Topic topics_[MAX_TOPICS];
+    uint8_t topic_count_ = 0;
+};
+
+// Template definitions
+
+template <typename T>
+DecimatedValue<T>::DecimatedValue(const SampleMode mode, const T& initial_value)
+    : mode_(mode), value_(initial_value), sum_(initial_value)
+{
+}
+
+template <typename T>
+void DecimatedValue<T>::add(const T& sample)
+{
+    if (mode_ == SampleMode::LATEST)
+    {
+        value_ = sample;
+        count_++;
+        return;
+    }
+
+    if (count_ == 0)
+    {
+        sum_ = sample;
+    }
+    else
+    {
+        sum_ += sample;
+    }
+    count_++;
+}
+
+template <typename T>
+T DecimatedValue<T>::get() const
+{
+    if (mode_ == SampleMode::LATEST || count_ == 0)
+    {
+        return value_;
+    }
+    return sum_ / scalar_t(count_);
+}
+
+template <typename T>
+void DecimatedValue<T>::reset()
+{
+    value_ = get();
+    count_ = 0;
+}
+
+#endif // PUBLISHER_SCHEDULER_H
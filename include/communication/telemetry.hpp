@@ -0,0 +1,173 @@
+/**
+ * @file telemetry.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Compact binary batches of control loop telemetry.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <std_msgs/msg/u_int8_multi_array.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rtos/control_task.hpp"
+
+/**
+ * @brief The TelemetryBatch class packs several TelemetrySamples into one
+ * std_msgs/UInt8MultiArray.
+ *
+ * Layout, all values little endian:
+ *
+ * header (12 bytes):
+ *   uint8 version, uint8 wheel_count, uint8 sample_count, uint8 reserved,
+ *   uint32 sequence (counts the batches, gaps mean lost messages),
+ *   uint32 dropped (samples dropped on the robot since boot)
+ * sample_count samples:
+ *   uint32 tick
+ *   wheel_count wheels (28 bytes each):
+ *     float32 setpoint, float32 measured, float32 output,
+ *     int32 encoder_count, float32 p_term, float32 i_term, float32 d_term
+ *
+ * @note With best effort QoS, a batch must fit into one XRCE-DDS fragment
+ * (the transport MTU), so MaxSamples has to be chosen accordingly.
+ *
+ * @tparam WheelCount The number of wheels.
+ * @tparam MaxSamples The number of samples per batch.
+ */
+template <int WheelCount, uint8_t MaxSamples>
+class TelemetryBatch
+{
+public:
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 12;
+    static constexpr size_t WHEEL_SIZE = 28;
+    static constexpr size_t SAMPLE_SIZE = 4 + WheelCount * WHEEL_SIZE;
+    static constexpr size_t CAPACITY = HEADER_SIZE + MaxSamples * SAMPLE_SIZE;
+
+    /**
+     * @brief Construct a new empty Telemetry Batch object.
+     *
+     */
+    TelemetryBatch();
+
+    /**
+     * @brief Append a sample.
+     *
+     * @param sample The sample.
+     * @return true If the batch is full afterwards.
+     * @return false If more samples fit into the batch.
+     */
+    bool add(const TelemetrySample<WheelCount>& sample);
+
+    /**
+     * @brief Write the header and get the message to publish.
+     *
+     * @param dropped The number of dropped samples to report.
+     * @return const std_msgs__msg__UInt8MultiArray& The message. Stays valid
+     * until the next call to add().
+     */
+    const std_msgs__msg__UInt8MultiArray& finish(const uint32_t dropped);
+
+    /**
+     * @brief Check whether the batch holds no samples.
+     *
+     * @return true If no sample was added since the last finish().
+     */
+    bool is_empty() const;
+
+private:
+    void put_u32(size_t& offset, const uint32_t value);
+    void put_f32(size_t& offset, const scalar_t value);
+
+    uint8_t buffer_[CAPACITY];
+    std_msgs__msg__UInt8MultiArray message_;
+    uint8_t sample_count_ = 0;
+    uint32_t sequence_ = 0;
+    bool finished_ = false;
+};
+
+// Template definitions
+
+template <int WheelCount, uint8_t MaxSamples>
+TelemetryBatch<WheelCount, MaxSamples>::TelemetryBatch()
+{
+    memset(&message_, 0, sizeof(message_));
+    message_.data.data = buffer_;
+    message_.data.capacity = CAPACITY;
+}
+
+template <int WheelCount, uint8_t MaxSamples>
+bool TelemetryBatch<WheelCount, MaxSamples>::add(
+    const TelemetrySample<WheelCount>& sample)
+{
+    if (finished_)
+    {
+        sample_count_ = 0;
+        finished_ = false;
+    }
+
+    size_t offset = HEADER_SIZE + sample_count_ * SAMPLE_SIZE;
+    put_u32(offset, sample.tick);
+    for (uint8_t i = 0; i < WheelCount; i++)
+    {
+        const MotorTelemetry& motor = sample.motors[i];
+        put_f32(offset, motor.setpoint);
+        put_f32(offset, motor.measured);
+        put_f32(offset, motor.output);
+        put_u32(offset, uint32_t(motor.encoder_count));
+        put_f32(offset, motor.p_term);
+        put_f32(offset, motor.i_term);
+        put_f32(offset, motor.d_term);
+    }
+
+    return ++sample_count_ >= MaxSamples;
+}
+
+template <int WheelCount, uint8_t MaxSamples>
+const std_msgs__msg__UInt8MultiArray&
+TelemetryBatch<WheelCount, MaxSamples>::finish(const uint32_t dropped)
+{
+    buffer_[0] = VERSION;
+    buffer_[1] = WheelCount;
+    buffer_[2] = sample_count_;
+    buffer_[3] = 0;
+    size_t offset = 4;
+    put_u32(offset, sequence_++);
+    put_u32(offset, dropped);
+
+    message_.data.size = HEADER_SIZE + sample_count_ * SAMPLE_SIZE;
+    finished_ = true;
+    return message_;
+}
+
+template <int WheelCount, uint8_t MaxSamples>
+bool TelemetryBatch<WheelCount, MaxSamples>::is_empty() const
+{
+    return finished_ || sample_count_ == 0;
+}
+
+template <int WheelCount, uint8_t MaxSamples>
+void TelemetryBatch<WheelCount, MaxSamples>::put_u32(size_t& offset,
+                                                     const uint32_t value)
+{
+    // The ESP32 is little endian, so the value is copied as is
+    memcpy(buffer_ + offset, &value, sizeof(value));
+    offset += sizeof(value);
+}
+
+template <int WheelCount, uint8_t MaxSamples>
+void TelemetryBatch<WheelCount, MaxSamples>::put_f32(size_t& offset,
+                                                     const scalar_t value)
+{
+    const float narrowed = float(value);
+    memcpy(buffer_ + offset, &narrowed, sizeof(narrowed));
+    offset += sizeof(narrowed);
+}
+
+#endif // TELEMETRY_H
@@ -0,0 +1,105 @@
+/**
+ * @file time_sync.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Time synchronization with the micro-ROS agent, bounded in time.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TIME_SYNC_H
+#define TIME_SYNC_H
+
+#include <builtin_interfaces/msg/time.h>
+#include <stdint.h>
+
+/**
+ * @brief The TimeSync class keeps a drift corrected mapping from the local
+ * monotonic clock to the agent epoch.
+ *
+ * Synchronization is driven by calling update() from the micro-ROS loop. An
+ * attempt blocks the loop for the round trip to the agent, once per sync
+ * interval and for at most timeout_ms, as rmw_uros_sync_session() has no
+ * asynchronous variant. Executor spin and publishing are delayed by that time,
+ * the control task on the other core is not. The offset between agent and local clock is estimated
+ * with a least squares line over the most recent samples, which compensates
+ * the skew of the local oscillator between synchronizations.
+ *
+ * @note All methods must be called from the task running micro-ROS.
+ */
+class TimeSync
+{
+public:
+    /**
+     * @brief Construct a new Time Sync object.
+     *
+     * @param sync_interval_ms The interval between synchronization attempts.
+     * @param timeout_ms The maximum time a single attempt waits for the agent.
+     */
+    TimeSync(const uint32_t sync_interval_ms, const int timeout_ms);
+
+    /**
+     * @brief Attempt a synchronization if the sync interval elapsed.
+     *
+     * @note Blocks for at most timeout_ms.
+     */
+    void update();
+
+    /**
+     * @brief Get the current agent epoch time.
+     *
+     * @return int64_t The time in nanoseconds since the agent epoch. Falls back
+     * to the local clock until the first successful synchronization.
+     */
+    int64_t now_ns() const;
+
+    /**
+     * @brief Convert a time in nanoseconds to a ROS time stamp.
+     *
+     * @param time_ns The time in nanoseconds.
+     * @param stamp The stamp to fill.
+     */
+    static void to_stamp(const int64_t time_ns,
+                         builtin_interfaces__msg__Time& stamp);
+
+    /**
+     * @brief Check whether at least one synchronization succeeded.
+     *
+     * @return true If the offset to the agent epoch is known.
+     */
+    bool is_synchronized() const;
+
+    /**
+     * @brief Get the estimated skew of the local clock.
+     *
+     * @return double The relative drift of the agent clock against the local
+     * clock (e.g. 1e-5 for 10 ppm).
+     */
+    double get_skew() const;
+
+private:
+    static constexpr uint8_t SAMPLE_COUNT = 8;
+
+    static int64_t local_ns();
+    void add_sample(const int64_t local_ns, const int64_t offset_ns);
+    void fit();
+
+    const uint32_t sync_interval_ms_;
+    const int timeout_ms_;
+    int64_t last_attempt_ns_ = 0;
+
+    // Samples of (local time, agent - local offset) in a ring buffer
+    int64_t sample_local_ns_[SAMPLE_COUNT];
+    int64_t sample_offset_ns_[SAMPLE_COUNT];
+    uint8_t sample_head_ = 0;
+    uint8_t sample_size_ = 0;
+
+    // Fitted model: offset(t) = offset_ns_ + skew_ * (t - reference_ns_)
+    int64_t reference_ns_ = 0;
+    int64_t offset_ns_ = 0;
+    double skew_ = 0.0;
+};
+
+#endif // TIME_SYNC_H
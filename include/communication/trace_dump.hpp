@@ -0,0 +1,174 @@
+/**
+ * @file trace_dump.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Chunked transfer of a frozen trace buffer.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRACE_DUMP_H
+#define TRACE_DUMP_H
+
+#include <std_msgs/msg/u_int8_multi_array.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "utils/trace_buffer.hpp"
+
+/**
+ * @brief The TraceDump class splits a frozen TraceBuffer into
+ * std_msgs/UInt8MultiArray chunks and rearms the buffer once all records were
+ * packed.
+ *
+ * Layout, all values little endian:
+ *
+ * header (16 bytes):
+ *   uint8 version, uint8 wheel_count, uint8 record_count, uint8 reserved,
+ *   uint32 trace_id (counts the traces since boot),
+ *   uint16 chunk_index, uint16 chunk_count,
+ *   uint16 trigger_index (index of the trigger record in the whole trace),
+ *   uint16 reserved
+ * record_count records:
+ *   uint32 timestamp_us
+ *   float32 setpoint[wheel_count], float32 measured[wheel_count],
+ *   float32 output[wheel_count], float32 integral[wheel_count]
+ *
+ * @tparam WheelCount The number of wheels.
+ * @tparam MaxRecords The number of records per chunk.
+ */
+template <int WheelCount, uint8_t MaxRecords>
+class TraceDump
+{
+public:
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t RECORD_SIZE = 4 + 4 * WheelCount * sizeof(float);
+    static constexpr size_t CAPACITY = HEADER_SIZE + MaxRecords * RECORD_SIZE;
+
+    /**
+     * @brief Construct a new Trace Dump object.
+     *
+     * @param trace The trace buffer to dump.
+     */
+    TraceDump(TraceBuffer<TraceRecord<WheelCount>>& trace);
+
+    /**
+     * @brief Check whether a frozen trace is waiting to be sent.
+     *
+     * @return true If next_chunk() can be called.
+     */
+    bool is_pending() const;
+
+    /**
+     * @brief Pack the next chunk of the frozen trace. After the last chunk,
+     * the trace buffer is rearmed.
+     *
+     * @return const std_msgs__msg__UInt8MultiArray& The message. Stays valid
+     * until the next call.
+     *
+     * @note Must only be called if is_pending() returns true.
+     */
+    const std_msgs__msg__UInt8MultiArray& next_chunk();
+
+private:
+    void put_u16(size_t& offset, const uint16_t value);
+    void put_u32(size_t& offset, const uint32_t value);
+    void put_floats(size_t& offset, const float* values);
+
+    TraceBuffer<TraceRecord<WheelCount>>& trace_;
+    uint8_t buffer_[CAPACITY];
+    std_msgs__msg__UInt8MultiArray message_;
+    uint32_t trace_id_ = 0;
+    uint16_t next_record_ = 0;
+};
+
+// Template definitions
+
+template <int WheelCount, uint8_t MaxRecords>
+TraceDump<WheelCount, MaxRecords>::TraceDump(
+    TraceBuffer<TraceRecord<WheelCount>>& trace)
+    : trace_(trace)
+{
+    memset(&message_, 0, sizeof(message_));
+    message_.data.data = buffer_;
+    message_.data.capacity = CAPACITY;
+}
+
+template <int WheelCount, uint8_t MaxRecords>
+bool TraceDump<WheelCount, MaxRecords>::is_pending() const
+{
+    return trace_.is_frozen();
+}
+
+template <int WheelCount, uint8_t MaxRecords>
+const std_msgs__msg__UInt8MultiArray&
+TraceDump<WheelCount, MaxRecords>::next_chunk()
+{
+    const uint16_t size = trace_.get_size();
+    const uint16_t chunk_count = (size + MaxRecords - 1) / MaxRecords;
+    const uint16_t remaining = size - next_record_;
+    const uint8_t record_count =
+        remaining < MaxRecords ? uint8_t(remaining) : MaxRecords;
+
+    buffer_[0] = VERSION;
+    buffer_[1] = WheelCount;
+    buffer_[2] = record_count;
+    buffer_[3] = 0;
+    size_t offset = 4;
+    put_u32(offset, trace_id_);
+    put_u16(offset, next_record_ / MaxRecords);
+    put_u16(offset, chunk_count);
+    put_u16(offset, trace_.get_trigger_index());
+    put_u16(offset, 0);
+
+    for (uint8_t i = 0; i < record_count; i++)
+    {
+        const TraceRecord<WheelCount>& record = trace_.get(next_record_ + i);
+        put_u32(offset, record.timestamp_us);
+        put_floats(offset, record.setpoint);
+        put_floats(offset, record.measured);
+        put_floats(offset, record.output);
+        put_floats(offset, record.integral);
+    }
+    message_.data.size = offset;
+
+    next_record_ += record_count;
+    if (next_record_ >= size)
+    {
+        // All records are copied, the control task may overwrite them again
+        next_record_ = 0;
+        trace_id_++;
+        trace_.rearm();
+    }
+    return message_;
+}
+
+template <int WheelCount, uint8_t MaxRecords>
+void TraceDump<WheelCount, MaxRecords>::put_u16(size_t& offset,
+                                                const uint16_t value)
+{
+    // The ESP32 is little endian, so the value is copied as is
+    memcpy(buffer_ + offset, &value, sizeof(value));
+    offset += sizeof(value);
+}
+
+template <int WheelCount, uint8_t MaxRecords>
+void TraceDump<WheelCount, MaxRecords>::put_u32(size_t& offset,
+                                                const uint32_t value)
+{
+    memcpy(buffer_ + offset, &value, sizeof(value));
+    offset += sizeof(value);
+}
+
+template <int WheelCount, uint8_t MaxRecords>
+void TraceDump<WheelCount, MaxRecords>::put_floats(size_t& offset,
+                                                   const float* values)
+{
+    memcpy(buffer_ + offset, values, WheelCount * sizeof(float));
+    offset += WheelCount * sizeof(float);
+}
+
+#endif // TRACE_DUMP_H
@@ -0,0 +1,84 @@
+/**
+ * @file transport.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Setup of the micro-ROS transport profile selected at build time.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <rcl/rcl.h>
+#include <rosidl_runtime_c/message_type_support_struct.h>
+
+#include "conf_transport.h"
+
+/**
+ * @brief The MicroRosTransport class hides the differences between the
+ * transport profiles (see conf_transport.h) from the rest of the firmware.
+ *
+ * The QoS is chosen per topic. On WiFi, datagrams are lost regularly, so all
+ * topics are created best effort there and a lost sample is replaced by the
+ * next one instead of blocking the loop with retransmissions.
+ */
+class MicroRosTransport
+{
+public:
+    /**
+     * @brief Set up the transport. Must be called before any rcl function.
+     *
+     */
+    static void begin();
+
+    /**
+     * @brief Get the name of the selected profile.
+     *
+     * @return const char* E.g. "serial_921600" or "wifi_udp".
+     */
+    static const char* get_profile_name();
+
+    /**
+     * @brief Check whether the profile forces best effort topics.
+     *
+     * @return true If all topics are created best effort.
+     */
+    static bool is_best_effort();
+
+    /**
+     * @brief Create a publisher.
+     *
+     * @param publisher The publisher to initialize.
+     * @param node The node of the publisher.
+     * @param type_support The type support of the message.
+     * @param topic_name The name of the topic.
+     * @param best_effort Whether the publisher is best effort. Ignored if the
+     * profile forces best effort.
+     * @return rcl_ret_t RCL_RET_OK on success.
+     */
+    static rcl_ret_t init_publisher(
+        rcl_publisher_t* publisher, const rcl_node_t* node,
+        const rosidl_message_type_support_t* type_support,
+        const char* topic_name, const bool best_effort);
+
+    /**
+     * @brief Create a subscription.
+     *
+     * @param subscription The subscription to initialize.
+     * @param node The node of the subscription.
+     * @param type_support The type support of the message.
+     * @param topic_name The name of the topic.
+     * @param best_effort Whether the subscription is best effort. Ignored if
+     * the profile forces best effort.
+     * @return rcl_ret_t RCL_RET_OK on success.
+     */
+    static rcl_ret_t init_subscription(
+        rcl_subscription_t* subscription, const rcl_node_t* node,
+        const rosidl_message_type_support_t* type_support,
+        const char* topic_name, const bool best_effort);
+};
+
+#endif // TRANSPORT_H
@@ -0,0 +1,75 @@
+/**
+ * @file drive_stack.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Motor drivers, encoders and motor controllers built from a
+ * RobotConfig.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVE_STACK_H
+#define DRIVE_STACK_H
+
+#include "motor-control/autotune.hpp"
+#include "motor-control/encoder.hpp"
+#include "motor-control/fault_monitor.hpp"
+#include "motor-control/motor-drivers/l298n_motor_driver.hpp"
+#include "motor-control/motor_control_manager.hpp"
+#include "motor-control/pid_motor_controller.hpp"
+#include "utils/config_store.hpp"
+
+/**
+ * @brief The motors of the robot: a driver, an encoder and a PID motor
+ * controller each, and the MotorControllerManager driving them. The firmware
+ * and the on-device benchmarks build it the same way, so both run the stored
+ * wiring and tuning.
+ *
+ */
+struct DriveStack
+{
+    L298NMotorDriver* drivers[4];
+    EdgeTimingEncoder* encoders[4];
+    PIDMotorController<>* motor_controllers[4];
+    MotorControllerManager* motor_control_manager;
+};
+
+/**
+ * @brief Set the motors, the PWM and the geometry of a configuration to the
+ * defaults of conf_hardware.h.
+ *
+ * @param config The configuration.
+ */
+void set_default_hardware(RobotConfig<4>& config);
+
+/**
+ * @brief Load the stored configuration and autotune results over the
+ * defaults. The identified stiction of a tuned motor becomes its minimum
+ * output.
+ *
+ * @note Reads the NVS, call it in setup() only.
+ *
+ * @param config The configuration, holds the defaults before.
+ * @param results Set to the stored autotune result of each tuned motor.
+ * @param tuned Set to true for each motor with a stored autotune result.
+ */
+void load_stored_config(RobotConfig<4>& config, AutotuneResult results[4],
+                        bool tuned[4]);
+
+/**
+ * @brief Create the motor drivers, encoders and motor controllers of a
+ * configuration. They are never destroyed, a changed wiring takes effect on
+ * the next boot.
+ *
+ * @param config The wiring, PWM and minimum outputs of the motors.
+ * @param controllers The wheel PID of each motor.
+ * @param fault_monitor Watches the motors, nullptr for none.
+ * @return DriveStack The created motors.
+ */
+DriveStack create_drive_stack(const RobotConfig<4>& config,
+                              PIDController* const controllers[4],
+                              FaultMonitor* fault_monitor);
+
+#endif // DRIVE_STACK_H
@@ -9,7 +9,9 @@
  *
  */
 
+#include "utils/scalar.h"
 #include <ArduinoEigen.h>
+#include <array>
 
 #ifndef KINEMATICS_H
 #define KINEMATICS_H
@@ -18,28 +20,137 @@
  * @brief Abstract base class for defining kinematics calculations.
  *
  * This class provides an interface for calculating robot velocity and wheel
- * velocity based on the kinematic properties of the robot.
+ * velocity based on the kinematic properties of the robot. The number of
+ * wheels is known at compile time, so all vectors are fixed size and no heap
+ * memory is allocated in the calculations.
+ *
+ * @tparam WheelCount The number of wheels of the robot.
  */
+template <int WheelCount>
 class Kinematics
 {
 public:
+    static constexpr int WHEEL_COUNT = WheelCount;
+
+    typedef Eigen::Matrix<scalar_t, WheelCount, 1> WheelVector;
+
     /**
      * @brief Calculate robot velocity based on wheel velocities.
      *
      * @param wheel_velocity The velocities of individual wheels.
-     * @return Eigen::Vector3d The calculated robot velocity.
+     * @return Vector3 The calculated robot velocity.
      */
-    virtual Eigen::Vector3d
-    calculate_robot_velocity(const Eigen::VectorXd& wheel_velocity) = 0;
+    virtual Vector3
+    calculate_robot_velocity(const WheelVector& wheel_velocity) = 0;
 
     /**
      * @brief Calculate wheel velocities based on robot velocity.
      *
      * @param robot_velocity The velocity of the robot.
-     * @return Eigen::VectorXd The calculated wheel velocities.
+     * @return WheelVector The calculated wheel velocities.
+     */
+    virtual WheelVector
+    calculate_wheel_velocity(const Vector3& robot_velocity) = 0;
+
+    /**
+     * @brief Whether the wheel velocities are linear in the robot velocity,
+     * so the wheel velocities of two parts of a twist add up to those of the
+     * whole twist.
+     *
+     * @return bool True if the kinematics are linear.
      */
-    virtual Eigen::VectorXd
-    calculate_wheel_velocity(const Eigen::Vector3d& robot_velocity) = 0;
+    virtual bool is_linear() const { return true; }
+};
+
+/**
+ * @brief Mounting of a wheel, in the robot frame (x forward, y left, angles
+ * counterclockwise in radians).
+ *
+ * The wheel rolls along drive_angle for positive wheel velocities. The roller
+ * axes are at roller_angle to the wheel axle, for plain and omni wheels pi/2
+ * (the wheel drives along drive_angle only), for mecanum wheels +-pi/4. The
+ * wheel drives the velocity of its contact point along the roller axes.
+ */
+struct WheelGeometry
+{
+    scalar_t x = 0;                       // Position of the contact point
+    scalar_t y = 0;                       // Position of the contact point
+    scalar_t drive_angle = 0;             // Rolling direction
+    scalar_t roller_angle = M_PI / 2.0;   // Roller axes to wheel axle
+    scalar_t radius = 0;                  // Radius of the wheel
+};
+
+/**
+ * @brief Kinematics of wheels at fixed mountings, built once from their
+ * geometry.
+ *
+ * A wheel at (x, y) with the rolling direction d, the radius r and rollers at
+ * the angle g to its axle drives the contact point velocity
+ * (vx - wz * y, vy + wz * x) along the roller axes n, at the angle
+ * g - pi/2 to d. Its velocity is
+ *
+ *   w = (n_x * vx + n_y * vy + (x * n_y - y * n_x) * wz) / (r * sin(g))
+ *
+ * The rows of all wheels form the forward map, the inverse map is its
+ * least squares pseudo-inverse. Axes no wheel drives, like vy of a
+ * differential drive, are ignored in the forward and estimated as 0 in the
+ * inverse map. Both evaluations are a single fixed size matrix product, so
+ * all drives built on this class have the same cost per cycle.
+ *
+ * @tparam WheelCount The number of wheels of the robot.
+ */
+template <int WheelCount>
+class GeometricKinematics : public Kinematics<WheelCount>
+{
+public:
+    typedef typename Kinematics<WheelCount>::WheelVector WheelVector;
+    typedef std::array<WheelGeometry, WheelCount> Geometry;
+
+    /**
+     * @brief Construct a new Geometric Kinematics object.
+     *
+     * @param geometry The mounting of each wheel, in the order of the motor
+     * controllers.
+     */
+    GeometricKinematics(const Geometry& geometry);
+
+    /**
+     * @brief Calculate robot velocity based on wheel velocities.
+     *
+     * @param wheel_velocity The velocities of individual wheels.
+     * @return Vector3 The calculated robot velocity.
+     */
+    Vector3
+    calculate_robot_velocity(const WheelVector& wheel_velocity) override;
+
+    /**
+     * @brief Calculate wheel velocities based on robot velocity.
+     *
+     * @param robot_velocity The velocity of the robot.
+     * @return WheelVector The calculated wheel velocities.
+     */
+    WheelVector
+    calculate_wheel_velocity(const Vector3& robot_velocity) override;
+
+    /**
+     * @brief Get the mounting of the wheels.
+     *
+     * @return const Geometry& The geometry.
+     */
+    const Geometry& get_geometry() const;
+
+protected:
+    /**
+     * @brief Build the forward and the inverse map from a new geometry.
+     *
+     * @param geometry The mounting of each wheel.
+     */
+    void set_geometry(const Geometry& geometry);
+
+private:
+    Geometry geometry_;
+    Eigen::Matrix<scalar_t, WheelCount, 3> forward_kinematics_;
+    Eigen::Matrix<scalar_t, 3, WheelCount> inverse_kinematics_;
 };
 
 /**
@@ -47,9 +158,10 @@ public:
  *
  * This class implements the kinematics calculations for a 4-wheel mecanum drive
  * robot. It takes into account the wheel radius, wheel base, and track width of
- * the robot.
+ * the robot. The wheels are ordered front left, front right, rear left, rear
+ * right, the motors of the right wheels are mounted mirrored.
  */
-class MecanumKinematics4W : public Kinematics
+class MecanumKinematics4W : public GeometricKinematics<4>
 {
 public:
     /**
@@ -64,34 +176,128 @@ public:
      */
     MecanumKinematics4W(const float& wheel_radius, const float& wheel_base,
                         const float& track_width);
+};
 
+/**
+ * @brief Kinematics of a differential drive. The wheels are ordered left,
+ * right, both roll forward for positive wheel velocities. vy is ignored.
+ */
+class DifferentialKinematics : public GeometricKinematics<2>
+{
+public:
     /**
-     * @brief Calculate robot velocity based on wheel velocities.
+     * @brief Construct a new Differential Kinematics object.
+     *
+     * @param wheel_radius The radius of the wheels.
+     * @param track_width The distance between the wheel contact points.
+     */
+    DifferentialKinematics(const float& wheel_radius,
+                           const float& track_width);
+};
+
+/**
+ * @brief Kinematics of a robot with three omni wheels at 120 degrees. Wheel i
+ * is at the angle i * 120 degrees from the front, positive wheel velocities
+ * turn the robot counterclockwise.
+ */
+class OmniKinematics3W : public GeometricKinematics<3>
+{
+public:
+    /**
+     * @brief Construct a new Omni Kinematics 3W object.
+     *
+     * @param wheel_radius The radius of the wheels.
+     * @param base_radius The distance of the wheel contact points from the
+     * center of the robot.
+     */
+    OmniKinematics3W(const float& wheel_radius, const float& base_radius);
+};
+
+/**
+ * @brief Kinematics of steerable wheels (swerve modules).
+ *
+ * Each module turns its wheel into the direction of its contact point
+ * velocity (vx - wz * y, vy + wz * x). The wheel velocities are the speeds of
+ * the contact points divided by the radius, the steer angles are relative to
+ * the drive_angle of the WheelGeometry. A module never turns by more than 90
+ * degrees: if the new direction is further away, it steers to the opposite
+ * direction and reverses the wheel instead. At standstill the modules keep
+ * their angles.
+ *
+ * The robot velocity is the least squares fit to the contact point velocities
+ * of the wheel velocities and steer angles. The steer angles are those set by
+ * the latest calculate_wheel_velocity() call, unless measured angles are set
+ * with set_steer_angles(). The roller_angle of the geometry is ignored.
+ *
+ * Only the kinematics are implemented, the firmware drives the mecanum robot
+ * and has no outputs for the steer angles.
+ *
+ * @tparam WheelCount The number of swerve modules.
+ */
+template <int WheelCount>
+class SwerveKinematics : public Kinematics<WheelCount>
+{
+public:
+    typedef typename Kinematics<WheelCount>::WheelVector WheelVector;
+    typedef std::array<WheelGeometry, WheelCount> Geometry;
+
+    /**
+     * @brief Construct a new Swerve Kinematics object with all modules at a
+     * steer angle of 0.
+     *
+     * @param geometry The mounting of each module.
+     */
+    SwerveKinematics(const Geometry& geometry);
+
+    /**
+     * @brief Calculate robot velocity based on wheel velocities and the
+     * current steer angles.
      *
      * @param wheel_velocity The velocities of individual wheels.
-     * @return Eigen::Vector3d The calculated robot velocity.
+     * @return Vector3 The calculated robot velocity.
      */
-    Eigen::Vector3d
-    calculate_robot_velocity(const Eigen::VectorXd& wheel_velocity) override;
+    Vector3
+    calculate_robot_velocity(const WheelVector& wheel_velocity) override;
 
     /**
-     * @brief Calculate wheel velocities based on robot velocity.
+     * @brief Calculate wheel velocities and steer angles based on robot
+     * velocity.
      *
      * @param robot_velocity The velocity of the robot.
-     * @return Eigen::VectorXd The calculated wheel velocities.
+     * @return WheelVector The calculated wheel velocities.
+     */
+    WheelVector
+    calculate_wheel_velocity(const Vector3& robot_velocity) override;
+
+    /**
+     * @brief The wheel velocities are not linear in the robot velocity.
+     *
+     * @return bool False.
+     */
+    bool is_linear() const override;
+
+    /**
+     * @brief Get the steer angles of the latest calculate_wheel_velocity()
+     * call, to be set by the steering actuators.
+     *
+     * @return const WheelVector& The steer angles in (-pi, pi].
+     */
+    const WheelVector& get_steer_angles() const;
+
+    /**
+     * @brief Set the steer angles, e.g. measured by the steering actuators.
+     *
+     * @param steer_angles The steer angles in radians.
      */
-    Eigen::VectorXd
-    calculate_wheel_velocity(const Eigen::Vector3d& robot_velocity) override;
+    void set_steer_angles(const WheelVector& steer_angles);
 
 private:
-    const float wheel_radius_; // Radius of the wheels.
-    const float wheel_base_;   // Distance between wheel contact points in the x
-                               // direction.
-    const float track_width_;  // Distance between wheel contact points in the y
-                               // direction.
-
-    Eigen::Matrix<double, 4, 3> forward_kinematics_;
-    Eigen::Matrix<double, 3, 4> inverse_kinematics_;
+    Geometry geometry_;
+    Eigen::Matrix<scalar_t, 3, 2 * WheelCount> inverse_kinematics_;
+    WheelVector steer_angles_ = WheelVector::Zero();
+    // Rolling directions in the robot frame, cos and sin of the steer angles
+    // plus drive_angle, so the robot velocity needs no trigonometry
+    Eigen::Matrix<scalar_t, 2, WheelCount> directions_;
 };
 
 // Add more kinematics definitions here
@@ -0,0 +1,149 @@
+/**
+ * @file odometry.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Planar odometry with optional gyro fusion.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ODOMETRY_H
+#define ODOMETRY_H
+
+#include "utils/scalar.h"
+
+/**
+ * @brief Noise model and gyro fusion parameters of the Odometry class.
+ *
+ */
+struct OdometryConfig
+{
+    scalar_t translation_noise = 0.01;  // Position variance per m, in m^2/m
+    scalar_t rotation_noise = 0.02;     // Heading variance per rad, rad^2/rad
+    scalar_t drift_noise = 0.005;       // Heading variance per m, in rad^2/m
+    scalar_t velocity_variance = 1e-4;  // Twist variance at standstill
+    scalar_t velocity_noise = 0.01;     // Twist variance per velocity^2
+
+    scalar_t gyro_weight = 0.98;        // Share of the gyro in the yaw rate
+    scalar_t gyro_noise = 1e-5;         // Heading variance per s, in rad^2/s
+    scalar_t gyro_bias_time_constant = 2.0; // Bias estimation at standstill
+    scalar_t standstill_velocity = 1e-3;    // Below, the robot stands still
+};
+
+/**
+ * @brief Pose and twist estimated by the Odometry class.
+ *
+ */
+struct OdometryEstimate
+{
+    Vector3 pose = Vector3::Zero();     // x, y in m and heading in rad
+    Vector3 velocity = Vector3::Zero(); // vx, vy in m/s and wz in rad/s
+    Matrix3 pose_covariance = Matrix3::Zero();
+    Vector3 velocity_variance = Vector3::Zero();
+};
+
+/**
+ * @brief The Odometry class integrates the robot velocity into a pose in the
+ * odometry frame and estimates its covariance.
+ *
+ * The velocity is assumed constant during a control cycle, so the motion is
+ * an arc. The pose is moved along it with the exponential map of SE(2):
+ *
+ *   dx = (sin(dth) / dth * vx - (1 - cos(dth)) / dth * vy) * dt
+ *   dy = ((1 - cos(dth)) / dth * vx + sin(dth) / dth * vy) * dt
+ *
+ * in the body frame at the start of the cycle, with dth = wz * dt. Unlike
+ * forward Euler, this is exact for combined translation and rotation.
+ *
+ * The covariance is propagated with the Jacobian of the motion, P = F P F^T +
+ * Q. Q grows with the travelled distance and the turned angle, modelling the
+ * wheel slip.
+ *
+ * With a gyro, the yaw rate is the complementary blend of the gyro rate, which
+ * is accurate over short periods, and the wheel rate, which has no bias. The
+ * gyro bias is estimated while the wheels stand still, the heading is held
+ * in the meantime.
+ */
+class Odometry
+{
+public:
+    /**
+     * @brief Construct a new Odometry object at the origin.
+     *
+     * @param config The noise model and the gyro fusion parameters.
+     */
+    Odometry(const OdometryConfig& config = OdometryConfig());
+
+    /**
+     * @brief Integrate the velocity measured by the wheels over one cycle.
+     *
+     * @param velocity The robot velocity (vx, vy, wz) in the body frame.
+     * @param dt The duration of the cycle in s.
+     */
+    void update(const Vector3& velocity, const scalar_t dt);
+
+    /**
+     * @brief Integrate the velocity measured by the wheels over one cycle,
+     * fused with the yaw rate of a gyro.
+     *
+     * @param velocity The robot velocity (vx, vy, wz) in the body frame.
+     * @param gyro_rate The yaw rate measured by the gyro in rad/s.
+     * @param dt The duration of the cycle in s.
+     */
+    void update(const Vector3& velocity, const scalar_t gyro_rate,
+                const scalar_t dt);
+
+    /**
+     * @brief Get the estimate of the last update.
+     *
+     * @return const OdometryEstimate& The pose, velocity and their covariance.
+     */
+    const OdometryEstimate& get_estimate() const;
+
+    /**
+     * @brief Get the estimated gyro bias.
+     *
+     * @return scalar_t The bias in rad/s.
+     */
+    scalar_t get_gyro_bias() const;
+
+    /**
+     * @brief Set the noise model and the gyro fusion parameters.
+     *
+     * @param config The configuration.
+     */
+    void set_config(const OdometryConfig& config);
+
+    /**
+     * @brief Get the noise model and the gyro fusion parameters.
+     *
+     * @return const OdometryConfig& The configuration.
+     */
+    const OdometryConfig& get_config() const;
+
+    /**
+     * @brief Move the robot to a pose with zero covariance.
+     *
+     * @param pose The pose (x, y, heading).
+     */
+    void reset(const Vector3& pose = Vector3::Zero());
+
+private:
+    /**
+     * @brief Move the pose along the arc and propagate the covariance.
+     *
+     * @param velocity The robot velocity (vx, vy, wz) in the body frame.
+     * @param dt The duration of the cycle in s.
+     * @param heading_variance The variance added to the heading.
+     */
+    void integrate(const Vector3& velocity, const scalar_t dt,
+                   const scalar_t heading_variance);
+
+    OdometryConfig config_;
+    OdometryEstimate estimate_;
+    scalar_t gyro_bias_ = 0;
+};
+
+#endif // ODOMETRY_H
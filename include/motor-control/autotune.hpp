@@ -0,0 +1,210 @@
+/**
+ * @file autotune.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Identification of a motor from a step response and tuning of its
+ * gains.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include <stdint.h>
+
+#include "motor-control/feed_forward_motor_controller.hpp"
+#include "utils/control_tick.h"
+#include "utils/controllers.hpp"
+#include "utils/scalar.h"
+
+/**
+ * @brief Excitation and tuning parameters of a MotorAutotuner.
+ *
+ */
+struct AutotuneConfig
+{
+    scalar_t step_output = 0.6;       // Output of the step, at most 1
+    scalar_t ramp_rate = 0.5;         // Output per s searching the stiction
+    scalar_t release_rate = 0.01;     // Output per s lowering it again
+    scalar_t motion_threshold = 0.5;  // The motor turns above it, in rad/s
+    scalar_t stop_duration = 0.5;     // Standstill before the step, in s
+    scalar_t step_duration = 1.0;     // Must cover the settling, in s
+    scalar_t closed_loop_ratio = 0.5; // Closed to open loop time constant
+};
+
+/**
+ * @brief First order plus dead time model of a motor, from the output to the
+ * rotation speed, with a static friction.
+ *
+ */
+struct PlantModel
+{
+    scalar_t gain = 0;          // rad/s per output above the stiction
+    scalar_t time_constant = 0; // in s
+    scalar_t dead_time = 0;     // in s
+    scalar_t stiction = 0;      // Output at which the motor starts to turn
+};
+
+/**
+ * @brief Identified model and the gains tuned for it.
+ *
+ */
+struct AutotuneResult
+{
+    PlantModel plant;
+    PIDGains pid;                   // For PIDMotorController
+    FeedForwardConfig feed_forward; // For FeedForwardMotorController
+};
+
+/**
+ * @brief Phases of a MotorAutotuner.
+ *
+ */
+enum class AutotuneState : uint8_t
+{
+    IDLE,
+    STOP,     // Waiting for the motor to stand still
+    STICTION, // Ramping the output up until the motor turns
+    RELEASE,  // Ramping the output down until the motor stops
+    STEP,     // Recording the step response
+    DONE,
+    FAILED
+};
+
+/**
+ * @brief The MotorAutotuner class identifies a motor and tunes its gains. It
+ * drives the motor directly, bypassing its controller, and must be updated
+ * once per control cycle with the measured rotation speed.
+ *
+ * Once the motor stands still, the output is ramped up until it turns, then
+ * slowly ramped down until it stops again. The encoder measures low speeds
+ * late, which shifts the output at the stop by release_rate times that delay,
+ * so the slow descent gives the stiction far more accurately than the
+ * breakaway of the fast ramp. On the simulated motors it is 0.0002 to 0.0004
+ * below the true stiction (0.0056 to 0.022), the breakaway was 30 to 95 %
+ * too high. After the motor stopped, a step of step_output is applied and the
+ * response is recorded. The final speed gives the gain, the times at which
+ * 28.3% and 63.2% of it are reached the time constant T = 1.5 (t63 - t28) and
+ * the dead time L = t63 - T.
+ *
+ * The PI gains follow the SIMC rules with the closed loop time constant
+ * Tc = max(closed_loop_ratio * T, L):
+ *
+ *   kp = T / (K (Tc + L)),  ki = kp / min(T, 4 (Tc + L))
+ *
+ * The feed-forward cancels the stiction (ks) and the steady state (kv = 1/K),
+ * so FeedForwardMotorController uses the same feedback gains.
+ *
+ * The identification fails if the motor does not turn, turns backwards for a
+ * positive output (motor or encoder reversed) or has not settled within
+ * step_duration.
+ *
+ * @note The motor runs at step_output open loop, the robot must be lifted.
+ */
+class MotorAutotuner
+{
+public:
+    static constexpr uint16_t SAMPLE_COUNT = 256;
+
+    /**
+     * @brief Construct a new Motor Autotuner object.
+     *
+     * @param config The excitation and tuning parameters.
+     */
+    MotorAutotuner(const AutotuneConfig& config = AutotuneConfig());
+
+    /**
+     * @brief Start a new identification with the next update.
+     *
+     * @param config The excitation and tuning parameters.
+     */
+    void start(const AutotuneConfig& config);
+
+    /**
+     * @brief Abort a running identification.
+     *
+     */
+    void abort();
+
+    /**
+     * @brief Advance the identification by one control cycle.
+     *
+     * @param rotation_speed The rotation speed measured in this cycle in
+     * rad/s.
+     * @param tick The control cycle.
+     * @return scalar_t The output for the motor driver, 0 unless running.
+     */
+    scalar_t update(const scalar_t rotation_speed, const ControlTick& tick);
+
+    /**
+     * @brief Get the phase of the identification.
+     *
+     * @return AutotuneState The phase.
+     */
+    AutotuneState get_state() const;
+
+    /**
+     * @brief Check whether the identification is running.
+     *
+     * @return true If the motor is driven by the autotuner.
+     */
+    bool is_running() const;
+
+    /**
+     * @brief Get the result of the last identification.
+     *
+     * @return const AutotuneResult& The result, valid in state DONE.
+     */
+    const AutotuneResult& get_result() const;
+
+    /**
+     * @brief Tune the gains for a plant model.
+     *
+     * @param plant The plant model.
+     * @param config The tuning parameters.
+     * @return AutotuneResult The model with the tuned gains.
+     */
+    static AutotuneResult tune(const PlantModel& plant,
+                               const AutotuneConfig& config);
+
+private:
+    /**
+     * @brief Switch to a new phase.
+     *
+     * @param state The new phase.
+     * @param timestamp_us The start of the phase in microseconds.
+     */
+    void enter(const AutotuneState state, const unsigned long timestamp_us);
+
+    /**
+     * @brief Fit the plant model to the recorded step response.
+     *
+     * @return true If the response settled and a model was fitted.
+     */
+    bool identify();
+
+    /**
+     * @brief Get the time at which the recorded response first reaches a
+     * level, interpolated between the samples.
+     *
+     * @param level The level in rad/s.
+     * @return scalar_t The time since the step in s, negative if never.
+     */
+    scalar_t get_crossing_time(const scalar_t level) const;
+
+    AutotuneConfig config_;
+    AutotuneState state_ = AutotuneState::IDLE;
+    AutotuneResult result_;
+    bool starting_ = false;
+    bool stiction_found_ = false;
+    scalar_t breakaway_output_ = 0;
+    unsigned long phase_start_us_ = 0;
+
+    scalar_t samples_[SAMPLE_COUNT];
+    uint16_t sample_count_ = 0;
+};
+
+#endif // AUTOTUNE_H
@@ -0,0 +1,67 @@
+/**
+ * @file current_sensor.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Measurement of the motor current.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CURRENT_SENSOR_H
+#define CURRENT_SENSOR_H
+
+#include <stdint.h>
+
+#include "utils/scalar.h"
+
+/**
+ * @brief Current sensor base class.
+ *
+ */
+class CurrentSensor
+{
+public:
+    /**
+     * @brief Read the current through the motor.
+     *
+     * @return scalar_t The magnitude of the current in A.
+     */
+    virtual scalar_t read_current() = 0;
+};
+
+/**
+ * @brief Current sensor reading the voltage across a sense resistor with the
+ * ADC, e.g. on the SENSE pins of an L298N.
+ *
+ * @note A conversion takes some 10 us, the FaultMonitor therefore reads one
+ * sensor per control cycle.
+ */
+class AnalogCurrentSensor : public CurrentSensor
+{
+public:
+    /**
+     * @brief Construct a new Analog Current Sensor object.
+     *
+     * @param pin The ADC pin.
+     * @param sense_resistance The resistance of the sense resistor in Ohm.
+     * @param offset The current read without load in A, subtracted.
+     */
+    AnalogCurrentSensor(const uint8_t pin, const scalar_t sense_resistance,
+                        const scalar_t offset = 0);
+
+    /**
+     * @brief Read the current through the sense resistor.
+     *
+     * @return scalar_t The current in A.
+     */
+    scalar_t read_current() override;
+
+private:
+    const uint8_t pin_;
+    const scalar_t amps_per_millivolt_;
+    const scalar_t offset_;
+};
+
+#endif // CURRENT_SENSOR_H
@@ -12,6 +12,8 @@
 #define ENCODER_H
 
 #include "utils/constants.h"
+#include "utils/control_tick.h"
+#include "utils/scalar.h"
 #include <Arduino.h>
 #include <ESP32Encoder.h>
 
@@ -25,24 +27,30 @@ public:
     /**
      * @brief Get the velocity of the encoder.
      *
-     * @return float The velocity in rad/s.
+     * @return scalar_t The velocity in rad/s.
      */
-    virtual double get_velocity() = 0;
+    virtual scalar_t get_velocity() = 0;
 
     /**
      * @brief Get the angle of the encoder.
      *
-     * @return float The angle in rad.
+     * @return scalar_t The angle in rad.
      */
-    virtual double get_angle() = 0;
+    virtual scalar_t get_angle() = 0;
 
     /**
-     * @brief Update the encoder values.
+     * @brief Get the raw count of the encoder.
      *
-     * @note This function should be called regularly to update the encoder
-     * values.
+     * @return int32_t The count latched by the last update.
+     */
+    virtual int32_t get_count() = 0;
+
+    /**
+     * @brief Update the encoder values once per control cycle.
+     *
+     * @param tick The control cycle, the encoder is read at its timestamp.
      */
-    virtual void update() = 0;
+    virtual void update(const ControlTick& tick) = 0;
 };
 
 /**
@@ -66,34 +74,126 @@ public:
     /**
      * @brief Get the velocity of the encoder.
      *
-     * @return double The velocity in rad/s.
+     * @return scalar_t The velocity in rad/s.
      */
-    double get_velocity() override;
+    scalar_t get_velocity() override;
 
     /**
      * @brief Get the position of the encoder.
      *
-     * @return double The position in rad (0 to 2*PI).
+     * @return scalar_t The position in rad (0 to 2*PI).
      */
-    double get_angle() override;
+    scalar_t get_angle() override;
 
     /**
-     * @brief Update the encoder values.
+     * @brief Get the raw count of the encoder.
+     *
+     * @return int32_t The count latched by the last update.
+     */
+    int32_t get_count() override;
+
+    /**
+     * @brief Update the encoder values. The velocity is the change of the
+     * count over the sampling time of the control cycle.
+     *
+     * @param tick The control cycle.
      *
      * @note This function should be called regularly to update the encoder
      * values.
      */
-    void update() override;
+    void update(const ControlTick& tick) override;
 
 private:
     ESP32Encoder encoder_;
     const u_int16_t resolution_;
-    double step_increment_;
+    scalar_t step_increment_;
     int64_t prev_count_;
     const bool reverse_;
-    double position_ = 0;     // in radians
-    double velocity_ = 0;     // in radians per second
-    unsigned long last_time_; // in microseconds
+    scalar_t position_ = 0; // in radians
+    scalar_t velocity_ = 0; // in radians per second
+};
+
+/**
+ * @brief Encoder class which timestamps every edge of the A channel in an ISR
+ * and estimates the velocity with the M/T method.
+ *
+ * If edges occurred since the last update, the velocity is the number of
+ * edges divided by the exact time between the last edge of the previous and
+ * the last edge of the current update (M/T method). This avoids the
+ * quantization of counting edges per fixed time window. If no edge occurred,
+ * the velocity is limited to one step per time since the last edge (T method)
+ * and drops to zero after the standstill timeout.
+ *
+ * @note Edges are counted with the same convention as
+ * ESP32Encoder::attachSingleEdge, so it can replace HalfQuadEncoder.
+ */
+class EdgeTimingEncoder : public Encoder
+{
+public:
+    /**
+     * @brief Construct a new EdgeTimingEncoder object
+     *
+     * @param pin_A The pin for the A channel, an interrupt is attached to it.
+     * @param pin_B The pin for the B channel, used for the direction.
+     * @param resolution The resolution of the encoder.
+     * @param reverse Whether the encoder is reversed.
+     * @param standstill_timeout The time without edges after which the
+     * velocity is zero in microseconds.
+     */
+    EdgeTimingEncoder(const u_int8_t& pin_A, const u_int8_t& pin_B,
+                      const u_int16_t& resolution, const bool reverse = false,
+                      const uint32_t standstill_timeout = 100000);
+
+    /**
+     * @brief Get the velocity of the encoder.
+     *
+     * @return scalar_t The velocity in rad/s.
+     */
+    scalar_t get_velocity() override;
+
+    /**
+     * @brief Get the position of the encoder.
+     *
+     * @return scalar_t The position in rad.
+     */
+    scalar_t get_angle() override;
+
+    /**
+     * @brief Get the raw count of the encoder.
+     *
+     * @return int32_t The count latched by the last update.
+     */
+    int32_t get_count() override;
+
+    /**
+     * @brief Update the encoder values.
+     *
+     * @param tick The control cycle, the encoder is read at its timestamp.
+     *
+     * @note This function should be called regularly to update the encoder
+     * values.
+     */
+    void update(const ControlTick& tick) override;
+
+private:
+    static void handle_edge(void* encoder);
+
+    const u_int8_t pin_B_;
+    const scalar_t step_increment_;
+    const bool reverse_;
+    const uint32_t standstill_timeout_; // in microseconds
+
+    // Written by the edge ISR
+    portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+    volatile int32_t edge_count_ = 0;
+    volatile uint32_t last_edge_time_ = 0;   // in microseconds
+    volatile uint32_t last_edge_period_ = 0; // in microseconds
+    volatile int8_t last_edge_direction_ = 0;
+
+    int32_t window_count_ = 0;       // count at the end of the last update
+    uint32_t window_edge_time_ = 0;  // time of the last edge at that point
+    scalar_t position_ = 0;          // in radians
+    scalar_t velocity_ = 0;          // in radians per second
 };
 
 #endif // ENCODER_H
@@ -0,0 +1,167 @@
+/**
+ * @file fault_monitor.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Detection of stalled motors and faulty encoders in the control cycle.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef FAULT_MONITOR_H
+#define FAULT_MONITOR_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "motor-control/current_sensor.hpp"
+#include "utils/control_tick.h"
+#include "utils/scalar.h"
+
+/**
+ * @brief Faults of a motor, combined as bit flags.
+ *
+ * STALL: The output is high but the wheel stands, the output is derated until
+ * the wheel turns or less output is requested.
+ * ENCODER_LOSS: The wheel stopped faster than it can brake while still being
+ * driven, the output is cut.
+ * REVERSAL: The wheel turns against the output, e.g. swapped encoder or motor
+ * wires, the output is cut.
+ * OVERCURRENT: The measured current exceeded the limit, the output is cut.
+ *
+ * Faults which cut the output are latched until FaultMonitor::clear_faults().
+ */
+enum MotorFault : uint8_t
+{
+    MOTOR_FAULT_NONE = 0,
+    MOTOR_FAULT_STALL = 1 << 0,
+    MOTOR_FAULT_ENCODER_LOSS = 1 << 1,
+    MOTOR_FAULT_REVERSAL = 1 << 2,
+    MOTOR_FAULT_OVERCURRENT = 1 << 3,
+};
+
+// Faults which cut the output and are latched
+const uint8_t MOTOR_FAULTS_LATCHED = MOTOR_FAULT_ENCODER_LOSS |
+                                     MOTOR_FAULT_REVERSAL |
+                                     MOTOR_FAULT_OVERCURRENT;
+
+/**
+ * @brief Thresholds of the FaultMonitor.
+ *
+ */
+struct FaultConfig
+{
+    scalar_t stall_output = 0.8;     // |output| from which a standing wheel
+                                     // counts as stalled
+    scalar_t stall_speed = 0.5;      // in rad/s, below the wheel stands
+    scalar_t stall_time = 0.5;       // in s, longer than the motor spins up
+    scalar_t derate_output = 0.3;    // |output| limit of a stalled motor
+    scalar_t max_deceleration = 500; // in rad/s^2, physical braking limit
+    scalar_t reversal_speed = 2.0;   // in rad/s against the output
+    scalar_t reversal_time = 0.5;    // in s, longer than a full brake
+    scalar_t max_current = 0;        // in A, 0 disables the current check
+    scalar_t current_time = 0.02;    // in s above max_current
+};
+
+/**
+ * @brief The FaultMonitor class checks the output and the measured speed of
+ * each motor once per control cycle and limits the output of faulty motors
+ * before it is written to the motor driver, so a fault is acted on in the
+ * cycle it is detected in.
+ *
+ * A check costs a few comparisons per motor. If current sensors are set, one
+ * sensor is read per cycle in turn, so the ADC conversions are spread over
+ * the cycles.
+ *
+ * @note All methods except the constructor and set_current_sensor() must be
+ * called from the control task.
+ */
+class FaultMonitor
+{
+public:
+    /**
+     * @brief Construct a new Fault Monitor object.
+     *
+     * @param motor_count The number of motors.
+     * @param config The thresholds.
+     */
+    FaultMonitor(const uint8_t motor_count,
+                 const FaultConfig& config = FaultConfig());
+
+    /**
+     * @brief Measure the current of a motor, enables the overcurrent check if
+     * FaultConfig::max_current is set.
+     *
+     * @param motor_index The index of the motor.
+     * @param sensor The sensor, nullptr removes it.
+     *
+     * @note Must be called before the control task is started.
+     */
+    void set_current_sensor(const uint8_t motor_index, CurrentSensor* sensor);
+
+    /**
+     * @brief Check a motor and limit its output.
+     *
+     * @param motor_index The index of the motor.
+     * @param output The output computed by the motor controller.
+     * @param speed The measured rotation speed in rad/s.
+     * @param tick The control cycle.
+     * @return scalar_t The output to write, derated or 0 for a faulty motor.
+     */
+    scalar_t check(const uint8_t motor_index, const scalar_t output,
+                   const scalar_t speed, const ControlTick& tick);
+
+    /**
+     * @brief Get the faults of a motor.
+     *
+     * @param motor_index The index of the motor.
+     * @return uint8_t The MotorFault flags.
+     */
+    uint8_t get_faults(const uint8_t motor_index) const;
+
+    /**
+     * @brief Get the latest current of a motor.
+     *
+     * @param motor_index The index of the motor.
+     * @return scalar_t The current in A, 0 without a sensor.
+     */
+    scalar_t get_current(const uint8_t motor_index) const;
+
+    /**
+     * @brief Clear the faults of all motors, e.g. after the wiring was fixed.
+     *
+     */
+    void clear_faults();
+
+    /**
+     * @brief Set the thresholds.
+     *
+     * @param config The thresholds.
+     */
+    void set_config(const FaultConfig& config);
+
+    /**
+     * @brief Get the thresholds.
+     *
+     * @return const FaultConfig& The thresholds.
+     */
+    const FaultConfig& get_config() const;
+
+private:
+    struct MotorState
+    {
+        CurrentSensor* current_sensor = nullptr;
+        uint8_t faults = MOTOR_FAULT_NONE;
+        scalar_t stall_time = 0;
+        scalar_t reversal_time = 0;
+        scalar_t overcurrent_time = 0;
+        scalar_t previous_speed = 0;
+        scalar_t current = 0;
+    };
+
+    FaultConfig config_;
+    std::vector<MotorState> motors_;
+};
+
+#endif // FAULT_MONITOR_H
@@ -0,0 +1,263 @@
+/**
+ * @file feed_forward_motor_controller.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of MotorController with feed-forward and a velocity
+ * form PID controller with anti-windup.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef FEED_FORWARD_MOTOR_CONTROLLER_H
+#define FEED_FORWARD_MOTOR_CONTROLLER_H
+
+#include "motor-control/encoder.hpp"
+#include "motor_controller.hpp"
+#include "utils/controllers.hpp"
+#include "utils/filters.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Parameters of a FeedForwardMotorController.
+ *
+ */
+struct FeedForwardConfig
+{
+    PIDGains pid;                       // Feedback gains
+    scalar_t kv = 0;                    // Output per rad/s of the setpoint
+    scalar_t ks = 0;                    // Output overcoming the stiction
+    scalar_t kt = 10;                   // Anti-windup tracking gain in 1/s
+    scalar_t max_output = 1;            // Saturation of the motor driver
+    scalar_t max_sampling_time = 0.2;   // Longer gaps skip the differences
+};
+
+/**
+ * @brief Implementation of MotorController with feed-forward and PID feedback.
+ *
+ * The output is u = ks * sign(setpoint) + kv * setpoint + u_pid. The static
+ * term ks covers the region in which the motor does not turn because of
+ * stiction, the velocity term kv the steady state output, so the feedback only
+ * corrects the remaining error.
+ *
+ * The PID controller is computed in velocity form, each cycle adds
+ *
+ *   du = kp * (e[k] - e[k-1]) + ki * T * e[k]
+ *      - kd * (y[k] - 2 y[k-1] + y[k-2]) / T
+ *
+ * to u_pid. The derivative is taken on the measurement y, so a step of the
+ * setpoint does not cause a derivative kick, and gain changes are bumpless.
+ * When the output saturates at max_output (the L298NMotorDriver clamps to
+ * +-1), back-calculation pulls u_pid back by kt * T * (u_saturated - u), so the
+ * controller does not wind up and recovers without overshoot.
+ *
+ * @tparam InputFilter The filter applied to the measured rotation speed.
+ */
+template <typename InputFilter = FilterChain<>>
+class FeedForwardMotorController : public MotorController
+{
+public:
+    /**
+     * @brief Construct a new Feed Forward Motor Controller object
+     *
+     * @param motor_driver The motor driver to control.
+     * @param encoder The encoder to read the rotation speed from.
+     * @param config The gains and limits.
+     * @param input_filter The filter to use for the input.
+     */
+    FeedForwardMotorController(MotorDriver& motor_driver, Encoder& encoder,
+                               const FeedForwardConfig& config,
+                               InputFilter input_filter = InputFilter());
+
+    /**
+     * @brief Update the encoder.
+     *
+     * @param tick The control cycle.
+     */
+    void sample(const ControlTick& tick) override;
+
+    /**
+     * @brief Compute the motor output with the sampling time of the tick.
+     *
+     * @param desired_rotation_speed The desired rotation speed in rad/s.
+     * @param tick The control cycle.
+     * @return scalar_t The control output for the motor driver.
+     */
+    scalar_t compute(scalar_t desired_rotation_speed,
+                     const ControlTick& tick) override;
+
+    /**
+     * @brief Get the rotation speed of the motor.
+     *
+     * @return scalar_t The rotation speed in rad/s.
+     */
+    scalar_t get_rotation_speed() override;
+
+    /**
+     * @brief Fill in the encoder count and the PID terms of the last cycle.
+     * The integral term is the part of u_pid not explained by the
+     * proportional and derivative term.
+     *
+     * @param telemetry The telemetry to fill in.
+     */
+    void get_telemetry(MotorTelemetry& telemetry) override;
+
+    /**
+     * @brief Set the gains and limits. Takes effect without a bump.
+     *
+     * @param config The gains and limits.
+     */
+    void set_config(const FeedForwardConfig& config);
+
+    /**
+     * @brief Get the gains and limits.
+     *
+     * @return const FeedForwardConfig& The gains and limits.
+     */
+    const FeedForwardConfig& get_config() const;
+
+    /**
+     * @brief Reset the feedback state.
+     *
+     */
+    void reset();
+
+private:
+    Encoder& encoder_;
+    FeedForwardConfig config_;
+    InputFilter input_filter_;
+
+    uint8_t history_ = 0; // Number of valid previous cycles, at most 2
+    scalar_t u_pid_ = 0;
+    scalar_t previous_error_ = 0;
+    scalar_t previous_input_[2] = {0, 0}; // y[k-1], y[k-2]
+    scalar_t p_term_ = 0;
+    scalar_t d_term_ = 0;
+};
+
+// Template definitions
+
+template <typename InputFilter>
+FeedForwardMotorController<InputFilter>::FeedForwardMotorController(
+    MotorDriver& motor_driver, Encoder& encoder,
+    const FeedForwardConfig& config, InputFilter input_filter)
+    : MotorController(motor_driver), encoder_(encoder), config_(config),
+      input_filter_(input_filter)
+{
+}
+
+template <typename InputFilter>
+void FeedForwardMotorController<InputFilter>::sample(const ControlTick& tick)
+{
+    encoder_.update(tick);
+
+    if (tick.dt <= 0 || tick.dt > config_.max_sampling_time)
+    {
+        // The loop stalled, the differences are meaningless
+        history_ = 0;
+    }
+}
+
+template <typename InputFilter>
+scalar_t FeedForwardMotorController<InputFilter>::compute(
+    scalar_t desired_rotation_speed, const ControlTick& tick)
+{
+    const scalar_t input =
+        input_filter_.update(encoder_.get_velocity(), tick.dt);
+    const scalar_t error = desired_rotation_speed - input;
+    const bool stopping = std::abs(desired_rotation_speed) < scalar_t(1e-3);
+
+    scalar_t feed_forward = config_.kv * desired_rotation_speed;
+    if (!stopping)
+    {
+        feed_forward +=
+            desired_rotation_speed > 0 ? config_.ks : -config_.ks;
+    }
+
+    // Without a valid sampling time, only the proportional term is updated,
+    // the accumulated integral part is kept
+    const PIDGains& gains = config_.pid;
+    const scalar_t dt = tick.dt;
+    u_pid_ += gains.kp * (error - previous_error_);
+    d_term_ = 0;
+    if (history_ >= 1)
+    {
+        u_pid_ += gains.ki * dt * error;
+        d_term_ = -gains.kd * (input - previous_input_[0]) / dt;
+    }
+    if (history_ >= 2)
+    {
+        u_pid_ -= gains.kd *
+                  (input - 2 * previous_input_[0] + previous_input_[1]) / dt;
+    }
+    p_term_ = gains.kp * error;
+
+    const scalar_t output = feed_forward + u_pid_;
+    const scalar_t saturated =
+        std::clamp(output, -config_.max_output, config_.max_output);
+
+    // Back-calculation, the tracking step is limited to the full difference
+    if (saturated != output)
+    {
+        const scalar_t tracking =
+            history_ >= 1 ? std::min(config_.kt * dt, scalar_t(1.0))
+                          : scalar_t(1.0);
+        u_pid_ += tracking * (saturated - output);
+    }
+
+    previous_error_ = error;
+    previous_input_[1] = previous_input_[0];
+    previous_input_[0] = input;
+    history_ = std::min<uint8_t>(history_ + 1, 2);
+
+    // Below the stiction, a stopped motor would only hum
+    if (stopping && std::abs(saturated) < config_.ks)
+    {
+        return scalar_t(0.0);
+    }
+    return saturated;
+}
+
+template <typename InputFilter>
+scalar_t FeedForwardMotorController<InputFilter>::get_rotation_speed()
+{
+    return encoder_.get_velocity();
+}
+
+template <typename InputFilter>
+void FeedForwardMotorController<InputFilter>::get_telemetry(
+    MotorTelemetry& telemetry)
+{
+    telemetry.encoder_count = encoder_.get_count();
+    telemetry.p_term = p_term_;
+    telemetry.i_term = u_pid_ - p_term_ - d_term_;
+    telemetry.d_term = d_term_;
+}
+
+template <typename InputFilter>
+void FeedForwardMotorController<InputFilter>::set_config(
+    const FeedForwardConfig& config)
+{
+    config_ = config;
+}
+
+template <typename InputFilter>
+const FeedForwardConfig&
+FeedForwardMotorController<InputFilter>::get_config() const
+{
+    return config_;
+}
+
+template <typename InputFilter>
+void FeedForwardMotorController<InputFilter>::reset()
+{
+    history_ = 0;
+    u_pid_ = 0;
+    previous_error_ = 0;
+    p_term_ = 0;
+    d_term_ = 0;
+}
+
+#endif // FEED_FORWARD_MOTOR_CONTROLLER_H
@@ -14,10 +14,26 @@
 #include "motor-control/motor-drivers/motor_driver.hpp"
 #include <stdint.h>
 
+/**
+ * @brief What the L298N does with a control value of 0.
+ *
+ * COAST: The bridge is disabled, the motor runs down freely.
+ * BRAKE: Both motor terminals are connected, the motor is braked
+ * electrically.
+ */
+enum class StopMode : uint8_t
+{
+    COAST,
+    BRAKE
+};
+
 /**
  * @brief Implementation of MotorDriver, which sets the control output
  * directy to the L298N motor driver.
  *
+ * The direction pins are written through the GPIO set and clear registers and
+ * the PWM duty through the LEDC channel, both only when they change. In the
+ * control loop, most cycles therefore only compute the new duty and return.
  */
 class L298NMotorDriver : public MotorDriver
 {
@@ -29,9 +45,17 @@ public:
      * @param pin_in2 The pin number of the second input pin.
      * @param pin_ena The pin number of the enable pin.
      * @param pwm_channel The PWM channel to be used.
+     * @param pwm_frequency The PWM frequency in Hz.
+     * @param pwm_resolution The PWM resolution in bits. If the LEDC timer can
+     * not reach the frequency with it, the resolution is lowered until it
+     * can.
+     * @param stop_mode What to do with a control value of 0.
      */
     L298NMotorDriver(const uint8_t& pin_in1, const uint8_t& pin_in2,
-                     const uint8_t& pin_ena, const uint8_t& pwm_channel);
+                     const uint8_t& pin_ena, const uint8_t& pwm_channel,
+                     const uint32_t pwm_frequency = 5000,
+                     const uint8_t pwm_resolution = 8,
+                     const StopMode stop_mode = StopMode::COAST);
 
     /**
      * @brief Set the motor control object
@@ -39,13 +63,62 @@ public:
      * @param control_value The control value to be set. Should be between -1
      * and 1.
      */
-    void set_motor_control(float control_value);
+    void set_motor_control(scalar_t control_value);
+
+    /**
+     * @brief Brake the motor until the next non-zero control value.
+     *
+     */
+    void brake();
+
+    /**
+     * @brief Let the motor coast until the next non-zero control value.
+     *
+     */
+    void coast();
+
+    /**
+     * @brief Set what to do with a control value of 0.
+     *
+     * @param stop_mode The stop mode.
+     */
+    void set_stop_mode(const StopMode stop_mode);
+
+    /**
+     * @brief Get the PWM resolution in use.
+     *
+     * @return uint8_t The resolution in bits.
+     */
+    uint8_t get_pwm_resolution() const;
 
 private:
+    enum class BridgeState : uint8_t
+    {
+        UNKNOWN,
+        FORWARD,
+        BACKWARD,
+        BRAKE,
+        COAST
+    };
+
+    /**
+     * @brief Set the direction pins and the duty, writing only what changed.
+     *
+     * @param state The state of the direction pins.
+     * @param duty The PWM duty.
+     */
+    void apply(const BridgeState state, const uint32_t duty);
+
     const uint8_t pin_in1_;
     const uint8_t pin_in2_;
     const uint8_t pin_ena_;
     const uint8_t pwm_channel_;
+    uint8_t pwm_resolution_;
+    uint32_t max_duty_;
+    StopMode stop_mode_;
+
+    BridgeState state_ = BridgeState::UNKNOWN;
+    uint32_t duty_ = UINT32_MAX; // Invalid, so the first duty is written
 };
 
-#endif // L298N_MOTOR_DRIVER_H
\ No newline at end of file
+#endif // L298N_MOTOR_DRIVER_H
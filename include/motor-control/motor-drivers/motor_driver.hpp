@@ -11,6 +11,8 @@
 #ifndef MOTOR_DRIVER_H
 #define MOTOR_DRIVER_H
 
+#include "utils/scalar.h"
+
 /**
  * @class MotorDriver
  * @brief Abstract base class for motor control.
@@ -31,7 +33,7 @@ public:
      *
      * @param control_value The control value for the motor.
      */
-    virtual void set_motor_control(float control_value) = 0;
+    virtual void set_motor_control(scalar_t control_value) = 0;
 };
 
 #endif // MOTOR_DRIVER_H
\ No newline at end of file
@@ -12,6 +12,7 @@
 #ifndef MOTOR_CONTROLLER_MANAGER_H
 #define MOTOR_CONTROLLER_MANAGER_H
 
+#include "motor-control/fault_monitor.hpp"
 #include "motor-control/motor_controller.hpp"
 #include <ArduinoEigen.h>
 #include <vector>
@@ -19,6 +20,12 @@
 /**
  * @brief The MotorControllerManager class manages a collection of motors and
  *        their desired speeds.
+ *
+ * The motors are updated in batches: first the feedback of all motors is
+ * latched with the shared tick of the cycle, then all control outputs are computed
+ * and finally all outputs are written to the motor drivers back to back. This
+ * keeps the timing skew between the wheels small. Setpoints, measured speeds
+ * and outputs are stored in contiguous arrays.
  */
 class MotorControllerManager
 {
@@ -36,22 +43,22 @@ public:
      * @param motor_index The index of the motor.
      * @param desired_speed The desired speed value.
      */
-    void set_motor_speed(const uint8_t motor_index, float desired_speed);
+    void set_motor_speed(const uint8_t motor_index, scalar_t desired_speed);
 
     /**
      * @brief Set the desired speed for all motors.
      *
      * @param desired_speed The desired speed value.
      */
-    void set_all_motor_speeds(const float desired_speed);
+    void set_all_motor_speeds(const scalar_t desired_speed);
 
     /**
-     * @brief Get the desired speed of a specific motor.
+     * @brief Get the measured speed of a specific motor.
      *
      * @param motor_index The index of the motor.
-     * @return float The desired speed value.
+     * @return scalar_t The speed measured in the latest update.
      */
-    float get_motor_speed(const uint8_t motor_index) const;
+    scalar_t get_motor_speed(const uint8_t motor_index) const;
 
     /**
      * @brief Get the number of MotorControllers in the manager.
@@ -60,11 +67,62 @@ public:
      */
     uint8_t get_motor_count() const;
 
+    /**
+     * @brief Get the telemetry of a specific motor.
+     *
+     * @param motor_index The index of the motor.
+     * @param telemetry Set to the values of the latest update.
+     */
+    void get_telemetry(const uint8_t motor_index,
+                       MotorTelemetry& telemetry) const;
+
+    /**
+     * @brief Drive a motor with a fixed output instead of its controller, e.g.
+     * to identify it. The feedback is still sampled, compute() is skipped.
+     *
+     * @param motor_index The index of the motor.
+     * @param output The output for the motor driver.
+     */
+    void set_output_override(const uint8_t motor_index, const scalar_t output);
+
+    /**
+     * @brief Return a motor to its controller.
+     *
+     * @param motor_index The index of the motor.
+     */
+    void clear_output_override(const uint8_t motor_index);
+
+    /**
+     * @brief Check the outputs of all motors with a fault monitor before they
+     * are written, overridden outputs included.
+     *
+     * @param fault_monitor The fault monitor, sized for the motors of the
+     * manager. nullptr disables the checks.
+     */
+    void set_fault_monitor(FaultMonitor* fault_monitor);
+
+    /**
+     * @brief Get the faults of a specific motor.
+     *
+     * @param motor_index The index of the motor.
+     * @return uint8_t The MotorFault flags, MOTOR_FAULT_NONE without a fault
+     * monitor.
+     */
+    uint8_t get_faults(const uint8_t motor_index) const;
+
+    /**
+     * @brief Clear the faults of all motors.
+     *
+     */
+    void clear_faults();
+
     /**
      * @brief Update the MotorControllers to set the new desired rotational
      * speed.
+     *
+     * @param tick The control cycle shared by all motors.
      */
-    void update();
+    void update(const ControlTick& tick);
 
     /**
      * @brief Destroy the Motor Controller Manager object and free up the
@@ -73,8 +131,13 @@ public:
     ~MotorControllerManager();
 
 private:
-    std::vector<std::pair<MotorController*, float>> motor_controllers_; // Vector to hold MotorController pointers and
-                                                                        // desired speeds.
+    std::vector<MotorController*> motor_controllers_;
+    std::vector<scalar_t> desired_speeds_;
+    std::vector<scalar_t> measured_speeds_;
+    std::vector<scalar_t> outputs_;
+    std::vector<uint8_t> overridden_;
+    std::vector<scalar_t> output_overrides_;
+    FaultMonitor* fault_monitor_ = nullptr;
 };
 
 #endif // MOTOR_CONTROLLER_MANAGER_H
@@ -13,13 +13,33 @@
 #define MOTOR_CONTROLLER_H
 
 #include "motor-control/motor-drivers/motor_driver.hpp"
+#include "utils/control_tick.h"
+#include <Arduino.h>
+
+/**
+ * @brief Snapshot of the internal values of a motor controller.
+ *
+ */
+struct MotorTelemetry
+{
+    scalar_t setpoint = 0;      // Desired rotation speed in rad/s
+    scalar_t measured = 0;      // Measured rotation speed in rad/s
+    scalar_t output = 0;        // Control output (PWM duty) in [-1, 1]
+    int32_t encoder_count = 0;  // Raw encoder count
+    scalar_t p_term = 0;
+    scalar_t i_term = 0;
+    scalar_t d_term = 0;
+};
 
 /**
  * @brief Abstract base class for controlling motors.
  *
  * @note This class defines an interface for controlling motors using a
- * MotorDriver. Subclasses of MotorController are expected to implement the
- * set_rotation_speed method to set the desired rotation speed of the motor.
+ * MotorDriver. A control cycle is split into three phases: sample() latches
+ * the feedback, compute() calculates the control output and apply() writes it
+ * to the motor driver. This allows MotorControllerManager to run each phase
+ * for all motors back to back. Subclasses are expected to implement compute()
+ * and, if they use feedback, sample().
  */
 class MotorController
 {
@@ -36,23 +56,66 @@ public:
      * @brief Set the desired rotation speed of the motor.
      *
      * @param desired_rotation_speed The desired rotation speed for the motor.
+     * @param tick The control cycle.
      *
      * @note This method allows setting the desired rotation speed for the motor
      * controlled by the MotorDriver. The actual behavior of the motor may
-     * depend on the implementation of the MotorDriver.
+     * depend on the implementation of the MotorDriver. Runs all three phases
+     * of a control cycle for this motor only.
      */
-    virtual void set_rotation_speed(float desired_rotation_speed) = 0;
+    void set_rotation_speed(scalar_t desired_rotation_speed,
+                            const ControlTick& tick)
+    {
+        sample(tick);
+        apply(compute(desired_rotation_speed, tick));
+    }
+
+    /**
+     * @brief Latch the feedback of the motor, e.g. the encoder count.
+     *
+     * @param tick The control cycle, shared by all motors.
+     */
+    virtual void sample(const ControlTick& tick) {}
+
+    /**
+     * @brief Compute the control output from the latched feedback.
+     *
+     * @param desired_rotation_speed The desired rotation speed for the motor.
+     * @param tick The control cycle, the same as passed to sample().
+     * @return scalar_t The control output for the motor driver.
+     */
+    virtual scalar_t compute(scalar_t desired_rotation_speed,
+                             const ControlTick& tick) = 0;
+
+    /**
+     * @brief Write the control output to the motor driver.
+     *
+     * @param control_output The control output returned by compute().
+     */
+    void apply(scalar_t control_output)
+    {
+        motor_driver_.set_motor_control(control_output);
+    }
 
     /**
      * @brief Get the current rotation speed of the motor.
      *
-     * @return float
+     * @return scalar_t
      *
      * @note This method returns the current rotation speed of the motor. The
      * actual behavior of the motor may depend on the implementation of the
      * MotorDriver.
      */
-    virtual float get_rotation_speed() = 0;
+    virtual scalar_t get_rotation_speed() = 0;
+
+    /**
+     * @brief Fill in the controller specific values of the telemetry, e.g.
+     * the encoder count and the PID terms of the last control cycle.
+     *
+     * @param telemetry The telemetry to fill in. Setpoint, measured speed and
+     * output are filled in by MotorControllerManager.
+     */
+    virtual void get_telemetry(MotorTelemetry& telemetry) {}
 
     /**
      * @brief Set the print debug object
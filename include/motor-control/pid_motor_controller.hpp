@@ -16,12 +16,23 @@
 #include "motor-control/encoder.hpp"
 #include "motor_controller.hpp"
 #include "utils/controllers.hpp"
+#include "utils/filters.hpp"
+#include <cmath>
 
 /**
  * @brief Implementation of MotorController, which sets the control output
  * directy to the motor driver with encoder feedback and PID control.
  *
+ * The input and output filters are template parameters. With FilterChain types
+ * (the default is an empty chain) the filters are stored by value and inlined
+ * into compute(). Using Filter& instead keeps the filters exchangeable at
+ * runtime, e.g. for tuning builds (see TunablePIDMotorController).
+ *
+ * @tparam InputFilter The filter applied to the measured rotation speed.
+ * @tparam OutputFilter The filter applied to the control output.
  */
+template <typename InputFilter = FilterChain<>,
+          typename OutputFilter = FilterChain<>>
 class PIDMotorController : public MotorController
 {
 public:
@@ -33,31 +44,151 @@ public:
      * @param pid_controller The PID controller to use.
      * @param input_filter The filter to use for the input.
      * @param output_filter The filter to use for the output.
+     * @param min_output Outputs below this are dropped when stopping.
+     */
+    PIDMotorController(MotorDriver& motor_driver, Encoder& encoder,
+                       PIDController& pid_controller, InputFilter input_filter,
+                       OutputFilter output_filter, scalar_t min_output);
+
+    /**
+     * @brief Construct a new PIDMotorController object with default
+     * constructed filters.
+     *
+     * @param motor_driver The motor driver to control.
+     * @param encoder The encoder to read the rotation speed from.
+     * @param pid_controller The PID controller to use.
+     * @param min_output Outputs below this are dropped when stopping.
      */
     PIDMotorController(MotorDriver& motor_driver, Encoder& encoder,
-                       PIDController& pid_controller, Filter& input_filter,
-                       Filter& output_filter, double min_output);
+                       PIDController& pid_controller, scalar_t min_output);
 
     /**
-     * @brief Set the rotation speed of the motor.
+     * @brief Update the encoder.
+     *
+     * @param tick The control cycle.
+     */
+    void sample(const ControlTick& tick) override;
+
+    /**
+     * @brief Compute the motor output with the PID controller. The filters
+     * and the PID controller use the sampling time of the tick.
      *
      * @param desired_rotation_speed The desired rotation speed in rad/s.
+     * @param tick The control cycle.
+     * @return scalar_t The control output for the motor driver.
      */
-    void set_rotation_speed(float desired_rotation_speed);
+    scalar_t compute(scalar_t desired_rotation_speed,
+                     const ControlTick& tick) override;
 
     /**
      * @brief Get the rotation speed of the motor.
      *
-     * @return float The rotation speed in rad/s.
+     * @return scalar_t The rotation speed in rad/s.
+     */
+    scalar_t get_rotation_speed();
+
+    /**
+     * @brief Fill in the encoder count and the PID terms of the last cycle.
+     *
+     * @param telemetry The telemetry to fill in.
      */
-    float get_rotation_speed();
+    void get_telemetry(MotorTelemetry& telemetry) override;
+
+    /**
+     * @brief Set the output below which the motor is stopped when the desired
+     * rotation speed is 0, e.g. the identified stiction.
+     *
+     * @param min_output The minimum output.
+     *
+     * @note Not synchronized with compute(), call before the control task is
+     * started.
+     */
+    void set_min_output(const scalar_t min_output);
 
 private:
     Encoder& encoder_;
     PIDController& pid_;
-    Filter& input_filter_;
-    Filter& output_filter_;
-    double min_output_;
+    InputFilter input_filter_;
+    OutputFilter output_filter_;
+    scalar_t min_output_;
 };
 
+/**
+ * @brief PIDMotorController with runtime polymorphic filters.
+ *
+ */
+typedef PIDMotorController<Filter&, Filter&> TunablePIDMotorController;
+
+// Template definitions
+
+template <typename InputFilter, typename OutputFilter>
+PIDMotorController<InputFilter, OutputFilter>::PIDMotorController(
+    MotorDriver& motor_driver, Encoder& encoder, PIDController& pid,
+    InputFilter input_filter, OutputFilter output_filter, scalar_t min_output)
+    : MotorController(motor_driver), encoder_(encoder), pid_(pid),
+      input_filter_(input_filter), output_filter_(output_filter),
+      min_output_(min_output)
+{
+}
+
+template <typename InputFilter, typename OutputFilter>
+PIDMotorController<InputFilter, OutputFilter>::PIDMotorController(
+    MotorDriver& motor_driver, Encoder& encoder, PIDController& pid,
+    scalar_t min_output)
+    : MotorController(motor_driver), encoder_(encoder), pid_(pid),
+      min_output_(min_output)
+{
+}
+
+template <typename InputFilter, typename OutputFilter>
+void PIDMotorController<InputFilter, OutputFilter>::sample(
+    const ControlTick& tick)
+{
+    encoder_.update(tick);
+}
+
+template <typename InputFilter, typename OutputFilter>
+scalar_t PIDMotorController<InputFilter, OutputFilter>::compute(
+    scalar_t desired_rotation_speed, const ControlTick& tick)
+{
+    scalar_t input = encoder_.get_velocity();
+
+    input = input_filter_.update(input, tick.dt);
+
+    scalar_t output = pid_.update(desired_rotation_speed, input, tick.dt);
+
+    output = output_filter_.update(output, tick.dt);
+
+    if (std::abs(output) < min_output_ &&
+        std::abs(desired_rotation_speed) < scalar_t(1e-3))
+    {
+        output = scalar_t(0.0);
+    }
+
+    return output;
+}
+
+template <typename InputFilter, typename OutputFilter>
+scalar_t PIDMotorController<InputFilter, OutputFilter>::get_rotation_speed()
+{
+    return encoder_.get_velocity();
+}
+
+template <typename InputFilter, typename OutputFilter>
+void PIDMotorController<InputFilter, OutputFilter>::get_telemetry(
+    MotorTelemetry& telemetry)
+{
+    telemetry.encoder_count = encoder_.get_count();
+    telemetry.p_term = pid_.get_p_term();
+    telemetry.i_term = pid_.get_i_term();
+    telemetry.d_term = pid_.get_d_term();
+}
+
+template <typename InputFilter, typename OutputFilter>
+void PIDMotorController<InputFilter, OutputFilter>::set_min_output(
+    const scalar_t min_output)
+{
+    min_output_ = min_output;
+}
+
 #endif // PID_MOTOR_CONTROLLER_H
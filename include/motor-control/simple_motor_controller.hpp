@@ -30,28 +30,31 @@ public:
      * rad/sec
      */
     SimpleMotorController(MotorDriver& motor_driver,
-                          const float max_rotation_speed);
+                          const scalar_t max_rotation_speed);
 
     /**
-     * @brief Set the rotation speed of the motor
+     * @brief Compute the control output for the rotation speed of the motor
      *
      * @param desired_rotation_speed desired rotation speed in rad/sec
+     * @param tick The control cycle (unused)
+     * @return scalar_t control output for the motor driver
      */
-    void set_rotation_speed(const float desired_rotation_speed);
+    scalar_t compute(scalar_t desired_rotation_speed,
+                     const ControlTick& tick) override;
 
     /**
      * @brief Get the rotation speed of the motor
      *
-     * @return float rotation speed in rad/sec
+     * @return scalar_t rotation speed in rad/sec
      *
      * @note This is not the actual rotation speed of the motor, but the
      * rotation speed that was set using set_rotation_speed.
      */
-    float get_rotation_speed();
+    scalar_t get_rotation_speed();
 
 private:
-    const float max_rotation_speed_;
-    float rotation_speed_setpoint_;
+    const scalar_t max_rotation_speed_;
+    scalar_t rotation_speed_setpoint_;
 };
 
 #endif // SIMPLE_MOTOR_CONTROLLER_H
@@ -0,0 +1,439 @@
+/**
+ * @file control_task.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief FreeRTOS task running the motor control loop at a fixed rate.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONTROL_TASK_H
+#define CONTROL_TASK_H
+
+#include <Arduino.h>
+#include <ArduinoEigen.h>
+#include <array>
+
+#include "kinematics/odometry.hpp"
+#include "motor-control/autotune.hpp"
+#include "rtos/rate_group.hpp"
+#include "utils/control_limits.hpp"
+#include "utils/controllers.hpp"
+#include "utils/gain_schedule.hpp"
+#include "utils/heap_monitor.hpp"
+#include "utils/instrumentation.hpp"
+#include "utils/ring_buffer.hpp"
+#include "utils/scalar.h"
+#include "utils/setpoint_generator.hpp"
+#include "utils/trace_buffer.hpp"
+#include "utils/triple_buffer.hpp"
+#include "velocity_controller.hpp"
+
+/**
+ * @brief Setpoint handed from the micro-ROS task to the control task.
+ *
+ */
+struct ControlSetpoint
+{
+    Vector3 velocity = Vector3::Zero(); // Commanded robot velocity, the target
+                                        // of the setpoint generator
+};
+
+/**
+ * @brief Rate groups of the control loop. Each stage runs only as fast as it
+ * needs to, the deadlines are the budget of a run within one base cycle.
+ *
+ */
+struct ControlRates
+{
+    RateGroupConfig setpoint{100, 50};    // Ramp of the commanded velocity
+    RateGroupConfig kinematics{200, 100}; // Wheel setpoints of the twist
+    RateGroupConfig motors{1000, 400};    // Encoders, filters and wheel PIDs
+    RateGroupConfig odometry{200, 100};   // Robot velocity and pose
+};
+
+/**
+ * @brief State of the control loop, published by the control task once per
+ * cycle.
+ *
+ * @tparam WheelCount The number of wheels.
+ */
+template <int WheelCount>
+struct ControlState
+{
+    typedef typename Kinematics<WheelCount>::WheelVector WheelVector;
+
+    Vector3 robot_velocity = Vector3::Zero();
+    Vector3 setpoint_velocity = Vector3::Zero(); // Of the setpoint generator
+    bool command_timed_out = false;
+    WheelVector set_wheel_velocities = WheelVector::Zero();
+    WheelVector measured_wheel_velocities = WheelVector::Zero();
+    scalar_t saturation_scale = 1; // < 1 if the wheel speeds were limited
+    std::array<uint8_t, WheelCount> motor_faults{}; // MotorFault flags
+    bool autotuning = false;       // The robot is held while motors are tuned
+    OdometryEstimate odometry; // Integrated at the control rate
+    uint32_t tick = 0; // Index of the cycle the state was captured in
+};
+
+/**
+ * @brief Yaw rate measured by a gyro.
+ *
+ */
+struct GyroSample
+{
+    scalar_t rate = 0;              // in rad/s
+    unsigned long timestamp_us = 0; // micros() at the measurement
+};
+
+/**
+ * @brief Outcome of the autotune of a motor.
+ *
+ */
+struct AutotuneReport
+{
+    uint8_t motor = 0;
+    AutotuneState state = AutotuneState::IDLE; // DONE or FAILED
+    AutotuneResult result;                     // Valid if DONE
+};
+
+/**
+ * @brief Telemetry of all motors in one control cycle.
+ *
+ * @tparam WheelCount The number of wheels.
+ */
+template <int WheelCount>
+struct TelemetrySample
+{
+    uint32_t tick = 0; // Index of the cycle the sample was captured in
+    MotorTelemetry motors[WheelCount];
+};
+
+/**
+ * @brief Timing of the control loop over one reporting window.
+ *
+ */
+struct ControlTiming
+{
+    LatencySummary cycle;         // Duration of a control cycle
+    LatencySummary period;        // Time between two consecutive wake ups
+    uint32_t deadline_misses = 0; // Periods longer than 1.5 nominal periods
+    RateGroupTiming setpoint;
+    RateGroupTiming kinematics;
+    RateGroupTiming motors;
+    RateGroupTiming odometry;
+};
+
+/**
+ * @brief The ControlTask class runs VelocityController::update() periodically
+ * in its own FreeRTOS task, pinned to a dedicated core.
+ *
+ * Setpoints and state are exchanged with the rest of the firmware (micro-ROS
+ * executor, publishers) through wait-free triple buffers, so neither side can
+ * delay the other and torn values can not be observed. New setpoints and gain
+ * schedules are applied at the start of a control cycle, the scheduled gains
+ * are evaluated every cycle. Setpoints are targets of a SetpointGenerator,
+ * which ramps the commanded velocity towards them at the control rate and
+ * stops the robot if no setpoint arrives within its timeout. The odometry is
+ * integrated as well, fused with the latest gyro rate if it is recent enough.
+ *
+ * The stages run in rate groups at fractions of the base rate (see
+ * ControlRates): the setpoint generator, the kinematics computing the wheel
+ * setpoints, the motor controllers and the odometry. The groups are staggered
+ * over the cycles, so at the default rates no two of the slower groups run in
+ * the same cycle. Every run is timed and checked against the deadline of its
+ * group.
+ *
+ * On request, the motors are identified and tuned one after another by a
+ * MotorAutotuner, while the robot is commanded to stand still.
+ *
+ * @tparam WheelCount The number of wheels of the velocity controller.
+ */
+template <int WheelCount>
+class ControlTask
+{
+public:
+    static constexpr uint16_t TELEMETRY_QUEUE_SIZE = 32;
+    static constexpr uint16_t AUTOTUNE_QUEUE_SIZE = 4;
+
+    typedef std::array<PIDGains, WheelCount> GainScales;
+
+    /**
+     * @brief Construct a new Control Task object. The task is not started
+     * until start() is called.
+     *
+     * @param velocity_controller The velocity controller to update. Must only
+     * be accessed through this object once the task is running.
+     * @param frequency The control loop frequency in Hz. Limited by the
+     * FreeRTOS tick rate.
+     * @param core The core the task is pinned to.
+     * @param priority The FreeRTOS priority of the task.
+     * @param stack_size The stack size of the task in bytes.
+     * @param rates The rate groups, rounded to divisors of the frequency.
+     */
+    ControlTask(VelocityController<WheelCount>& velocity_controller,
+                const uint16_t frequency, const BaseType_t core,
+                const UBaseType_t priority, const uint32_t stack_size,
+                const ControlRates& rates = ControlRates());
+
+    /**
+     * @brief Register a PID controller whose gains follow the gain schedule.
+     * The n-th registered controller is scheduled on the speed of the n-th
+     * wheel.
+     *
+     * @param controller The PID controller.
+     * @return true If the controller was registered.
+     * @return false If WheelCount controllers are already registered.
+     *
+     * @note Must be called before start().
+     */
+    bool add_gain_scheduled_controller(PIDController* controller);
+
+    /**
+     * @brief Create and start the control task.
+     *
+     * @return true If the task was created.
+     * @return false If the task could not be created.
+     */
+    bool start();
+
+    /**
+     * @brief Hand a new setpoint to the control task.
+     *
+     * @param setpoint The commanded robot velocity and scheduled gains.
+     *
+     * @note Must only be called from a single task. Never blocks.
+     */
+    void set_setpoint(const ControlSetpoint& setpoint);
+
+    /**
+     * @brief Hand a new gain schedule to the control task. Until the first
+     * schedule was set, the gains of the controllers are left untouched.
+     *
+     * @param schedule The gain schedule.
+     * @return true If the schedule was handed over.
+     * @return false If the schedule is invalid and was ignored.
+     *
+     * @note Must only be called from a single task. Never blocks.
+     */
+    bool set_gain_schedule(const GainSchedule& schedule);
+
+    /**
+     * @brief Scale the scheduled gains of each registered controller, e.g. to
+     * the level identified by an autotune. The gains are multiplied element
+     * wise, all scales are 1 by default.
+     *
+     * @param scales The scales of kp, ki and kd per controller.
+     *
+     * @note Must only be called from a single task. Never blocks.
+     */
+    void set_gain_scales(const GainScales& scales);
+
+    /**
+     * @brief Identify and tune all motors one after another. Setpoints are
+     * ignored until the last motor is done, the other motors are held at 0.
+     *
+     * @param config The excitation and tuning parameters.
+     *
+     * @note The motors run open loop, the robot must be lifted. Must only be
+     * called from a single task. Never blocks.
+     */
+    void start_autotune(const AutotuneConfig& config);
+
+    /**
+     * @brief Clear the faults of all motors at the start of the next cycle.
+     * A fault whose cause persists is detected again.
+     *
+     * @note Must only be called from a single task. Never blocks.
+     */
+    void clear_faults();
+
+    /**
+     * @brief Fetch the outcome of the autotune of the next motor.
+     *
+     * @param report Set to the outcome.
+     * @return true If a motor was done.
+     * @return false If no outcome is queued.
+     *
+     * @note Must only be called from a single task. Never blocks.
+     */
+    bool pop_autotune_report(AutotuneReport& report);
+
+    /**
+     * @brief Get the state of the latest control cycle.
+     *
+     * @return const ControlState<WheelCount>& The latest state. Stays valid
+     * until the next call.
+     *
+     * @note Must only be called from a single task. Never blocks.
+     */
+    const ControlState<WheelCount>& get_state();
+
+    /**
+     * @brief Get the period of the control loop.
+     *
+     * @return TickType_t The control period in FreeRTOS ticks.
+     */
+    TickType_t get_period_ticks() const;
+
+    /**
+     * @brief Get the number of heap allocations made by the control task.
+     *
+     * @return uint32_t The allocation count. Stays zero as long as the control
+     * path is allocation free.
+     */
+    uint32_t get_allocation_count() const;
+
+    /**
+     * @brief Get the timing of the control loop. A new summary is published
+     * once per second.
+     *
+     * @param timing Set to the latest summary.
+     * @return true If a new summary was published since the last call.
+     * @return false If no new summary was published since the last call.
+     *
+     * @note Must only be called from a single task. Never blocks.
+     */
+    bool get_timing(ControlTiming& timing);
+
+    /**
+     * @brief Record the telemetry of every n-th control cycle.
+     *
+     * @param decimation The number of cycles per sample, 0 disables the
+     * telemetry (the default).
+     *
+     * @note Must be called before start().
+     */
+    void set_telemetry_decimation(const uint16_t decimation);
+
+    /**
+     * @brief Fetch the oldest recorded telemetry sample.
+     *
+     * @param sample Set to the oldest sample.
+     * @return true If a sample was fetched.
+     * @return false If no sample is queued.
+     *
+     * @note Must only be called from a single task. Never blocks.
+     */
+    bool pop_telemetry(TelemetrySample<WheelCount>& sample);
+
+    /**
+     * @brief Get the number of telemetry samples dropped because they were
+     * not fetched in time.
+     *
+     * @return uint32_t The drop count.
+     */
+    uint32_t get_telemetry_drop_count() const;
+
+    /**
+     * @brief Record every control cycle into a trace buffer.
+     *
+     * @param trace The allocated trace buffer, nullptr disables the trace.
+     * @param error_threshold Triggers the trace if the tracking error of a
+     * wheel exceeds it, 0 disables the threshold.
+     *
+     * @note Must be called before start().
+     */
+    void set_trace(TraceBuffer<TraceRecord<WheelCount>>* trace,
+                   const scalar_t error_threshold);
+
+    /**
+     * @brief Hand new limits to the control task. The acceleration and jerk
+     * limits and the timeout go to the setpoint generator, without them
+     * setpoints are applied immediately. The wheel speed limit and saturation
+     * policy go to the velocity controller.
+     *
+     * @param limits The limits.
+     *
+     * @note Must only be called from a single task. Never blocks.
+     */
+    void set_limits(const ControlLimits& limits);
+
+    /**
+     * @brief Set the noise model and gyro fusion parameters of the odometry.
+     *
+     * @param config The odometry configuration.
+     * @param gyro_timeout Gyro rates older than this in microseconds are
+     * ignored and the odometry falls back to the wheels.
+     *
+     * @note Must be called before start().
+     */
+    void set_odometry_config(const OdometryConfig& config,
+                             const uint32_t gyro_timeout = 50000);
+
+    /**
+     * @brief Hand the latest yaw rate of a gyro to the control task.
+     *
+     * @param rate The yaw rate in rad/s.
+     *
+     * @note Must only be called from a single task. Never blocks.
+     */
+    void set_gyro_rate(const scalar_t rate);
+
+private:
+    static void task_entry(void* parameter);
+    void run();
+
+    /**
+     * @brief Advance the autotune of the current motor by one cycle and move
+     * on to the next motor when it is done.
+     *
+     * @param state The state of the previous cycle.
+     * @param tick The control cycle.
+     */
+    void update_autotune(const ControlState<WheelCount>& state,
+                         const ControlTick& tick);
+
+    VelocityController<WheelCount>& velocity_controller_;
+    const TickType_t period_ticks_;
+    const uint32_t period_us_;
+    const uint16_t timing_window_; // Cycles per timing summary
+    const BaseType_t core_;
+    const UBaseType_t priority_;
+    const uint32_t stack_size_;
+    TaskHandle_t task_handle_ = nullptr;
+
+    RateGroup setpoint_group_;
+    RateGroup kinematics_group_;
+    RateGroup motor_group_;
+    RateGroup odometry_group_;
+
+    PIDController* gain_scheduled_controllers_[WheelCount];
+    uint8_t gain_scheduled_controller_count_ = 0;
+
+    TripleBuffer<ControlSetpoint> setpoint_buffer_;
+    SetpointGenerator setpoint_generator_; // Owned by the control task
+    TripleBuffer<ControlLimits> limits_buffer_;
+    TripleBuffer<GainSchedule> gain_schedule_buffer_;
+    GainSchedule gain_schedule_; // Owned by the control task
+    bool gain_scheduling_ = false;
+    TripleBuffer<GainScales> gain_scales_buffer_;
+    GainScales gain_scales_; // Owned by the control task
+    TripleBuffer<ControlState<WheelCount>> state_buffer_;
+    TripleBuffer<bool> fault_clear_buffer_;
+
+    Odometry odometry_; // Owned by the control task
+    uint32_t gyro_timeout_ = 50000;
+    TripleBuffer<GyroSample> gyro_buffer_;
+
+    LatencyHistogram cycle_histogram_;
+    LatencyHistogram period_histogram_;
+    uint32_t deadline_misses_ = 0;
+    TripleBuffer<ControlTiming> timing_buffer_;
+
+    uint16_t telemetry_decimation_ = 0;
+    RingBuffer<TelemetrySample<WheelCount>, TELEMETRY_QUEUE_SIZE>
+        telemetry_buffer_;
+
+    TripleBuffer<AutotuneConfig> autotune_buffer_;
+    AutotuneConfig autotune_config_; // Owned by the control task
+    MotorAutotuner autotuner_;       // Owned by the control task
+    uint8_t autotune_motor_ = WheelCount; // WheelCount if not tuning
+    RingBuffer<AutotuneReport, AUTOTUNE_QUEUE_SIZE> autotune_reports_;
+
+    TraceBuffer<TraceRecord<WheelCount>>* trace_ = nullptr;
+    scalar_t trace_error_threshold_ = 0;
+};
+
+#endif // CONTROL_TASK_H
@@ -0,0 +1,124 @@
+/**
+ * @file rate_group.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Stages of the control loop running at a fraction of its rate.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef RATE_GROUP_H
+#define RATE_GROUP_H
+
+#include <stdint.h>
+
+#include "utils/control_tick.h"
+#include "utils/instrumentation.hpp"
+
+/**
+ * @brief Rate and deadline of a rate group.
+ *
+ */
+struct RateGroupConfig
+{
+    uint16_t frequency = 0;   // in Hz, rounded to a divisor of the base rate
+    uint32_t deadline_us = 0; // Longest allowed run, 0 disables the check
+};
+
+/**
+ * @brief Timing of a rate group over one reporting window.
+ *
+ */
+struct RateGroupTiming
+{
+    LatencySummary duration; // Of a run
+    uint32_t overruns = 0;   // Runs longer than the deadline
+};
+
+/**
+ * @brief The RateGroup class runs a stage of a cyclic control loop in every
+ * n-th cycle of the base rate and checks each run against its deadline.
+ *
+ * Groups with the same divisor can be spread over the cycles with different
+ * offsets, so the slow stages do not pile up in the same cycle and the worst
+ * case cycle stays short. Each group keeps its own ControlTick, whose dt is
+ * the time since the previous run of the group.
+ *
+ *     if (group.begin(tick))
+ *     {
+ *         stage.update(group.get_tick());
+ *         group.end();
+ *     }
+ *
+ * @note Must only be used from the control task.
+ */
+class RateGroup
+{
+public:
+    /**
+     * @brief Construct a new Rate Group object.
+     *
+     * @param base_frequency The rate of the control loop in Hz.
+     * @param config The rate and the deadline of the group.
+     * @param offset The cycle within the divisor the group runs in.
+     */
+    RateGroup(const uint16_t base_frequency, const RateGroupConfig& config,
+              const uint16_t offset = 0);
+
+    /**
+     * @brief Check whether the group runs in a cycle and start timing the run.
+     *
+     * @param tick The cycle of the control loop.
+     * @return true If the group runs, end() must be called after the run.
+     * @return false If the group skips the cycle.
+     */
+    bool begin(const ControlTick& tick);
+
+    /**
+     * @brief Stop timing the run and count an overrun of the deadline.
+     *
+     */
+    void end();
+
+    /**
+     * @brief Get the tick of the current run.
+     *
+     * @return const ControlTick& The tick, counting the runs of the group.
+     */
+    const ControlTick& get_tick() const;
+
+    /**
+     * @brief Get the number of base cycles per run.
+     *
+     * @return uint16_t The divisor, at least 1.
+     */
+    uint16_t get_divisor() const;
+
+    /**
+     * @brief Get the timing since the last reset_timing().
+     *
+     * @return RateGroupTiming The duration summary and overrun count.
+     */
+    RateGroupTiming get_timing() const;
+
+    /**
+     * @brief Start a new reporting window.
+     *
+     */
+    void reset_timing();
+
+private:
+    const uint16_t divisor_;
+    const uint16_t offset_;
+    const uint32_t deadline_us_;
+    const scalar_t nominal_dt_;
+
+    ControlTick tick_;
+    uint32_t start_cycles_ = 0;
+    LatencyHistogram duration_histogram_;
+    uint32_t overruns_ = 0;
+};
+
+#endif // RATE_GROUP_H
@@ -0,0 +1,96 @@
+/**
+ * @file benchmark.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Minimal micro benchmark harness for the native environments.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief Keep a value alive, so the computation of it is not optimized away.
+ *
+ * @param value The value.
+ */
+template <typename T> inline void do_not_optimize(const T& value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief The Benchmark class measures the time per call of a function in the
+ * style of Google Benchmark: the number of iterations is doubled until one run
+ * takes at least MIN_RUN_TIME, then REPETITIONS runs are timed and the minimum
+ * and median are reported in ns/op.
+ */
+class Benchmark
+{
+public:
+    static constexpr double MIN_RUN_TIME = 0.02; // in s
+    static constexpr uint8_t REPETITIONS = 7;
+
+    /**
+     * @brief Print the header of the result table.
+     *
+     */
+    static void print_header()
+    {
+        printf("%-40s %12s %12s %12s\n", "benchmark", "iterations",
+               "min ns/op", "median ns/op");
+    }
+
+    /**
+     * @brief Run a benchmark and print the result.
+     *
+     * @param name The name of the benchmark.
+     * @param function Called with the index of the iteration.
+     * @return double The median time in ns/op.
+     */
+    template <typename Function>
+    static double run(const char* name, Function&& function)
+    {
+        uint64_t iterations = 1;
+        while (time_run(function, iterations) < MIN_RUN_TIME &&
+               iterations < (uint64_t(1) << 40))
+        {
+            iterations *= 2;
+        }
+
+        double results[REPETITIONS];
+        for (uint8_t i = 0; i < REPETITIONS; i++)
+        {
+            results[i] = time_run(function, iterations) * 1e9 / iterations;
+        }
+        std::sort(results, results + REPETITIONS);
+
+        printf("%-40s %12llu %12.1f %12.1f\n", name,
+               (unsigned long long)iterations, results[0],
+               results[REPETITIONS / 2]);
+        return results[REPETITIONS / 2];
+    }
+
+private:
+    template <typename Function>
+    static double time_run(Function& function, const uint64_t iterations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            function(i);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,130 @@
+/**
+ * @file dc_motor_plant.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Simulated DC motor with an encoder.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DC_MOTOR_PLANT_H
+#define DC_MOTOR_PLANT_H
+
+#include <stdint.h>
+
+#include "motor-control/motor-drivers/motor_driver.hpp"
+#include "utils/scalar.h"
+
+/**
+ * @brief Parameters of a DCMotorPlant. The defaults are a small 12 V gear
+ * motor with a no-load speed of about 40 rad/s.
+ *
+ */
+struct DCMotorParameters
+{
+    double supply_voltage = 12.0;    // in V, at a control value of 1
+    double resistance = 2.0;         // Armature resistance in Ohm
+    double motor_constant = 0.3;     // Torque and back-EMF constant in Nm/A
+    double inertia = 0.002;          // Of the motor, gear and wheel in kg m^2
+    double viscous_friction = 0.001; // in Nm s/rad
+    double coulomb_friction = 0.02;  // in Nm
+    double load_torque = 0.0;        // External load in Nm
+};
+
+/**
+ * @brief The DCMotorPlant class simulates a DC motor driven by a voltage and
+ * the encoder on its shaft. It is used as the MotorDriver of a motor
+ * controller. The encoder count is written to the shim of the encoder
+ * library, so a HalfQuadEncoder with the same A pin reads it. For every count,
+ * the interrupt of the A pin is called at the interpolated time of the edge
+ * with the B pin LOW when turning forward, as an EdgeTimingEncoder expects.
+ *
+ * The armature inductance is neglected, the current follows the voltage
+ * immediately:
+ *
+ *   i = (V - k w) / R
+ *   J dw/dt = k i - b w - tau_c sign(w) - tau_load
+ *
+ * Coulomb friction holds the motor at standstill as long as the remaining
+ * torque stays below it.
+ */
+class DCMotorPlant : public MotorDriver
+{
+public:
+    /**
+     * @brief Construct a new DC Motor Plant object.
+     *
+     * @param encoder_pin_A The A pin of the simulated encoder.
+     * @param encoder_pin_B The B pin of the simulated encoder.
+     * @param encoder_resolution The counts per revolution of the encoder.
+     * @param parameters The parameters of the motor.
+     * @param reverse Whether positive control values turn the motor in the
+     * negative direction.
+     */
+    DCMotorPlant(const uint8_t encoder_pin_A, const uint8_t encoder_pin_B,
+                 const uint16_t encoder_resolution,
+                 const DCMotorParameters& parameters = DCMotorParameters(),
+                 const bool reverse = false);
+
+    /**
+     * @brief Set the control value of the motor driver.
+     *
+     * @param control_value The control value between -1 and 1.
+     */
+    void set_motor_control(scalar_t control_value) override;
+
+    /**
+     * @brief Advance the motor by a time step, starting at the current
+     * simulated time, and update the encoder. Long steps are divided into
+     * substeps of at most 100 us. The simulated time is set to the edges while
+     * their interrupts run and restored afterwards, advancing it is up to the
+     * caller.
+     *
+     * @param dt The time step in s.
+     */
+    void step(const double dt);
+
+    /**
+     * @brief Get the angular velocity of the shaft.
+     *
+     * @return double The velocity in rad/s.
+     */
+    double get_velocity() const;
+
+    /**
+     * @brief Get the angle of the shaft.
+     *
+     * @return double The angle in rad.
+     */
+    double get_angle() const;
+
+    /**
+     * @brief Get the last control value.
+     *
+     * @return double The control value between -1 and 1.
+     */
+    double get_control_value() const;
+
+    /**
+     * @brief Get the parameters of the motor.
+     *
+     * @return DCMotorParameters& The parameters, may be changed between steps.
+     */
+    DCMotorParameters& get_parameters();
+
+private:
+    const uint8_t encoder_pin_A_;
+    const uint8_t encoder_pin_B_;
+    const double counts_per_radian_;
+    const bool reverse_;
+    DCMotorParameters parameters_;
+
+    double control_value_ = 0;
+    double velocity_ = 0; // in rad/s
+    double angle_ = 0;    // in rad
+    int64_t count_ = 0;
+};
+
+#endif // DC_MOTOR_PLANT_H
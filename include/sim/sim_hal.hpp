@@ -0,0 +1,122 @@
+/**
+ * @file sim_hal.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Control of the simulated hardware of the native environments.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include <stdint.h>
+
+/**
+ * @brief The SimHal class holds the state behind the host shims of Arduino.h
+ * and ESP32Encoder.h.
+ *
+ * micros() and millis() return the simulated time, which only moves with
+ * set_time(), advance_time() and delay(). This keeps simulations deterministic
+ * and independent of the speed of the host. digitalRead() returns the levels
+ * set with set_pin_level(), interrupts attached with attachInterruptArg() are
+ * called by trigger_interrupt().
+ */
+class SimHal
+{
+public:
+    static constexpr uint8_t PIN_COUNT = 40;
+
+    /**
+     * @brief Get the simulated time.
+     *
+     * @return uint64_t The time since the start in microseconds.
+     */
+    static uint64_t get_time_us();
+
+    /**
+     * @brief Set the simulated time, e.g. to the time of an edge.
+     *
+     * @param time_us The time since the start in microseconds.
+     */
+    static void set_time(const uint64_t time_us);
+
+    /**
+     * @brief Advance the simulated time.
+     *
+     * @param duration_us The duration in microseconds.
+     */
+    static void advance_time(const uint64_t duration_us);
+
+    /**
+     * @brief Set the count of the encoder attached to a pin.
+     *
+     * @param pin_A The A pin of the encoder.
+     * @param count The absolute count.
+     */
+    static void set_encoder_count(const uint8_t pin_A, const int64_t count);
+
+    /**
+     * @brief Get the count of the encoder attached to a pin.
+     *
+     * @param pin_A The A pin of the encoder.
+     * @return int64_t The absolute count, 0 for invalid pins.
+     */
+    static int64_t get_encoder_count(const uint8_t pin_A);
+
+    /**
+     * @brief Set the level digitalRead() returns for a pin.
+     *
+     * @param pin The pin.
+     * @param level LOW or HIGH.
+     */
+    static void set_pin_level(const uint8_t pin, const int level);
+
+    /**
+     * @brief Get the level of a pin.
+     *
+     * @param pin The pin.
+     * @return int The level, LOW for invalid pins.
+     */
+    static int get_pin_level(const uint8_t pin);
+
+    /**
+     * @brief Attach an interrupt handler to a pin.
+     *
+     * @param pin The pin.
+     * @param handler The handler, nullptr to detach.
+     * @param argument The argument of the handler.
+     */
+    static void attach_interrupt(const uint8_t pin, void (*handler)(void*),
+                                 void* argument);
+
+    /**
+     * @brief Call the interrupt handler of a pin, if one is attached.
+     *
+     * @param pin The pin.
+     */
+    static void trigger_interrupt(const uint8_t pin);
+
+    /**
+     * @brief Reset the time, all encoder counts and pin levels to 0 and detach
+     * all interrupts.
+     *
+     */
+    static void reset();
+
+private:
+    struct Interrupt
+    {
+        void (*handler)(void*);
+        void* argument;
+    };
+
+    static uint64_t time_us_;
+    static int64_t encoder_counts_[PIN_COUNT];
+    static int pin_levels_[PIN_COUNT];
+    static Interrupt interrupts_[PIN_COUNT];
+};
+
+#endif // SIM_HAL_H
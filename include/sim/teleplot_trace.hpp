@@ -0,0 +1,59 @@
+/**
+ * @file teleplot_trace.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Reader of the CSV files exported by Teleplot.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TELEPLOT_TRACE_H
+#define TELEPLOT_TRACE_H
+
+#include <vector>
+
+#include "utils/scalar.h"
+
+/**
+ * @brief A value of a Teleplot series.
+ *
+ */
+struct TimedValue
+{
+    double time = 0; // in s since the first row of the file
+    scalar_t value = 0;
+};
+
+/**
+ * @brief The setpoint and measured series of a Teleplot recording, e.g.
+ * res/teleplot_2023-10-5_17-37.csv.
+ *
+ */
+struct TeleplotTrace
+{
+    std::vector<TimedValue> setpoints;
+    std::vector<TimedValue> measurements;
+
+    /**
+     * @brief Get the duration of the recording.
+     *
+     * @return double The time of the last value in s.
+     */
+    double get_duration() const;
+};
+
+/**
+ * @brief Read the columns named "setpoint" and "measured" of a Teleplot CSV
+ * export. Every row holds the time and the values of the series sampled at
+ * that time, the other columns are empty.
+ *
+ * @param path The path of the CSV file.
+ * @param trace Set to the series.
+ * @return true If the file was read and has a setpoint column.
+ * @return false If the file could not be opened or has no setpoint column.
+ */
+bool load_teleplot_trace(const char* path, TeleplotTrace& trace);
+
+#endif // TELEPLOT_TRACE_H
@@ -0,0 +1,60 @@
+/**
+ * @file autotune_storage.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Persistence of autotune results in the NVS.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef AUTOTUNE_STORAGE_H
+#define AUTOTUNE_STORAGE_H
+
+#include <stdint.h>
+
+#include "motor-control/autotune.hpp"
+
+/**
+ * @brief The AutotuneStorage class keeps one AutotuneResult per motor in the
+ * NVS of the ESP32, so the identified gains survive a reboot.
+ *
+ * Each result is stored as a blob with a version and its size. Blobs of
+ * another version or scalar precision are ignored on load, the motor then
+ * falls back to the compiled gains.
+ *
+ * @note Flash access blocks and must not be done from the control task.
+ */
+class AutotuneStorage
+{
+public:
+    static constexpr uint16_t VERSION = 1;
+
+    /**
+     * @brief Store the result of a motor.
+     *
+     * @param motor_index The index of the motor.
+     * @param result The result.
+     * @return true If the result was written.
+     */
+    static bool save(const uint8_t motor_index, const AutotuneResult& result);
+
+    /**
+     * @brief Load the result of a motor.
+     *
+     * @param motor_index The index of the motor.
+     * @param result Set to the stored result.
+     * @return true If a valid result was stored.
+     */
+    static bool load(const uint8_t motor_index, AutotuneResult& result);
+
+    /**
+     * @brief Delete the results of all motors.
+     *
+     * @return true If the results were deleted.
+     */
+    static bool clear();
+};
+
+#endif // AUTOTUNE_STORAGE_H
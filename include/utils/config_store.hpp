@@ -0,0 +1,145 @@
+/**
+ * @file config_store.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Persistence of the robot configuration in the NVS.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "utils/control_limits.hpp"
+#include "utils/gain_schedule.hpp"
+#include "utils/scalar.h"
+
+/**
+ * @brief Wiring and stiction of a motor. Applied on boot.
+ *
+ */
+struct MotorConfig
+{
+    uint8_t pin_in1 = 0;
+    uint8_t pin_in2 = 0;
+    uint8_t pin_ena = 0;
+    uint8_t pwm_channel = 0;
+    uint8_t encoder_a = 0;
+    uint8_t encoder_b = 0;
+    uint16_t encoder_resolution = 1; // Pulses per revolution
+    scalar_t min_output = 0;         // Output below which the motor stalls
+};
+
+/**
+ * @brief Everything that used to require a rebuild with a changed
+ * conf_hardware.h. The hardware part (motors, PWM and geometry) is applied on
+ * boot, the gain schedule and the limits also while running.
+ *
+ * @tparam WheelCount The number of wheels.
+ */
+template <int WheelCount>
+struct RobotConfig
+{
+    MotorConfig motors[WheelCount];
+    uint32_t pwm_frequency = 5000; // in Hz
+    uint8_t pwm_resolution = 8;    // in bits
+    scalar_t wheel_radius = 0;     // in m
+    scalar_t wheel_base = 0;       // Distance of the axles in m
+    scalar_t track_width = 0;      // Distance of the wheels on an axle in m
+
+    GainSchedule gain_schedule;
+    ControlLimits limits;
+};
+
+/**
+ * @brief The ConfigStore class keeps a RobotConfig in the NVS of the ESP32.
+ *
+ * The configuration is stored as a single blob with a version and its size,
+ * the NVS writes it atomically and checks it with a CRC. Blobs of another
+ * version, scalar precision or wheel count are ignored on load, the robot then
+ * boots with the compiled defaults. Bump VERSION whenever the layout of
+ * RobotConfig changes.
+ *
+ * @note Flash access blocks and must not be done from the control task. The
+ * configuration is loaded once in setup(), the control task only receives
+ * copies through its buffers.
+ */
+class ConfigStore
+{
+public:
+    static constexpr uint16_t VERSION = 1;
+
+    /**
+     * @brief Store a configuration, replacing the stored one.
+     *
+     * @param config The configuration.
+     * @return true If the configuration was written.
+     */
+    template <int WheelCount>
+    static bool save(const RobotConfig<WheelCount>& config);
+
+    /**
+     * @brief Load the stored configuration.
+     *
+     * @param config Set to the stored configuration, left untouched if there
+     * is none.
+     * @return true If a valid configuration was stored.
+     */
+    template <int WheelCount>
+    static bool load(RobotConfig<WheelCount>& config);
+
+    /**
+     * @brief Delete the stored configuration, the next boot uses the compiled
+     * defaults.
+     *
+     * @return true If the configuration was deleted.
+     */
+    static bool clear();
+
+private:
+    /**
+     * @brief Layout of the stored configuration.
+     */
+    template <int WheelCount>
+    struct StoredConfig
+    {
+        uint16_t version;
+        uint16_t size; // Differs between precisions and wheel counts
+        RobotConfig<WheelCount> config;
+    };
+
+    static bool write(const void* data, const size_t size);
+    static bool read(void* data, const size_t size);
+};
+
+// Template definitions
+
+template <int WheelCount>
+bool ConfigStore::save(const RobotConfig<WheelCount>& config)
+{
+    StoredConfig<WheelCount> stored;
+    stored.version = VERSION;
+    stored.size = uint16_t(sizeof(stored));
+    stored.config = config;
+    return write(&stored, sizeof(stored));
+}
+
+template <int WheelCount>
+bool ConfigStore::load(RobotConfig<WheelCount>& config)
+{
+    StoredConfig<WheelCount> stored;
+    if (!read(&stored, sizeof(stored)) || stored.version != VERSION ||
+        stored.size != sizeof(stored))
+    {
+        return false;
+    }
+    config = stored.config;
+    return true;
+}
+
+#endif // CONFIG_STORE_H
@@ -0,0 +1,66 @@
+/**
+ * @file control_limits.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Limits of the control loop, shared by the control task and the
+ * stored configuration.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONTROL_LIMITS_H
+#define CONTROL_LIMITS_H
+
+#include <stdint.h>
+
+#include "utils/scalar.h"
+
+/**
+ * @brief How a command is reduced if a wheel would exceed its speed limit.
+ *
+ * NONE: The wheel velocities are passed on unchanged, the motor drivers clip
+ * each wheel separately.
+ * UNIFORM: All wheel velocities are scaled by the same factor, the direction
+ * and curvature of the commanded twist are kept.
+ * PRIORITIZE_ROTATION: The yaw rate is kept if possible, only the translation
+ * is scaled down.
+ * PRIORITIZE_TRANSLATION: The translation is kept if possible, only the yaw
+ * rate is scaled down.
+ *
+ * The prioritizing policies need linear kinematics, otherwise (e.g. swerve)
+ * UNIFORM is used.
+ */
+enum class SaturationPolicy : uint8_t
+{
+    NONE,
+    UNIFORM,
+    PRIORITIZE_ROTATION,
+    PRIORITIZE_TRANSLATION
+};
+
+/**
+ * @brief Limits of a SetpointGenerator. A limit of 0 disables it.
+ *
+ */
+struct SetpointLimits
+{
+    Vector3 max_acceleration = Vector3::Zero(); // m/s^2, m/s^2, rad/s^2
+    Vector3 max_jerk = Vector3::Zero();         // m/s^3, m/s^3, rad/s^3
+    uint32_t timeout_us = 0; // Without a new target, ramp to zero after it
+};
+
+/**
+ * @brief Limits of the control loop, handed over as a whole and applied at the
+ * start of a cycle, so a cycle never sees half of an update.
+ *
+ */
+struct ControlLimits
+{
+    SetpointLimits setpoint;      // Ramp of the commanded robot velocity
+    scalar_t max_wheel_speed = 0; // For all wheels in rad/s, 0 is unlimited
+    SaturationPolicy saturation_policy = SaturationPolicy::UNIFORM;
+};
+
+#endif // CONTROL_LIMITS_H
@@ -0,0 +1,55 @@
+/**
+ * @file control_tick.h
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Timing context of a control cycle.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONTROL_TICK_H
+#define CONTROL_TICK_H
+
+#include <stdint.h>
+
+#include "utils/scalar.h"
+
+/**
+ * @brief Timing of one control cycle. Created once per cycle by the control
+ * task and passed down to the motor controllers, encoders, PID controllers and
+ * filters, so all stages of a cycle use the same timestamp and sampling time.
+ *
+ */
+struct ControlTick
+{
+    unsigned long timestamp_us = 0; // Start of the cycle in microseconds
+    scalar_t dt = 0;                // Time since the previous cycle in s, > 0
+    uint32_t index = 0;             // Counts the cycles, starting at 0
+};
+
+/**
+ * @brief Advance a tick to the next control cycle.
+ *
+ * @param tick The tick of the previous cycle. A default constructed tick
+ * becomes the first cycle with index 0.
+ * @param timestamp_us The start of the new cycle in microseconds.
+ * @param nominal_dt The sampling time of the first cycle, also used if no time
+ * has passed since the previous cycle. Must be positive.
+ */
+inline void advance_tick(ControlTick& tick, const unsigned long timestamp_us,
+                         const scalar_t nominal_dt)
+{
+    const bool first = tick.dt <= 0;
+    const unsigned long elapsed = timestamp_us - tick.timestamp_us;
+    if (!first)
+    {
+        tick.index++;
+    }
+    tick.dt = first || elapsed == 0 ? nominal_dt
+                                    : scalar_t(elapsed) * scalar_t(1e-6);
+    tick.timestamp_us = timestamp_us;
+}
+
+#endif // CONTROL_TICK_H
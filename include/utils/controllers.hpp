@@ -17,13 +17,27 @@
 #include <Arduino.h>
 
 /**
- * @brief PID controller class.
- * TODO: add anti-windup, gain scheduling, and output max/min
+ * @brief Gains of a PID controller.
+ *
+ */
+struct PIDGains
+{
+    scalar_t kp = 0;
+    scalar_t ki = 0;
+    scalar_t kd = 0;
+};
+
+/**
+ * @brief PID controller class. The derivative term acts on the measurement
+ * instead of the error, so setpoint steps do not cause a derivative kick.
+ * TODO: add anti-windup and output max/min
  *
  */
 class PIDController
 {
 public:
+    static constexpr scalar_t DEFAULT_DERIVATIVE_CUTOFF_FREQUENCY = 10; // Hz
+
     /**
      * @brief Construct a new PIDController object
      *
@@ -31,18 +45,26 @@ public:
      * @param ki The integral gain.
      * @param kd The derivative gain.
      * @param max_expected_sampling_time The maximum expected sampling time.
+     * @param max_integral The limit of the integral.
+     * @param derivative_cutoff_frequency The cutoff frequency in Hz of the low
+     * pass filter on the derivative. It holds at any sampling time.
      */
-    PIDController(double kp, double ki, double kd,
-                  double max_expected_sampling_time, double max_integral);
+    PIDController(scalar_t kp, scalar_t ki, scalar_t kd,
+                  scalar_t max_expected_sampling_time, scalar_t max_integral,
+                  scalar_t derivative_cutoff_frequency =
+                      DEFAULT_DERIVATIVE_CUTOFF_FREQUENCY);
 
     /**
      * @brief Update the controller.
      *
      * @param setpoint The setpoint.
      * @param input The input value.
-     * @return double The output value.
+     * @param dt The sampling time of the control cycle in s, limited to the
+     * maximum expected sampling time. If it is not positive, only the
+     * proportional term is updated.
+     * @return scalar_t The output value.
      */
-    double update(double setpoint, double input);
+    scalar_t update(scalar_t setpoint, scalar_t input, scalar_t dt);
 
     /**
      * @brief Reset the controller.
@@ -53,83 +75,122 @@ public:
     /**
      * @brief Get the proportional gain.
      *
-     * @return double The proportional gain.
+     * @return scalar_t The proportional gain.
      */
-    double get_kp();
+    scalar_t get_kp();
 
     /**
      * @brief Get the integral gain.
      *
-     * @return double The integral gain.
+     * @return scalar_t The integral gain.
      */
-    double get_ki();
+    scalar_t get_ki();
 
     /**
      * @brief Get the derivative gain.
      *
-     * @return double The derivative gain.
+     * @return scalar_t The derivative gain.
      */
-    double get_kd();
+    scalar_t get_kd();
 
     /**
      * @brief Get the maximum expected sampling time.
      *
-     * @return double The maximum expected sampling time.
+     * @return scalar_t The maximum expected sampling time.
      */
-    double get_max_expected_sampling_time();
+    scalar_t get_max_expected_sampling_time();
 
     /**
      * @brief Get the maximum integral.
      * 
-     * @return double The maximum integral.
+     * @return scalar_t The maximum integral.
      */
-    double get_max_integral();
+    scalar_t get_max_integral();
 
     /**
      * @brief Set the proportional gain.
      *
      * @param kp The proportional gain.
      */
-    void set_kp(double kp);
+    void set_kp(scalar_t kp);
 
     /**
      * @brief Set the integral gain.
      *
      * @param ki The integral gain.
      */
-    void set_ki(double ki);
+    void set_ki(scalar_t ki);
 
     /**
      * @brief Set the derivative gain.
      *
      * @param kd The derivative gain.
      */
-    void set_kd(double kd);
+    void set_kd(scalar_t kd);
 
     /**
      * @brief Set the maximum expected sampling time.
      *
      * @param max_expected_sampling_time The maximum expected sampling time.
      */
-    void set_max_expected_sampling_time(double max_expected_sampling_time);
+    void set_max_expected_sampling_time(scalar_t max_expected_sampling_time);
 
     /**
      * @brief Set the maximum integral.
      * 
      * @param max_integral The maximum integral.
      */
-    void set_max_integral(double max_integral);
+    void set_max_integral(scalar_t max_integral);
+
+    /**
+     * @brief Get all gains.
+     *
+     * @return PIDGains The proportional, integral and derivative gain.
+     */
+    PIDGains get_gains() const;
+
+    /**
+     * @brief Set all gains with bumpless transfer. The accumulated integral is
+     * rescaled to the new integral gain, so the integral term and thereby the
+     * output do not jump when the gains change.
+     *
+     * @param gains The proportional, integral and derivative gain.
+     */
+    void set_gains(const PIDGains& gains);
+
+    /**
+     * @brief Get the proportional term of the last update.
+     *
+     * @return scalar_t The proportional part of the output.
+     */
+    scalar_t get_p_term() const;
+
+    /**
+     * @brief Get the integral term of the last update.
+     *
+     * @return scalar_t The integral part of the output.
+     */
+    scalar_t get_i_term() const;
+
+    /**
+     * @brief Get the derivative term of the last update.
+     *
+     * @return scalar_t The derivative part of the output.
+     */
+    scalar_t get_d_term() const;
 
 private:
-    double kp_;
-    double ki_;
-    double kd_;
-    double max_expected_sampling_time_;
-    double max_integral_;
-    double integral_;
-    double previous_error_;
+    scalar_t kp_;
+    scalar_t ki_;
+    scalar_t kd_;
+    scalar_t max_expected_sampling_time_;
+    scalar_t max_integral_;
+    scalar_t integral_;
+    scalar_t previous_input_;
     LowPassFilter derivative_filter_;
-    unsigned long last_update_time_;
+    scalar_t p_term_ = 0;
+    scalar_t i_term_ = 0;
+    scalar_t d_term_ = 0;
 };
 
 #endif // CONTROLLERS_H
\ No newline at end of file
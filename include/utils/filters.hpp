@@ -13,8 +13,11 @@
 #define FILTERS_H
 
 #include "utils/constants.h"
+#include "utils/scalar.h"
 #include <algorithm>
-#include <deque>
+#include <stdint.h>
+#include <tuple>
+#include <type_traits>
 
 /**
  * @brief Abstract base class for filters.
@@ -27,15 +30,134 @@ public:
      * @brief Update the filter.
      *
      * @param input The input value.
-     * @return float The filtered value.
+     * @return scalar_t The filtered value.
      */
-    virtual float update(float input) = 0;
+    virtual scalar_t update(scalar_t input) = 0;
+
+    /**
+     * @brief Update the filter with the sampling time of the control cycle.
+     * Filters which depend on the sampling time adapt to it, the others
+     * ignore it.
+     *
+     * @param input The input value.
+     * @param dt The time since the previous update in s.
+     * @return scalar_t The filtered value.
+     */
+    virtual scalar_t update(scalar_t input, scalar_t dt)
+    {
+        return update(input);
+    }
 };
 
-class NoFilter : public Filter
+/**
+ * @brief Chain of filters composed at compile time.
+ *
+ * The input is passed through the filters from left to right. Since the
+ * concrete filter types are known (and final), the calls are resolved
+ * statically and can be inlined, so a chain costs no more than calling the
+ * filters directly. An empty chain passes the input through unchanged.
+ *
+ * @note A chain is a Filter itself, so it can also be used where a runtime
+ * polymorphic filter is expected.
+ *
+ * @tparam Filters The filter types, applied from left to right.
+ */
+template <typename... Filters>
+class FilterChain final : public Filter
 {
+    // True for an empty pack or a single FilterChain, which must not be taken
+    // by the forwarding constructor instead of the default or copy constructor
+    template <typename... Args>
+    struct is_chain : std::integral_constant<bool, sizeof...(Args) == 0>
+    {
+    };
+    template <typename Arg>
+    struct is_chain<Arg> : std::is_same<std::decay_t<Arg>, FilterChain>
+    {
+    };
+
 public:
-    float update(float input) { return input; }
+    /**
+     * @brief Construct a new Filter Chain object with default constructed
+     * filters.
+     *
+     */
+    FilterChain() = default;
+
+    /**
+     * @brief Construct a new Filter Chain object from the given filters.
+     *
+     * @param filters The filters, one per type in Filters.
+     */
+    template <typename... Args, typename = std::enable_if_t<
+                                    sizeof...(Args) == sizeof...(Filters) &&
+                                    !is_chain<Args...>::value>>
+    FilterChain(Args&&... filters) : filters_(std::forward<Args>(filters)...)
+    {
+    }
+
+    /**
+     * @brief Update all filters of the chain.
+     *
+     * @param input The input value.
+     * @return scalar_t The output of the last filter.
+     */
+    scalar_t update(scalar_t input) override { return apply<0>(input); }
+
+    /**
+     * @brief Update all filters of the chain with the sampling time of the
+     * control cycle.
+     *
+     * @param input The input value.
+     * @param dt The time since the previous update in s.
+     * @return scalar_t The output of the last filter.
+     */
+    scalar_t update(scalar_t input, scalar_t dt) override
+    {
+        return apply<0>(input, dt);
+    }
+
+    /**
+     * @brief Get a filter of the chain, e.g. to change its parameters.
+     *
+     * @tparam Index The position of the filter in the chain.
+     * @return auto& The filter.
+     */
+    template <size_t Index>
+    auto& get()
+    {
+        return std::get<Index>(filters_);
+    }
+
+private:
+    template <size_t Index>
+    scalar_t apply(scalar_t input)
+    {
+        if constexpr (Index == sizeof...(Filters))
+        {
+            return input;
+        }
+        else
+        {
+            return apply<Index + 1>(std::get<Index>(filters_).update(input));
+        }
+    }
+
+    template <size_t Index>
+    scalar_t apply(scalar_t input, scalar_t dt)
+    {
+        if constexpr (Index == sizeof...(Filters))
+        {
+            return input;
+        }
+        else
+        {
+            return apply<Index + 1>(
+                std::get<Index>(filters_).update(input, dt), dt);
+        }
+    }
+
+    std::tuple<Filters...> filters_;
 };
 
 /**
@@ -43,7 +165,7 @@ public:
  *
  */
 
-class LowPassFilter : public Filter
+class LowPassFilter final : public Filter
 {
 public:
     /**
@@ -52,15 +174,26 @@ public:
      * @param cutoff_frequency The cutoff frequency of the filter.
      * @param sampling_time The sampling time of the filter.
      */
-    LowPassFilter(float cutoff_frequency, float sampling_time);
+    LowPassFilter(scalar_t cutoff_frequency, scalar_t sampling_time);
 
     /**
-     * @brief Update the filter.
+     * @brief Update the filter with the sampling time given at construction.
      *
      * @param input The input value.
-     * @return float The filtered value.
+     * @return scalar_t The filtered value.
      */
-    float update(float input);
+    scalar_t update(scalar_t input) override;
+
+    /**
+     * @brief Update the filter with the sampling time of the control cycle.
+     * The smoothing factor is recomputed whenever the sampling time changes,
+     * so the cutoff frequency holds under jitter.
+     *
+     * @param input The input value.
+     * @param dt The time since the previous update in s.
+     * @return scalar_t The filtered value.
+     */
+    scalar_t update(scalar_t input, scalar_t dt) override;
 
     /**
      * @brief Reset the filter.
@@ -71,92 +204,137 @@ public:
     /**
      * @brief Get the cutoff frequency.
      *
-     * @return float The cutoff frequency.
+     * @return scalar_t The cutoff frequency.
      */
-    float get_cutoff_frequency();
+    scalar_t get_cutoff_frequency();
 
     /**
      * @brief Get the sampling time.
      *
-     * @return float The sampling time.
+     * @return scalar_t The sampling time.
      */
-    float get_sampling_time();
+    scalar_t get_sampling_time();
 
     /**
      * @brief Set the cutoff frequency.
      *
      * @param cutoff_frequency The cutoff frequency.
      */
-    void set_cutoff_frequency(float cutoff_frequency);
+    void set_cutoff_frequency(scalar_t cutoff_frequency);
 
     /**
      * @brief Set the sampling time.
      *
      * @param sampling_time The sampling time.
      */
-    void set_sampling_time(float sampling_time);
+    void set_sampling_time(scalar_t sampling_time);
 
 private:
-    float cutoff_frequency_;
-    float sampling_time_;
-    float alpha_;
-    float output_;
+    void update_alpha();
+
+    scalar_t cutoff_frequency_;
+    scalar_t sampling_time_;
+    scalar_t alpha_;
+    scalar_t output_ = 0;
 };
 
 /**
  * @brief Implementation and definiton of moving average filter class.
  *
+ * The last WindowSize inputs are kept in a ring buffer together with their
+ * running sum, so an update costs O(1) independent of the window size. The
+ * sum is recomputed once per pass through the buffer to avoid accumulating
+ * rounding errors.
+ *
+ * @tparam WindowSize The size of the filter window.
  */
-class MovingAverageFilter : public Filter
+template <uint16_t WindowSize>
+class MovingAverageFilter final : public Filter
 {
 public:
+    static_assert(WindowSize > 0, "The window size must be positive");
+
+    using Filter::update;
+
     /**
-     * @brief Construct a new Moving Average Filter object
+     * @brief Update the filter.
      *
-     * @param window_size The size of the filter window.
+     * @param input The input value.
+     * @return scalar_t The filtered value.
      */
-    MovingAverageFilter(int window_size);
+    scalar_t update(scalar_t input);
 
     /**
-     * @brief Update the filter.
+     * @brief Reset the filter.
      *
-     * @param input The input value.
-     * @return float The filtered value.
      */
-    float update(float input);
+    void reset();
 
 private:
-    std::deque<float> input_history_;
-    int window_size_;
-    float output_;
+    scalar_t input_history_[WindowSize];
+    uint16_t head_ = 0; // Slot of the next input
+    uint16_t size_ = 0;
+    scalar_t sum_ = 0;
 };
 
 /**
  * @brief Implementation and definiton of median filter class.
  *
+ * The inputs of the window are kept in a ring buffer in temporal order and
+ * indexed by two heaps: a max heap with the lower and a min heap with the
+ * upper half of the values. The oldest input is replaced in place, so an
+ * update costs O(log n) and no memory is allocated.
+ *
+ * @tparam WindowSize The size of the filter window.
  */
-class MedianFilter : public Filter
+template <uint16_t WindowSize>
+class MedianFilter final : public Filter
 {
 public:
+    static_assert(WindowSize > 0, "The window size must be positive");
+
+    using Filter::update;
+
     /**
-     * @brief Construct a new Median Filter object
+     * @brief Update the filter.
      *
-     * @param window_size The size of the filter window.
+     * @param input The input value.
+     * @return scalar_t The filtered value.
      */
-    MedianFilter(int window_size);
+    scalar_t update(scalar_t input);
 
     /**
-     * @brief Update the filter.
+     * @brief Reset the filter.
      *
-     * @param input The input value.
-     * @return float The filtered value.
      */
-    float update(float input);
+    void reset();
 
 private:
-    std::deque<float> input_history_;
-    int window_size_;
-    float output_;
+    // One more than half the window, since a heap can briefly hold an extra
+    // slot before rebalancing
+    static constexpr uint16_t HEAP_CAPACITY = WindowSize / 2 + 1;
+
+    bool above(const uint16_t a, const uint16_t b, const bool max_heap) const;
+    void place(const bool low, const uint16_t position, const uint16_t slot);
+    void sift_up(const bool low, uint16_t position);
+    void sift_down(const bool low, uint16_t position);
+    void push(const bool low, const uint16_t slot);
+    uint16_t pop(const bool low);
+    void swap_tops();
+
+    scalar_t input_history_[WindowSize];
+    uint16_t head_ = 0; // Slot of the next input
+    uint16_t size_ = 0;
+
+    // Heaps of ring buffer slots, low is a max heap, high a min heap
+    uint16_t low_[HEAP_CAPACITY];
+    uint16_t high_[HEAP_CAPACITY];
+    uint16_t low_size_ = 0;
+    uint16_t high_size_ = 0;
+
+    // Heap and position of every slot
+    bool slot_in_low_[WindowSize];
+    uint16_t slot_position_[WindowSize];
 };
 
 /**
@@ -164,7 +342,7 @@ private:
  * class.
  *
  */
-class ExponentialMovingAverageFilter : public Filter
+class ExponentialMovingAverageFilter final : public Filter
 {
 public:
     /**
@@ -172,19 +350,229 @@ public:
      *
      * @param alpha The alpha value of the filter.
      */
-    ExponentialMovingAverageFilter(float alpha);
+    ExponentialMovingAverageFilter(scalar_t alpha);
+
+    using Filter::update;
 
     /**
      * @brief Update the filter.
      *
      * @param input The input value.
-     * @return float The filtered value.
+     * @return scalar_t The filtered value.
      */
-    float update(float input);
+    scalar_t update(scalar_t input);
 
 private:
-    float alpha_;
-    float output_;
+    scalar_t alpha_;
+    scalar_t output_ = 0;
 };
 
+// Inline and template definitions
+
+inline scalar_t LowPassFilter::update(scalar_t input)
+{
+    output_ = alpha_ * input + (scalar_t(1.0) - alpha_) * output_;
+    return output_;
+}
+
+inline scalar_t LowPassFilter::update(scalar_t input, scalar_t dt)
+{
+    if (dt != sampling_time_ && dt > 0)
+    {
+        sampling_time_ = dt;
+        update_alpha();
+    }
+    return update(input);
+}
+
+inline scalar_t ExponentialMovingAverageFilter::update(scalar_t input)
+{
+    output_ = alpha_ * input + (scalar_t(1.0) - alpha_) * output_;
+    return output_;
+}
+
+template <uint16_t WindowSize>
+scalar_t MovingAverageFilter<WindowSize>::update(scalar_t input)
+{
+    if (size_ == WindowSize)
+    {
+        sum_ -= input_history_[head_];
+    }
+    else
+    {
+        size_++;
+    }
+    input_history_[head_] = input;
+    sum_ += input;
+    head_ = (head_ + 1) % WindowSize;
+
+    if (head_ == 0)
+    {
+        sum_ = 0;
+        for (uint16_t i = 0; i < WindowSize; i++)
+        {
+            sum_ += input_history_[i];
+        }
+    }
+
+    return sum_ / scalar_t(size_);
+}
+
+template <uint16_t WindowSize>
+void MovingAverageFilter<WindowSize>::reset()
+{
+    head_ = 0;
+    size_ = 0;
+    sum_ = 0;
+}
+
+template <uint16_t WindowSize>
+scalar_t MedianFilter<WindowSize>::update(scalar_t input)
+{
+    const uint16_t slot = head_;
+    head_ = (head_ + 1) % WindowSize;
+    input_history_[slot] = input;
+
+    if (size_ < WindowSize)
+    {
+        // Window not full yet, insert the input and rebalance the heaps so
+        // that low holds the same number or one more value than high
+        size_++;
+        const bool to_low =
+            low_size_ == 0 || !(input > input_history_[low_[0]]);
+        push(to_low, slot);
+        if (low_size_ > high_size_ + 1)
+        {
+            push(false, pop(true));
+        }
+        else if (high_size_ > low_size_)
+        {
+            push(true, pop(false));
+        }
+    }
+    else
+    {
+        // The new input replaced the oldest one in place, restore the heap
+        // it belongs to and the ordering between both heaps
+        const bool low = slot_in_low_[slot];
+        sift_up(low, slot_position_[slot]);
+        sift_down(low, slot_position_[slot]);
+        if (high_size_ > 0 &&
+            input_history_[low_[0]] > input_history_[high_[0]])
+        {
+            swap_tops();
+        }
+    }
+
+    if (low_size_ > high_size_)
+    {
+        return input_history_[low_[0]];
+    }
+    return (input_history_[low_[0]] + input_history_[high_[0]]) /
+           scalar_t(2.0);
+}
+
+template <uint16_t WindowSize>
+void MedianFilter<WindowSize>::reset()
+{
+    head_ = 0;
+    size_ = 0;
+    low_size_ = 0;
+    high_size_ = 0;
+}
+
+template <uint16_t WindowSize>
+bool MedianFilter<WindowSize>::above(const uint16_t a, const uint16_t b,
+                                     const bool max_heap) const
+{
+    return max_heap ? input_history_[a] > input_history_[b]
+                    : input_history_[a] < input_history_[b];
+}
+
+template <uint16_t WindowSize>
+void MedianFilter<WindowSize>::place(const bool low, const uint16_t position,
+                                     const uint16_t slot)
+{
+    (low ? low_ : high_)[position] = slot;
+    slot_in_low_[slot] = low;
+    slot_position_[slot] = position;
+}
+
+template <uint16_t WindowSize>
+void MedianFilter<WindowSize>::sift_up(const bool low, uint16_t position)
+{
+    uint16_t* heap = low ? low_ : high_;
+    const uint16_t slot = heap[position];
+    while (position > 0)
+    {
+        const uint16_t parent = (position - 1) / 2;
+        if (!above(slot, heap[parent], low))
+        {
+            break;
+        }
+        place(low, position, heap[parent]);
+        position = parent;
+    }
+    place(low, position, slot);
+}
+
+template <uint16_t WindowSize>
+void MedianFilter<WindowSize>::sift_down(const bool low, uint16_t position)
+{
+    uint16_t* heap = low ? low_ : high_;
+    const uint16_t size = low ? low_size_ : high_size_;
+    const uint16_t slot = heap[position];
+    while (true)
+    {
+        uint16_t child = 2 * position + 1;
+        if (child >= size)
+        {
+            break;
+        }
+        if (child + 1 < size && above(heap[child + 1], heap[child], low))
+        {
+            child++;
+        }
+        if (!above(heap[child], slot, low))
+        {
+            break;
+        }
+        place(low, position, heap[child]);
+        position = child;
+    }
+    place(low, position, slot);
+}
+
+template <uint16_t WindowSize>
+void MedianFilter<WindowSize>::push(const bool low, const uint16_t slot)
+{
+    const uint16_t position = low ? low_size_++ : high_size_++;
+    place(low, position, slot);
+    sift_up(low, position);
+}
+
+template <uint16_t WindowSize>
+uint16_t MedianFilter<WindowSize>::pop(const bool low)
+{
+    uint16_t* heap = low ? low_ : high_;
+    const uint16_t top = heap[0];
+    const uint16_t size = low ? --low_size_ : --high_size_;
+    if (size > 0)
+    {
+        place(low, 0, heap[size]);
+        sift_down(low, 0);
+    }
+    return top;
+}
+
+template <uint16_t WindowSize>
+void MedianFilter<WindowSize>::swap_tops()
+{
+    const uint16_t low_top = low_[0];
+    place(true, 0, high_[0]);
+    place(false, 0, low_top);
+    sift_down(true, 0);
+    sift_down(false, 0);
+}
+
 #endif // FILTERS_H
\ No newline at end of file
@@ -0,0 +1,159 @@
+/**
+ * @file gain_schedule.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Interpolated lookup table of PID gains.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef GAIN_SCHEDULE_H
+#define GAIN_SCHEDULE_H
+
+#include <stdint.h>
+
+#include "utils/controllers.hpp"
+#include "utils/scalar.h"
+
+/**
+ * @brief The GainSchedule class maps the speed of a wheel and the magnitude of
+ * the commanded twist to PID gains.
+ *
+ * The gains are defined on a grid of BREAKPOINTS x BREAKPOINTS points and
+ * interpolated bilinearly in between, so they change smoothly with the
+ * operating point. Outside of the grid, the gains of the nearest edge are
+ * used. Both inputs are taken as absolute values.
+ *
+ * The twist magnitude combines the linear and the angular velocity into a
+ * speed: |(vx, vy)| + rotation_radius * |wz|.
+ */
+class GainSchedule
+{
+public:
+    static constexpr uint8_t BREAKPOINTS = 3;
+
+    /**
+     * @brief Construct a new Gain Schedule object with the same gains at every
+     * point.
+     *
+     * @param gains The gains.
+     * @param max_wheel_speed The last wheel speed breakpoint in rad/s, the
+     * breakpoints are spaced evenly from 0.
+     * @param max_twist_magnitude The last twist magnitude breakpoint in m/s.
+     * @param rotation_radius The radius converting the angular velocity into a
+     * speed in m.
+     */
+    GainSchedule(const PIDGains& gains = PIDGains(),
+                 const scalar_t max_wheel_speed = 1.0,
+                 const scalar_t max_twist_magnitude = 1.0,
+                 const scalar_t rotation_radius = 0.0);
+
+    /**
+     * @brief Get the gains at an operating point.
+     *
+     * @param wheel_speed The speed of the wheel in rad/s.
+     * @param twist_magnitude The twist magnitude in m/s.
+     * @return PIDGains The interpolated gains.
+     */
+    PIDGains evaluate(const scalar_t wheel_speed,
+                      const scalar_t twist_magnitude) const;
+
+    /**
+     * @brief Get the magnitude of a twist.
+     *
+     * @param twist The twist (vx, vy, wz).
+     * @return scalar_t The twist magnitude in m/s.
+     */
+    scalar_t get_twist_magnitude(const Vector3& twist) const;
+
+    /**
+     * @brief Check whether the breakpoints are strictly increasing and all
+     * gains are non-negative.
+     *
+     * @return true If the schedule can be evaluated.
+     */
+    bool is_valid() const;
+
+    /**
+     * @brief Get a wheel speed breakpoint.
+     *
+     * @param index The index of the breakpoint.
+     * @return scalar_t The wheel speed in rad/s.
+     */
+    scalar_t get_wheel_speed(const uint8_t index) const;
+
+    /**
+     * @brief Set a wheel speed breakpoint.
+     *
+     * @param index The index of the breakpoint.
+     * @param wheel_speed The wheel speed in rad/s.
+     */
+    void set_wheel_speed(const uint8_t index, const scalar_t wheel_speed);
+
+    /**
+     * @brief Get a twist magnitude breakpoint.
+     *
+     * @param index The index of the breakpoint.
+     * @return scalar_t The twist magnitude in m/s.
+     */
+    scalar_t get_twist_breakpoint(const uint8_t index) const;
+
+    /**
+     * @brief Set a twist magnitude breakpoint.
+     *
+     * @param index The index of the breakpoint.
+     * @param twist_magnitude The twist magnitude in m/s.
+     */
+    void set_twist_breakpoint(const uint8_t index,
+                              const scalar_t twist_magnitude);
+
+    /**
+     * @brief Get the gains at a grid point.
+     *
+     * @param wheel_speed_index The index of the wheel speed breakpoint.
+     * @param twist_index The index of the twist magnitude breakpoint.
+     * @return const PIDGains& The gains.
+     */
+    const PIDGains& get_gains(const uint8_t wheel_speed_index,
+                              const uint8_t twist_index) const;
+
+    /**
+     * @brief Set the gains at a grid point.
+     *
+     * @param wheel_speed_index The index of the wheel speed breakpoint.
+     * @param twist_index The index of the twist magnitude breakpoint.
+     * @param gains The gains.
+     */
+    void set_gains(const uint8_t wheel_speed_index, const uint8_t twist_index,
+                   const PIDGains& gains);
+
+    /**
+     * @brief Get the radius weighting the angular velocity in the twist
+     * magnitude.
+     *
+     * @return scalar_t The radius in m.
+     */
+    scalar_t get_rotation_radius() const;
+
+    /**
+     * @brief Set the radius weighting the angular velocity in the twist
+     * magnitude.
+     *
+     * @param rotation_radius The radius in m, e.g. the distance of the wheels
+     * from the center of rotation.
+     */
+    void set_rotation_radius(const scalar_t rotation_radius);
+
+private:
+    static uint8_t find_segment(const scalar_t* breakpoints,
+                                const scalar_t value, scalar_t& weight);
+
+    scalar_t wheel_speeds_[BREAKPOINTS];
+    scalar_t twist_breakpoints_[BREAKPOINTS];
+    PIDGains gains_[BREAKPOINTS][BREAKPOINTS]; // [wheel speed][twist]
+    scalar_t rotation_radius_;
+};
+
+#endif // GAIN_SCHEDULE_H
@@ -0,0 +1,56 @@
+/**
+ * @file heap_monitor.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Runtime check for heap allocations in real-time tasks.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+#include <stdint.h>
+
+/**
+ * @brief The HeapMonitor class counts the heap allocations made by one watched
+ * task and exposes the heap watermark of the system.
+ *
+ * malloc, calloc and realloc are wrapped at link time (see the -Wl,--wrap
+ * flags in platformio.ini). Since operator new and Eigen both allocate through
+ * malloc, every dynamic allocation of the watched task is counted.
+ */
+class HeapMonitor
+{
+public:
+    /**
+     * @brief Count all following allocations made by the calling task.
+     *
+     */
+    static void watch_current_task();
+
+    /**
+     * @brief Get the number of allocations made by the watched task.
+     *
+     * @return uint32_t The allocation count.
+     */
+    static uint32_t get_allocation_count();
+
+    /**
+     * @brief Get the free heap.
+     *
+     * @return uint32_t The free heap in bytes.
+     */
+    static uint32_t get_free_heap();
+
+    /**
+     * @brief Get the lowest free heap since boot.
+     *
+     * @return uint32_t The heap watermark in bytes.
+     */
+    static uint32_t get_free_heap_watermark();
+};
+
+#endif // HEAP_MONITOR_H
@@ -0,0 +1,155 @@
+/**
+ * @file instrumentation.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Lightweight latency measurement with the CPU cycle counter.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * @brief Access to the CPU cycle counter (CCOUNT).
+ *
+ * Reading the counter takes a single instruction. It wraps after 2^32 cycles
+ * (about 17 s at 240 MHz), so it must only be used for intervals shorter than
+ * that.
+ */
+class CycleCounter
+{
+public:
+    /**
+     * @brief Get the current value of the cycle counter.
+     *
+     * @return uint32_t The cycle count of the calling core.
+     */
+    static uint32_t now() { return ESP.getCycleCount(); }
+
+    /**
+     * @brief Convert a number of cycles to microseconds.
+     *
+     * @param cycles The number of cycles.
+     * @return uint32_t The duration in microseconds.
+     */
+    static uint32_t to_us(const uint32_t cycles);
+};
+
+/**
+ * @brief Summary of the values recorded by a LatencyHistogram.
+ *
+ */
+struct LatencySummary
+{
+    uint32_t count = 0;
+    uint32_t min_us = 0;
+    uint32_t max_us = 0;
+    uint32_t mean_us = 0;
+    uint32_t p99_us = 0; // Upper bound of the bucket holding the percentile
+};
+
+/**
+ * @brief Histogram of durations with fixed width buckets.
+ *
+ * Recording a value is constant time and does not allocate, so it can be used
+ * inside the control loop. Values beyond the last bucket are collected in an
+ * overflow bucket, their exact maximum is still tracked.
+ *
+ * @note Not thread safe, a histogram must only be used from a single task.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr uint8_t BUCKET_COUNT = 32;
+
+    /**
+     * @brief Construct a new Latency Histogram object.
+     *
+     * @param bucket_width_us The width of a bucket in microseconds. Values up
+     * to BUCKET_COUNT * bucket_width_us are resolved.
+     */
+    LatencyHistogram(const uint32_t bucket_width_us);
+
+    /**
+     * @brief Record a duration.
+     *
+     * @param duration_us The duration in microseconds.
+     */
+    void record(const uint32_t duration_us);
+
+    /**
+     * @brief Get the number of recorded durations.
+     *
+     * @return uint32_t The count since the last reset.
+     */
+    uint32_t get_count() const;
+
+    /**
+     * @brief Summarize the recorded durations.
+     *
+     * @return LatencySummary The min, max, mean and 99th percentile.
+     */
+    LatencySummary get_summary() const;
+
+    /**
+     * @brief Discard all recorded durations.
+     *
+     */
+    void reset();
+
+private:
+    const uint32_t bucket_width_us_;
+    uint32_t buckets_[BUCKET_COUNT + 1]; // Last bucket collects the overflow
+    uint32_t count_;
+    uint32_t min_us_;
+    uint32_t max_us_;
+    uint64_t sum_us_;
+};
+
+/**
+ * @brief Records the lifetime of the object into a histogram.
+ *
+ * @code
+ * {
+ *     ScopedTimer timer(spin_histogram);
+ *     rclc_executor_spin_some(&executor, timeout);
+ * }
+ * @endcode
+ */
+class ScopedTimer
+{
+public:
+    /**
+     * @brief Start the timer.
+     *
+     * @param histogram The histogram the duration is recorded in.
+     */
+    ScopedTimer(LatencyHistogram& histogram)
+        : histogram_(histogram), start_(CycleCounter::now())
+    {
+    }
+
+    /**
+     * @brief Stop the timer and record the duration.
+     *
+     */
+    ~ScopedTimer()
+    {
+        histogram_.record(CycleCounter::to_us(CycleCounter::now() - start_));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    LatencyHistogram& histogram_;
+    const uint32_t start_;
+};
+
+#endif // INSTRUMENTATION_H
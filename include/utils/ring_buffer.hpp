@@ -0,0 +1,94 @@
+/**
+ * @file ring_buffer.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Wait-free single-producer/single-consumer ring buffer.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @brief Queue of a fixed number of values of T, handed from one task to
+ * another without locks.
+ *
+ * Unlike TripleBuffer, every pushed value is delivered exactly once. If the
+ * consumer falls behind and the queue is full, new values are dropped and
+ * counted, the producer never blocks.
+ *
+ * @note Only one task may call push() and only one task may call pop().
+ *
+ * @tparam T The type of the queued values. Must be copy assignable.
+ * @tparam Capacity The maximum number of queued values. Must be a power of two.
+ */
+template <typename T, uint16_t Capacity>
+class RingBuffer
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+public:
+    /**
+     * @brief Append a value. Called by the producer only.
+     *
+     * @param value The value to append.
+     * @return true If the value was queued.
+     * @return false If the queue was full and the value was dropped.
+     */
+    bool push(const T& value)
+    {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= Capacity)
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        buffers_[head & (Capacity - 1)] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest value. Called by the consumer only.
+     *
+     * @param value Set to the oldest value.
+     * @return true If a value was removed.
+     * @return false If the queue was empty.
+     */
+    bool pop(T& value)
+    {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        value = buffers_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get the number of values dropped because the queue was full.
+     *
+     * @return uint32_t The drop count since construction.
+     */
+    uint32_t get_drop_count() const
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    T buffers_[Capacity];
+    std::atomic<uint32_t> head_{0}; // Count of pushed values
+    std::atomic<uint32_t> tail_{0}; // Count of popped values
+    std::atomic<uint32_t> dropped_{0};
+};
+
+#endif // RING_BUFFER_H
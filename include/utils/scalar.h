@@ -0,0 +1,34 @@
+/**
+ * @file scalar.h
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Definition of the scalar type used in the control path.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SCALAR_H
+#define SCALAR_H
+
+#include <ArduinoEigen.h>
+
+/**
+ * @brief Floating point type of the control path (encoders, filters, PID,
+ * kinematics and odometry).
+ *
+ * The ESP32 FPU only supports single precision, double precision math is
+ * emulated in software. Build with -DUSE_SINGLE_PRECISION to compile the
+ * control path with float.
+ */
+#ifdef USE_SINGLE_PRECISION
+typedef float scalar_t;
+#else
+typedef double scalar_t;
+#endif
+
+typedef Eigen::Matrix<scalar_t, 3, 1> Vector3;
+typedef Eigen::Matrix<scalar_t, 3, 3> Matrix3;
+
+#endif // SCALAR_H
@@ -0,0 +1,113 @@
+/**
+ * @file setpoint_generator.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Acceleration and jerk limited velocity setpoints with a command
+ * timeout.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SETPOINT_GENERATOR_H
+#define SETPOINT_GENERATOR_H
+
+#include "utils/control_limits.hpp"
+#include "utils/control_tick.h"
+#include "utils/scalar.h"
+
+/**
+ * @brief The SetpointGenerator class moves the velocity setpoint towards the
+ * latest target at the control rate, within an acceleration and a jerk limit
+ * per axis (vx, vy, wz).
+ *
+ * Between two commands of e.g. 20 Hz, the setpoint thereby ramps smoothly
+ * instead of jumping once per message. The acceleration is reduced early
+ * enough to reach the target without overshoot: with the jerk limit j, an
+ * acceleration a needs a velocity change of a^2 / (2 j) to return to zero, so
+ * the acceleration towards a remaining difference e is limited to
+ * sqrt(2 j |e|).
+ *
+ * If no new target was set within the timeout, the target becomes zero and
+ * the robot stops within the same limits.
+ */
+class SetpointGenerator
+{
+public:
+    /**
+     * @brief Construct a new Setpoint Generator object at standstill.
+     *
+     * @param limits The limits.
+     */
+    SetpointGenerator(const SetpointLimits& limits = SetpointLimits());
+
+    /**
+     * @brief Set a new target velocity.
+     *
+     * @param target The target velocity (vx, vy, wz).
+     * @param timestamp_us The time the target was received in microseconds,
+     * starts the timeout.
+     */
+    void set_target(const Vector3& target, const unsigned long timestamp_us);
+
+    /**
+     * @brief Advance the setpoint by one control cycle.
+     *
+     * @param tick The control cycle.
+     * @return const Vector3& The new setpoint.
+     */
+    const Vector3& update(const ControlTick& tick);
+
+    /**
+     * @brief Get the setpoint of the last update.
+     *
+     * @return const Vector3& The setpoint (vx, vy, wz).
+     */
+    const Vector3& get_velocity() const;
+
+    /**
+     * @brief Get the acceleration of the last update.
+     *
+     * @return const Vector3& The acceleration per axis.
+     */
+    const Vector3& get_acceleration() const;
+
+    /**
+     * @brief Check whether the last target timed out.
+     *
+     * @return true If the setpoint ramps to zero because of the timeout.
+     */
+    bool is_timed_out() const;
+
+    /**
+     * @brief Set the limits.
+     *
+     * @param limits The limits.
+     */
+    void set_limits(const SetpointLimits& limits);
+
+    /**
+     * @brief Get the limits.
+     *
+     * @return const SetpointLimits& The limits.
+     */
+    const SetpointLimits& get_limits() const;
+
+    /**
+     * @brief Stop immediately, without the limits.
+     *
+     */
+    void reset();
+
+private:
+    SetpointLimits limits_;
+    Vector3 target_ = Vector3::Zero();
+    Vector3 velocity_ = Vector3::Zero();
+    Vector3 acceleration_ = Vector3::Zero();
+    unsigned long target_time_us_ = 0;
+    bool has_target_ = false;
+    bool timed_out_ = false;
+};
+
+#endif // SETPOINT_GENERATOR_H
@@ -0,0 +1,242 @@
+/**
+ * @file trace_buffer.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Lock-free trace buffer with trigger for full rate recordings.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRACE_BUFFER_H
+#define TRACE_BUFFER_H
+
+#include <atomic>
+#include <esp_heap_caps.h>
+#include <stdint.h>
+
+/**
+ * @brief Per-tick record of the control loop.
+ *
+ * @tparam WheelCount The number of wheels.
+ */
+template <int WheelCount>
+struct TraceRecord
+{
+    uint32_t timestamp_us;
+    float setpoint[WheelCount];
+    float measured[WheelCount];
+    float output[WheelCount];
+    float integral[WheelCount]; // Integral term of the PID controller
+};
+
+/**
+ * @brief The TraceBuffer class records the latest values of T like a data
+ * logger with a trigger.
+ *
+ * The producer continuously overwrites the oldest record. Once trigger() was
+ * called, post_trigger further records are written and the buffer freezes, so
+ * it holds the history before and after the trigger. The consumer then reads
+ * the frozen records at its own pace and calls rearm() to start recording
+ * again. The producer never blocks and never waits for the consumer.
+ *
+ * @note Only one task may call write() and only one task may read. trigger()
+ * may be called from both.
+ *
+ * @tparam T The type of the records. Must be copy assignable.
+ */
+template <typename T>
+class TraceBuffer
+{
+public:
+    /**
+     * @brief Allocate the storage, preferably in PSRAM.
+     *
+     * @param capacity The number of records. Must be a power of two.
+     * @param post_trigger The number of records written after the trigger.
+     * @return true If the storage was allocated.
+     * @return false If the capacity is invalid or the allocation failed.
+     *
+     * @note Must be called before the producer starts.
+     */
+    bool allocate(const uint16_t capacity, const uint16_t post_trigger);
+
+    /**
+     * @brief Check whether the storage was allocated.
+     *
+     * @return true If records can be written.
+     */
+    bool is_allocated() const;
+
+    /**
+     * @brief Write a record. Called by the producer only.
+     *
+     * @param record The record.
+     */
+    void write(const T& record);
+
+    /**
+     * @brief Request a trigger. Ignored while a trigger is pending.
+     *
+     */
+    void trigger();
+
+    /**
+     * @brief Check whether the buffer is frozen and can be read.
+     *
+     * @return true If the recording after the trigger is complete.
+     */
+    bool is_frozen() const;
+
+    /**
+     * @brief Get the number of frozen records.
+     *
+     * @return uint16_t The number of records, at most the capacity.
+     */
+    uint16_t get_size() const;
+
+    /**
+     * @brief Get the index of the record written when the trigger occurred.
+     *
+     * @return uint16_t The index, counted from the oldest record.
+     */
+    uint16_t get_trigger_index() const;
+
+    /**
+     * @brief Get a frozen record.
+     *
+     * @param index The index of the record, 0 is the oldest.
+     * @return const T& The record.
+     */
+    const T& get(const uint16_t index) const;
+
+    /**
+     * @brief Discard the frozen records and start recording again.
+     *
+     */
+    void rearm();
+
+private:
+    enum State : uint8_t
+    {
+        RECORDING,
+        TRIGGERED,
+        FROZEN,
+    };
+
+    T* records_ = nullptr;
+    uint16_t capacity_ = 0;
+    uint16_t post_trigger_ = 0;
+    // Owned by the producer, read by the consumer once frozen
+    uint32_t head_ = 0; // Count of written records
+    uint32_t trigger_head_ = 0;
+    std::atomic<uint8_t> state_{RECORDING};
+    std::atomic<bool> trigger_requested_{false};
+};
+
+// Template definitions
+
+template <typename T>
+bool TraceBuffer<T>::allocate(const uint16_t capacity,
+                              const uint16_t post_trigger)
+{
+    if (records_ != nullptr || capacity == 0 ||
+        (capacity & (capacity - 1)) != 0)
+    {
+        return false;
+    }
+
+    const size_t size = sizeof(T) * capacity;
+    void* memory = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (memory == nullptr)
+    {
+        memory = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+    }
+    if (memory == nullptr)
+    {
+        return false;
+    }
+
+    records_ = static_cast<T*>(memory);
+    capacity_ = capacity;
+    post_trigger_ = post_trigger < capacity ? post_trigger : capacity - 1;
+    return true;
+}
+
+template <typename T>
+bool TraceBuffer<T>::is_allocated() const
+{
+    return records_ != nullptr;
+}
+
+template <typename T>
+void TraceBuffer<T>::write(const T& record)
+{
+    uint8_t state = state_.load(std::memory_order_acquire);
+    if (state == FROZEN || records_ == nullptr)
+    {
+        return;
+    }
+
+    if (state == RECORDING &&
+        trigger_requested_.exchange(false, std::memory_order_relaxed))
+    {
+        trigger_head_ = head_;
+        state = TRIGGERED;
+        state_.store(state, std::memory_order_relaxed);
+    }
+
+    records_[head_ & (capacity_ - 1)] = record;
+    head_++;
+
+    if (state == TRIGGERED && head_ - trigger_head_ > post_trigger_)
+    {
+        // Publishes the records and head_ to the consumer
+        state_.store(FROZEN, std::memory_order_release);
+    }
+}
+
+template <typename T>
+void TraceBuffer<T>::trigger()
+{
+    if (state_.load(std::memory_order_relaxed) == RECORDING)
+    {
+        trigger_requested_.store(true, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool TraceBuffer<T>::is_frozen() const
+{
+    return state_.load(std::memory_order_acquire) == FROZEN;
+}
+
+template <typename T>
+uint16_t TraceBuffer<T>::get_size() const
+{
+    return head_ < capacity_ ? uint16_t(head_) : capacity_;
+}
+
+template <typename T>
+uint16_t TraceBuffer<T>::get_trigger_index() const
+{
+    return uint16_t(trigger_head_ - (head_ - get_size()));
+}
+
+template <typename T>
+const T& TraceBuffer<T>::get(const uint16_t index) const
+{
+    const uint32_t oldest = head_ - get_size();
+    return records_[(oldest + index) & (capacity_ - 1)];
+}
+
+template <typename T>
+void TraceBuffer<T>::rearm()
+{
+    trigger_requested_.store(false, std::memory_order_relaxed);
+    head_ = 0;
+    state_.store(RECORDING, std::memory_order_release);
+}
+
+#endif // TRACE_BUFFER_H
@@ -0,0 +1,122 @@
+/**
+ * @file tracking_metrics.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Tracking quality of a controlled signal following its setpoint.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRACKING_METRICS_H
+#define TRACKING_METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "utils/scalar.h"
+
+/**
+ * @brief Tracking quality over all recorded samples.
+ *
+ */
+struct TrackingResult
+{
+    uint32_t samples = 0;
+    scalar_t rmse = 0;               // Root mean square error
+    scalar_t max_error = 0;          // Largest absolute error
+    uint16_t steps = 0;              // Setpoint steps of at least min_step
+    scalar_t max_overshoot = 0;      // Beyond the setpoint, relative to step
+    scalar_t mean_settling_time = 0; // in s, of the settled steps
+    scalar_t max_settling_time = 0;  // in s, of the settled steps
+    uint16_t unsettled_steps = 0;    // Outside the band at the next step
+};
+
+/**
+ * @brief The TrackingMetrics class measures how well a signal follows its
+ * setpoint, e.g. a wheel speed in a recorded or replayed trace.
+ *
+ * A setpoint change of at least min_step starts a step. The overshoot of a
+ * step is the largest error beyond the new setpoint relative to the step
+ * size, its settling time the time after which the error stays within
+ * settling_band times the step size until the next step. The sums are
+ * accumulated in double, so the float and double builds can be compared.
+ */
+class TrackingMetrics
+{
+public:
+    /**
+     * @brief Construct a new Tracking Metrics object.
+     *
+     * @param min_step The smallest setpoint change counted as a step.
+     * @param settling_band The settling band relative to the step size.
+     */
+    TrackingMetrics(const scalar_t min_step = 1.0,
+                    const scalar_t settling_band = 0.05);
+
+    /**
+     * @brief Record a sample.
+     *
+     * @param setpoint The setpoint.
+     * @param measured The measured value.
+     * @param dt The time since the previous sample in s.
+     */
+    void record(const scalar_t setpoint, const scalar_t measured,
+                const scalar_t dt);
+
+    /**
+     * @brief Get the tracking quality of all samples so far, the current step
+     * included.
+     *
+     * @return TrackingResult The tracking quality.
+     */
+    TrackingResult get_result() const;
+
+    /**
+     * @brief Remove all samples.
+     *
+     */
+    void reset();
+
+private:
+    /**
+     * @brief Add the current step to the step statistics.
+     */
+    void finish_step();
+
+    const scalar_t min_step_;
+    const scalar_t settling_band_;
+
+    uint32_t samples_ = 0;
+    double squared_error_sum_ = 0;
+    scalar_t max_error_ = 0;
+    scalar_t previous_setpoint_ = 0;
+
+    bool in_step_ = false;
+    scalar_t step_size_ = 0;
+    scalar_t step_time_ = 0;    // Since the start of the current step
+    scalar_t last_outside_ = 0; // Step time of the last sample outside
+    bool inside_ = false;       // The last sample was inside the band
+    scalar_t step_overshoot_ = 0;
+
+    uint16_t steps_ = 0;
+    uint16_t settled_steps_ = 0;
+    double settling_time_sum_ = 0;
+    scalar_t max_settling_time_ = 0;
+    scalar_t max_overshoot_ = 0;
+};
+
+/**
+ * @brief Write a tracking result as a JSON object. Without a settled step, the
+ * settling times are null.
+ *
+ * @param result The tracking result.
+ * @param buffer The buffer, 256 characters fit any result.
+ * @param size The size of the buffer.
+ * @return int The length of the JSON object as returned by snprintf().
+ */
+int format_tracking_json(const TrackingResult& result, char* buffer,
+                         const size_t size);
+
+#endif // TRACKING_METRICS_H
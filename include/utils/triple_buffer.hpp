@@ -0,0 +1,117 @@
+/**
+ * @file triple_buffer.hpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Wait-free single-producer/single-consumer triple buffer.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @brief Triple buffer for handing the latest value of T from one task to
+ * another without locks.
+ *
+ * The producer always owns one slot, the consumer always owns one slot and the
+ * third slot is exchanged atomically between them. Neither side ever blocks or
+ * waits for the other, and the consumer always sees a complete value.
+ *
+ * @note Only one task may call write() and only one task may call read().
+ *
+ * @tparam T The type of the exchanged value. Must be copy assignable.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    /**
+     * @brief Construct a new Triple Buffer object with default constructed
+     * values.
+     *
+     */
+    TripleBuffer() : shared_(1), write_index_(0), read_index_(2) {}
+
+    /**
+     * @brief Construct a new Triple Buffer object with all slots set to the
+     * given value.
+     *
+     * @param initial_value The value returned by read() before the first
+     * write().
+     */
+    TripleBuffer(const T& initial_value)
+        : buffers_{initial_value, initial_value, initial_value}, shared_(1),
+          write_index_(0), read_index_(2)
+    {
+    }
+
+    /**
+     * @brief Publish a new value. Called by the producer only.
+     *
+     * @param value The value to publish.
+     */
+    void write(const T& value)
+    {
+        buffers_[write_index_] = value;
+        const uint32_t previous =
+            shared_.exchange(write_index_ | NEW_DATA, std::memory_order_acq_rel);
+        write_index_ = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Fetch the most recently published value. Called by the consumer
+     * only.
+     *
+     * @param value Set to the latest value.
+     * @return true If a value was published since the last call.
+     * @return false If no new value was published since the last call.
+     */
+    bool read(T& value)
+    {
+        const bool updated = swap_if_new();
+        value = buffers_[read_index_];
+        return updated;
+    }
+
+    /**
+     * @brief Fetch the most recently published value. Called by the consumer
+     * only.
+     *
+     * @return const T& The latest value. Stays valid until the next call to
+     * read().
+     */
+    const T& read()
+    {
+        swap_if_new();
+        return buffers_[read_index_];
+    }
+
+private:
+    static constexpr uint32_t INDEX_MASK = 0x3;
+    static constexpr uint32_t NEW_DATA = 0x4;
+
+    bool swap_if_new()
+    {
+        if ((shared_.load(std::memory_order_relaxed) & NEW_DATA) == 0)
+        {
+            return false;
+        }
+        const uint32_t previous =
+            shared_.exchange(read_index_, std::memory_order_acq_rel);
+        read_index_ = previous & INDEX_MASK;
+        return true;
+    }
+
+    T buffers_[3];
+    std::atomic<uint32_t> shared_; // Index of the exchanged slot | NEW_DATA
+    uint32_t write_index_;         // Owned by the producer
+    uint32_t read_index_;          // Owned by the consumer
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -7,18 +7,35 @@
 #endif
 
 #include <ArduinoEigen.h>
-#include <nav_msgs/msg/odometry.h>
 
 #include "kinematics/kinematics.hpp"
 #include "motor-control/motor_control_manager.hpp"
+#include "utils/control_limits.hpp"
 
 /**
  * @brief The VelocityController class manages the control of a robot's motors
  * and implements odometry calculations based on its kinematics model.
+ *
+ * If a command asks for more than a wheel can deliver, the wheel velocities are
+ * scaled down before they are handed to the motor controllers, according to
+ * the SaturationPolicy. Clipping single wheels would distort the twist and wind
+ * up the integrators of the saturated wheels. The scaling is closed-form, for
+ * the prioritizing policies the wheel velocities w_p of the prioritized part
+ * and w_s of the rest are computed separately (both are linear in the twist),
+ * w_p is scaled uniformly to the limits L and the secondary part with the
+ * largest k in [0, 1] for which |w_p + k w_s| <= L holds for every wheel:
+ *
+ *   k = min_i (L_i - sign(w_s_i) w_p_i) / |w_s_i|
+ *
+ * @tparam WheelCount The number of wheels, must match the kinematics model
+ * and the number of motor controllers.
  */
+template <int WheelCount>
 class VelocityController
 {
 public:
+    typedef typename Kinematics<WheelCount>::WheelVector WheelVector;
+
     /**
      * @brief Construct a new Robot Controller object.
      *
@@ -28,28 +45,63 @@ public:
      * calculations.
      */
     VelocityController(MotorControllerManager& motor_manager,
-                       Kinematics* kinematics_model);
+                       Kinematics<WheelCount>* kinematics_model);
 
     /**
      * @brief Update the robot's control loop. This method should be called
      *        periodically to control the robot's motors and update odometry.
+     *
+     * Runs update_wheel_setpoints(), update_motors() and
+     * update_robot_velocity() in a row.
+     *
+     * @param tick The control cycle.
+     */
+    void update(const ControlTick& tick);
+
+    /**
+     * @brief Compute the wheel velocities of the latest command, limit them
+     * and hand them to the motor controllers.
+     *
+     */
+    void update_wheel_setpoints();
+
+    /**
+     * @brief Run the motor controllers towards the wheel velocities of the
+     * last update_wheel_setpoints() and measure the wheel velocities.
+     *
+     * @param tick The cycle of the motor controllers, its dt is the time since
+     * their last update.
+     */
+    void update_motors(const ControlTick& tick);
+
+    /**
+     * @brief Compute the robot velocity from the wheel velocities measured by
+     * the last update_motors().
+     *
      */
-    void update();
+    void update_robot_velocity();
 
     /**
      * @brief Get the current velocity estimation estimation.
      *
-     * @return Eigen::Vector3d The current robot velocity estimation.
+     * @return Vector3 The current robot velocity estimation.
      */
-    Eigen::Vector3d get_robot_velocity();
+    Vector3 get_robot_velocity();
 
     /**
      * @brief Get the current set wheel velocities.
      *
-     * @return Eigen::VectorXd The current set wheel velocities based on latest
+     * @return WheelVector The current set wheel velocities based on latest
      * command.
      */
-    Eigen::VectorXd get_set_wheel_velocities();
+    WheelVector get_set_wheel_velocities();
+
+    /**
+     * @brief Get the wheel velocities measured in the latest update.
+     *
+     * @return WheelVector The measured wheel velocities.
+     */
+    WheelVector get_actual_wheel_velocities();
 
     /**
      * @brief Set the latest command for the robot's motion control.
@@ -58,14 +110,109 @@ public:
      * robot's motion control, currently only representing linear velocities
      * (vx, vy, vz).
      */
-    void set_latest_command(const Eigen::Vector3d& latest_command);
+    void set_latest_command(const Vector3& latest_command);
+
+    /**
+     * @brief Set the speed limit of each wheel. A limit of 0 leaves the wheel
+     * unlimited.
+     *
+     * @param max_wheel_speeds The limits in rad/s, should leave the feedback
+     * some headroom below the no-load speed of the motors.
+     */
+    void set_wheel_speed_limits(const WheelVector& max_wheel_speeds);
+
+    /**
+     * @brief Set how commands above the wheel speed limits are reduced.
+     *
+     * @param policy The saturation policy.
+     */
+    void set_saturation_policy(const SaturationPolicy policy);
+
+    /**
+     * @brief Get the factor the command was scaled with in the latest update.
+     * For the prioritizing policies, the factor of the secondary part if the
+     * prioritized part fits, otherwise that of the prioritized part.
+     *
+     * @return scalar_t The factor, 1 if no wheel was saturated.
+     */
+    scalar_t get_saturation_scale() const;
+
+    /**
+     * @brief Get the telemetry of the motor of a wheel.
+     *
+     * @param wheel_index The index of the wheel.
+     * @param telemetry Set to the values of the latest update.
+     */
+    void get_motor_telemetry(const uint8_t wheel_index,
+                             MotorTelemetry& telemetry) const;
+
+    /**
+     * @brief Drive the motor of a wheel with a fixed output instead of its
+     * controller (see MotorControllerManager::set_output_override()).
+     *
+     * @param wheel_index The index of the wheel.
+     * @param output The output for the motor driver.
+     */
+    void set_output_override(const uint8_t wheel_index, const scalar_t output);
+
+    /**
+     * @brief Return the motor of a wheel to its controller.
+     *
+     * @param wheel_index The index of the wheel.
+     */
+    void clear_output_override(const uint8_t wheel_index);
+
+    /**
+     * @brief Get the faults of the motor of a wheel.
+     *
+     * @param wheel_index The index of the wheel.
+     * @return uint8_t The MotorFault flags.
+     */
+    uint8_t get_motor_faults(const uint8_t wheel_index) const;
+
+    /**
+     * @brief Clear the faults of all motors.
+     *
+     */
+    void clear_motor_faults();
 
 private:
+    /**
+     * @brief Get the largest factor k <= 1 for which fixed + k * scaled stays
+     * within the wheel speed limits, assuming fixed does.
+     *
+     * @param fixed The wheel velocities that are kept.
+     * @param scaled The wheel velocities that are scaled.
+     * @return scalar_t The factor, at least 0.
+     */
+    scalar_t get_scale(const WheelVector& fixed,
+                       const WheelVector& scaled) const;
+
+    /**
+     * @brief Scale the set wheel velocities down to the wheel speed limits
+     * according to the saturation policy.
+     *
+     */
+    void saturate();
+
+    /**
+     * @brief Check whether a motor controller exists for every wheel.
+     *
+     * @return true If the motor count matches WheelCount.
+     */
+    bool has_all_motors() const;
+
     MotorControllerManager& motor_manager_;
-    Kinematics* kinematics_model_;
+    Kinematics<WheelCount>* kinematics_model_;
+
+    WheelVector max_wheel_speeds_ = WheelVector::Zero();
+    SaturationPolicy saturation_policy_ = SaturationPolicy::UNIFORM;
+    scalar_t saturation_scale_ = 1;
 
-    Eigen::Vector3d latest_command_;
-    Eigen::Vector3d robot_velocity_;
+    Vector3 latest_command_;
+    Vector3 robot_velocity_;
+    WheelVector set_wheel_velocities_;
+    WheelVector actual_wheel_velocities_;
 };
 
 #endif // VELOCITYCONTROLLER_H
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Replay the setpoints of a Teleplot recording on the motors of the robot.
+
+Needs the firmware of the esp32-replay-double or esp32-replay-float
+environment (see src/benchmarks/replay_benchmark.cpp) and pyserial. The
+motors are driven, the robot must be lifted. Usage:
+
+    python3 scripts/replay_teleplot.py res/teleplot_2023-10-5_17-37.csv \
+        [--port /dev/ttyUSB0] [--period-ms 10]
+
+The tracking of every wheel and the cycle time are printed as one JSON
+object, in the layout of `.pio/build/native-benchmark/program --replay`.
+"""
+
+import csv
+import json
+import sys
+
+MAX_SETPOINTS = 8192
+
+
+def load_setpoints(path, period):
+    """Resample the setpoint column at the period in s, held in between."""
+    with open(path) as file:
+        rows = list(csv.DictReader(file))
+    # Teleplot writes the time in s despite the "(ms)" in the header
+    samples = [(float(row["timestamp(ms)"]), float(row["setpoint"]))
+               for row in rows if row.get("setpoint")]
+    if not samples:
+        return []
+    start = samples[0][0]
+    duration = samples[-1][0] - start
+    setpoints = []
+    index = 0
+    for step in range(int(duration / period) + 1):
+        time = start + step * period
+        while index + 1 < len(samples) and samples[index + 1][0] <= time:
+            index += 1
+        setpoints.append(samples[index][1])
+    return setpoints
+
+
+def main():
+    import serial
+
+    arguments = sys.argv[1:]
+    port = "/dev/ttyUSB0"
+    period_ms = 10
+    if "--port" in arguments:
+        index = arguments.index("--port")
+        port = arguments[index + 1]
+        del arguments[index:index + 2]
+    if "--period-ms" in arguments:
+        index = arguments.index("--period-ms")
+        period_ms = int(arguments[index + 1])
+        del arguments[index:index + 2]
+    if len(arguments) != 1:
+        print(__doc__)
+        return 1
+
+    setpoints = load_setpoints(arguments[0], period_ms * 1e-3)
+    if not setpoints or len(setpoints) > MAX_SETPOINTS:
+        print("%d setpoints, 1 to %d fit the firmware, change --period-ms"
+              % (len(setpoints), MAX_SETPOINTS))
+        return 1
+
+    with serial.Serial(port, 115200, timeout=1) as device:
+        while device.readline().strip() != b"ready":
+            pass
+        device.write(b"replay %d %d\n" % (period_ms * 1000, len(setpoints)))
+        for setpoint in setpoints:
+            device.write(b"%.3f\n" % setpoint)
+        print("replaying %.1f s" % (len(setpoints) * period_ms * 1e-3),
+              file=sys.stderr)
+
+        while True:
+            line = device.readline().decode(errors="replace").strip()
+            if line.startswith("error"):
+                print(line)
+                return 1
+            if line.startswith("{"):
+                break
+
+    result = {"trace": arguments[0]}
+    result.update(json.loads(line))
+    print(json.dumps(result))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
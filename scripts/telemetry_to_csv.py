@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Record the compact telemetry topic of the firmware into a CSV file.
+
+The layout of the messages is documented in include/communication/telemetry.hpp.
+Usage (with a sourced ROS 2 workspace):
+
+    python3 scripts/telemetry_to_csv.py telemetry.csv
+"""
+
+import struct
+import sys
+
+HEADER = struct.Struct("<BBBBII")
+TICK = struct.Struct("<I")
+WHEEL = struct.Struct("<fffifff")
+WHEEL_FIELDS = ("setpoint", "measured", "output", "encoder_count",
+                "p_term", "i_term", "d_term")
+
+
+def decode(data):
+    """Decode one batch into (sequence, dropped, [(tick, [wheel, ...]), ...])."""
+    version, wheel_count, sample_count, _, sequence, dropped = \
+        HEADER.unpack_from(data, 0)
+    if version != 1:
+        raise ValueError("unsupported telemetry version %d" % version)
+
+    offset = HEADER.size
+    samples = []
+    for _ in range(sample_count):
+        (tick,) = TICK.unpack_from(data, offset)
+        offset += TICK.size
+        wheels = []
+        for _ in range(wheel_count):
+            wheels.append(WHEEL.unpack_from(data, offset))
+            offset += WHEEL.size
+        samples.append((tick, wheels))
+    return sequence, dropped, samples
+
+
+def main():
+    import rclpy
+    from rclpy.qos import qos_profile_sensor_data
+    from std_msgs.msg import UInt8MultiArray
+
+    if len(sys.argv) != 2:
+        print(__doc__)
+        return 1
+
+    output = open(sys.argv[1], "w")
+    state = {"header": False, "sequence": None, "lost": 0}
+
+    def callback(msg):
+        sequence, dropped, samples = decode(bytes(msg.data))
+        if state["sequence"] is not None and sequence != state["sequence"] + 1:
+            state["lost"] += sequence - state["sequence"] - 1
+        state["sequence"] = sequence
+
+        for tick, wheels in samples:
+            if not state["header"]:
+                columns = ["tick"] + ["m%d_%s" % (i, field)
+                                      for i in range(len(wheels))
+                                      for field in WHEEL_FIELDS]
+                output.write(",".join(columns) + "\n")
+                state["header"] = True
+            values = [str(tick)] + [str(v) for wheel in wheels for v in wheel]
+            output.write(",".join(values) + "\n")
+
+        print("\rsequence %d, lost batches %d, dropped samples %d"
+              % (sequence, state["lost"], dropped), end="")
+
+    rclpy.init()
+    node = rclpy.create_node("telemetry_to_csv")
+    node.create_subscription(UInt8MultiArray, "telemetry", callback,
+                             qos_profile_sensor_data)
+    try:
+        rclpy.spin(node)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        output.close()
+        node.destroy_node()
+        rclpy.try_shutdown()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""Trigger a full rate trace of the firmware and write it into a CSV file.
+
+The layout of the chunks is documented in include/communication/trace_dump.hpp.
+Usage (with a sourced ROS 2 workspace):
+
+    python3 scripts/trace_to_csv.py trace.csv [--wait]
+
+Without --wait, the trace is triggered through the trace/trigger service.
+With --wait, the next trace triggered by the tracking error threshold (or
+by another client) is recorded.
+"""
+
+import struct
+import sys
+
+HEADER = struct.Struct("<BBBBIHHHH")
+TIMESTAMP = struct.Struct("<I")
+RECORD_FIELDS = ("setpoint", "measured", "output", "integral")
+
+
+def decode(data):
+    """Decode one chunk into (trace_id, chunk_index, chunk_count,
+    trigger_index, [(timestamp_us, {field: [wheel, ...]}), ...])."""
+    (version, wheel_count, record_count, _, trace_id, chunk_index,
+     chunk_count, trigger_index, _) = HEADER.unpack_from(data, 0)
+    if version != 1:
+        raise ValueError("unsupported trace version %d" % version)
+
+    values = struct.Struct("<%df" % wheel_count)
+    offset = HEADER.size
+    records = []
+    for _ in range(record_count):
+        (timestamp,) = TIMESTAMP.unpack_from(data, offset)
+        offset += TIMESTAMP.size
+        fields = {}
+        for field in RECORD_FIELDS:
+            fields[field] = values.unpack_from(data, offset)
+            offset += values.size
+        records.append((timestamp, fields))
+    return trace_id, chunk_index, chunk_count, trigger_index, records
+
+
+def write_csv(path, chunks, trigger_index):
+    """Write the records of all chunks ordered by time."""
+    records = [record for index in sorted(chunks) for record in chunks[index]]
+    wheel_count = len(records[0][1]["setpoint"]) if records else 0
+    with open(path, "w") as output:
+        columns = ["index", "timestamp_us", "trigger"] + [
+            "m%d_%s" % (i, field) for i in range(wheel_count)
+            for field in RECORD_FIELDS]
+        output.write(",".join(columns) + "\n")
+        for index, (timestamp, fields) in enumerate(records):
+            values = [str(index), str(timestamp),
+                      "1" if index == trigger_index else "0"]
+            values += [str(fields[field][i]) for i in range(wheel_count)
+                       for field in RECORD_FIELDS]
+            output.write(",".join(values) + "\n")
+    return len(records)
+
+
+def main():
+    import rclpy
+    from rclpy.qos import qos_profile_sensor_data
+    from std_msgs.msg import UInt8MultiArray
+    from std_srvs.srv import Trigger
+
+    arguments = [a for a in sys.argv[1:] if a != "--wait"]
+    if len(arguments) != 1:
+        print(__doc__)
+        return 1
+
+    rclpy.init()
+    node = rclpy.create_node("trace_to_csv")
+    state = {"trace_id": None, "chunks": {}, "chunk_count": 0,
+             "trigger_index": 0}
+
+    def callback(msg):
+        trace_id, chunk_index, chunk_count, trigger_index, records = \
+            decode(bytes(msg.data))
+        if trace_id != state["trace_id"]:
+            state.update(trace_id=trace_id, chunks={})
+        state["chunks"][chunk_index] = records
+        state["chunk_count"] = chunk_count
+        state["trigger_index"] = trigger_index
+        print("\rtrace %d, chunk %d of %d"
+              % (trace_id, len(state["chunks"]), chunk_count), end="")
+
+    node.create_subscription(UInt8MultiArray, "trace", callback,
+                             qos_profile_sensor_data)
+
+    if "--wait" not in sys.argv:
+        client = node.create_client(Trigger, "trace/trigger")
+        client.wait_for_service()
+        future = client.call_async(Trigger.Request())
+        rclpy.spin_until_future_complete(node, future)
+        if not future.result().success:
+            print(future.result().message)
+
+    try:
+        while (state["trace_id"] is None or
+               len(state["chunks"]) < state["chunk_count"]):
+            rclpy.spin_once(node)
+    except KeyboardInterrupt:
+        print("\nincomplete trace, %d of %d chunks"
+              % (len(state["chunks"]), state["chunk_count"]))
+    finally:
+        count = write_csv(arguments[0], state["chunks"],
+                          state["trigger_index"])
+        print("\n%d records written to %s" % (count, arguments[0]))
+        node.destroy_node()
+        rclpy.try_shutdown()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
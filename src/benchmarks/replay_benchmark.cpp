@@ -0,0 +1,216 @@
+/**
+ * @file replay_benchmark.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief On-device replay of recorded setpoints on the motors.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Build and run with the esp32-replay-double and esp32-replay-float
+ * environments. scripts/replay_teleplot.py sends the setpoints of a Teleplot
+ * recording over the serial port, they are replayed on all wheels at the
+ * control rate, then the tracking of every wheel and the cycle time of the
+ * motor controllers are sent back as one JSON object. It has the layout of the
+ * native-benchmark --replay output, with the measured wheels in place of the
+ * simulated ones, so the hardware and the simulation can be compared directly.
+ * The motors are built from the stored configuration and autotune results like
+ * in the firmware, "faults" holds the MotorFault flags of every wheel seen
+ * during the replay.
+ *
+ * Protocol, one line each:
+ *
+ *     host:   replay <period_us> <count>
+ *     host:   <setpoint>             (count times, in rad/s)
+ *     device: {"scalar":...}         (after the replay)
+ *
+ * The motors are driven, the robot must be lifted.
+ *
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+#include "conf_hardware.h"
+#include "drive_stack.hpp"
+#include "utils/control_tick.h"
+#include "utils/instrumentation.hpp"
+#include "utils/tracking_metrics.hpp"
+
+static const uint16_t MAX_SETPOINTS = 8192;
+static const uint16_t SETTLE_CYCLES = 1000; // At 0 before and after a replay
+
+PIDController controller_M0(WHEEL_PID_KP, WHEEL_PID_KI, WHEEL_PID_KD,
+                            WHEEL_PID_MAX_SAMPLING_TIME,
+                            WHEEL_PID_MAX_INTEGRAL);
+PIDController controller_M1(WHEEL_PID_KP, WHEEL_PID_KI, WHEEL_PID_KD,
+                            WHEEL_PID_MAX_SAMPLING_TIME,
+                            WHEEL_PID_MAX_INTEGRAL);
+PIDController controller_M2(WHEEL_PID_KP, WHEEL_PID_KI, WHEEL_PID_KD,
+                            WHEEL_PID_MAX_SAMPLING_TIME,
+                            WHEEL_PID_MAX_INTEGRAL);
+PIDController controller_M3(WHEEL_PID_KP, WHEEL_PID_KI, WHEEL_PID_KD,
+                            WHEEL_PID_MAX_SAMPLING_TIME,
+                            WHEEL_PID_MAX_INTEGRAL);
+PIDController* controllers[] = {&controller_M0, &controller_M1,
+                                &controller_M2, &controller_M3};
+
+// Stalled motors are derated and encoder faults cut the output, as on the
+// robot
+FaultMonitor fault_monitor(4);
+DriveStack drive_stack;
+
+float setpoints[MAX_SETPOINTS];
+uint8_t faults[4]; // All MotorFault flags seen during a replay
+char line[256];
+char json[256];
+
+/**
+ * @brief Read a line from the serial port.
+ *
+ * @return bool True if a line was read before the timeout.
+ */
+bool read_line()
+{
+    const size_t length = Serial.readBytesUntil('\n', line, sizeof(line) - 1);
+    line[length] = '\0';
+    return length > 0;
+}
+
+/**
+ * @brief Run the motor controllers at the control rate for a number of
+ * cycles.
+ *
+ * @param cycles The number of cycles.
+ * @param period_us The period of the setpoints in microseconds.
+ * @param count The number of setpoints, 0 holds the wheels at 0.
+ * @param metrics Records the tracking of every wheel, nullptr for none.
+ * @param histogram Records the time of every cycle, nullptr for none.
+ */
+void run_cycles(const uint32_t cycles, const uint32_t period_us,
+                const uint16_t count, TrackingMetrics* metrics,
+                LatencyHistogram* histogram)
+{
+    const TickType_t period_ticks =
+        std::max<TickType_t>(1, configTICK_RATE_HZ / CONTROL_TASK_FREQUENCY);
+    const scalar_t nominal_dt =
+        scalar_t(period_ticks) / scalar_t(configTICK_RATE_HZ);
+    ControlTick tick;
+    const unsigned long start_us = micros();
+    TickType_t last_wake_time = xTaskGetTickCount();
+
+    for (uint32_t i = 0; i < cycles; i++)
+    {
+        advance_tick(tick, micros(), nominal_dt);
+        const uint32_t index = (tick.timestamp_us - start_us) / period_us;
+        const scalar_t speed =
+            index < count ? scalar_t(setpoints[index]) : scalar_t(0.0);
+
+        const uint32_t start = CycleCounter::now();
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            drive_stack.motor_control_manager->set_motor_speed(j, speed);
+        }
+        drive_stack.motor_control_manager->update(tick);
+        if (histogram != nullptr)
+        {
+            histogram->record(
+                CycleCounter::to_us(CycleCounter::now() - start));
+        }
+
+        for (uint8_t j = 0; metrics != nullptr && j < 4; j++)
+        {
+            metrics[j].record(
+                speed, drive_stack.motor_control_manager->get_motor_speed(j),
+                tick.dt);
+            faults[j] |= drive_stack.motor_control_manager->get_faults(j);
+        }
+        vTaskDelayUntil(&last_wake_time, period_ticks);
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    Serial.setTimeout(10000);
+
+    // The stored wiring, stiction and tuned gains, as in core.cpp. The gain
+    // schedule of the firmware is not applied.
+    RobotConfig<4> config;
+    set_default_hardware(config);
+    AutotuneResult autotune_results[4];
+    bool tuned[4];
+    load_stored_config(config, autotune_results, tuned);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        if (tuned[i])
+        {
+            controllers[i]->set_gains(autotune_results[i].pid);
+        }
+    }
+    drive_stack = create_drive_stack(config, controllers, &fault_monitor);
+}
+
+void loop()
+{
+    Serial.println("ready");
+    if (!read_line())
+    {
+        return;
+    }
+
+    if (strncmp(line, "replay ", 7) != 0)
+    {
+        Serial.println("error: expected replay <period_us> <count>");
+        return;
+    }
+    char* end;
+    const uint32_t period_us = strtoul(line + 7, &end, 10);
+    const uint32_t count = strtoul(end, nullptr, 10);
+    if (period_us == 0 || count == 0 || count > MAX_SETPOINTS)
+    {
+        Serial.printf("error: period must be > 0, count 1 to %u\n",
+                      unsigned(MAX_SETPOINTS));
+        return;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!read_line())
+        {
+            Serial.println("error: setpoints incomplete");
+            return;
+        }
+        setpoints[i] = strtof(line, nullptr);
+    }
+
+    const uint32_t period_control_us = 1000000 / CONTROL_TASK_FREQUENCY;
+    const uint32_t cycles =
+        uint32_t(uint64_t(count) * period_us / period_control_us);
+    TrackingMetrics metrics[4];
+    LatencyHistogram histogram(2);
+    drive_stack.motor_control_manager->clear_faults();
+    memset(faults, 0, sizeof(faults));
+    run_cycles(SETTLE_CYCLES, period_us, 0, nullptr, nullptr);
+    run_cycles(cycles, period_us, count, metrics, &histogram);
+    run_cycles(SETTLE_CYCLES, period_us, 0, nullptr, nullptr);
+
+    const LatencySummary summary = histogram.get_summary();
+    Serial.printf("{\"scalar\":\"%s\",\"period_us\":%u,\"cycles\":%u,"
+                  "\"measured\":[",
+                  sizeof(scalar_t) == sizeof(float) ? "float" : "double",
+                  unsigned(period_control_us), unsigned(cycles));
+    for (uint8_t j = 0; j < 4; j++)
+    {
+        format_tracking_json(metrics[j].get_result(), json, sizeof(json));
+        Serial.printf("%s%s", j > 0 ? "," : "", json);
+    }
+    Serial.printf("],\"faults\":[%u,%u,%u,%u]", unsigned(faults[0]),
+                  unsigned(faults[1]), unsigned(faults[2]),
+                  unsigned(faults[3]));
+    Serial.printf(",\"cycle_us\":{\"min\":%u,\"mean\":%u,\"p99\":%u,"
+                  "\"max\":%u}}\n",
+                  unsigned(summary.min_us), unsigned(summary.mean_us),
+                  unsigned(summary.p99_us), unsigned(summary.max_us));
+}
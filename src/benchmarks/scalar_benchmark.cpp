@@ -0,0 +1,145 @@
+/**
+ * @file scalar_benchmark.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief On-device benchmark of the control path for the selected scalar type.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Build and run with the esp32-benchmark-double and esp32-benchmark-float
+ * environments to compare double and single precision. The results are
+ * printed on the serial monitor. The motors are not driven.
+ *
+ */
+
+#include <Arduino.h>
+
+#include "conf_hardware.h"
+#include "kinematics/kinematics.hpp"
+#include "kinematics/odometry.hpp"
+#include "motor-control/encoder.hpp"
+#include "motor-control/motor_control_manager.hpp"
+#include "motor-control/pid_motor_controller.hpp"
+#include "velocity_controller.hpp"
+
+/**
+ * @brief Motor driver which discards the control output.
+ *
+ */
+class NullMotorDriver : public MotorDriver
+{
+public:
+    void set_motor_control(scalar_t control_value) { output_ = control_value; }
+
+private:
+    volatile scalar_t output_;
+};
+
+static const uint16_t TICKS = 2000;
+
+NullMotorDriver driver_M0, driver_M1, driver_M2, driver_M3;
+
+HalfQuadEncoder encoder_M0(M0_ENC_A, M0_ENC_B, M0_ENC_RESOLUTION);
+HalfQuadEncoder encoder_M1(M1_ENC_A, M1_ENC_B, M1_ENC_RESOLUTION);
+HalfQuadEncoder encoder_M2(M2_ENC_A, M2_ENC_B, M2_ENC_RESOLUTION);
+HalfQuadEncoder encoder_M3(M3_ENC_A, M3_ENC_B, M3_ENC_RESOLUTION);
+
+PIDController controller_M0(0.105, 0.125, 0.005, 0.2, 5.2);
+PIDController controller_M1(0.105, 0.125, 0.005, 0.2, 5.2);
+PIDController controller_M2(0.105, 0.125, 0.005, 0.2, 5.2);
+PIDController controller_M3(0.105, 0.125, 0.005, 0.2, 5.2);
+
+PIDMotorController<> motor_controller_M0(driver_M0, encoder_M0, controller_M0,
+                                         0.35);
+PIDMotorController<> motor_controller_M1(driver_M1, encoder_M1, controller_M1,
+                                         0.35);
+PIDMotorController<> motor_controller_M2(driver_M2, encoder_M2, controller_M2,
+                                         0.35);
+PIDMotorController<> motor_controller_M3(driver_M3, encoder_M3, controller_M3,
+                                         0.35);
+
+MotorControllerManager motor_control_manager{
+    {&motor_controller_M0, &motor_controller_M1, &motor_controller_M2,
+     &motor_controller_M3}};
+
+MecanumKinematics4W kinematics(WHEEL_RADIUS, WHEEL_BASE, TRACK_WIDTH);
+VelocityController<4> robot_controller(motor_control_manager, &kinematics);
+
+Odometry odometry; // Integrated by the control task as well
+volatile scalar_t sink; // Keeps benchmarked results alive
+
+/**
+ * @brief Cycle statistics of one benchmarked stage.
+ *
+ */
+struct CycleStats
+{
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+    uint64_t sum = 0;
+
+    void add(const uint32_t cycles)
+    {
+        min = cycles < min ? cycles : min;
+        max = cycles > max ? cycles : max;
+        sum += cycles;
+    }
+
+    void print(const char* name) const
+    {
+        Serial.printf("%-12s min %6u  mean %6u  max %6u cycles\n", name,
+                      (unsigned)min, (unsigned)(sum / TICKS), (unsigned)max);
+    }
+};
+
+void setup() { Serial.begin(115200); }
+
+void loop()
+{
+    CycleStats pid_stats, kinematics_stats, odometry_stats, tick_stats;
+    ControlTick control_tick;
+
+    for (uint16_t i = 0; i < TICKS; i++)
+    {
+        // Vary the command, so no stage runs on constant data
+        const scalar_t phase = scalar_t(i) * scalar_t(0.01);
+        const Vector3 command(std::sin(phase), std::cos(phase),
+                              scalar_t(0.5) * std::sin(phase));
+
+        uint32_t start = ESP.getCycleCount();
+        sink =
+            controller_M0.update(command(0), command(1), scalar_t(0.001));
+        pid_stats.add(ESP.getCycleCount() - start);
+
+        start = ESP.getCycleCount();
+        const Vector3 velocity = kinematics.calculate_robot_velocity(
+            kinematics.calculate_wheel_velocity(command));
+        kinematics_stats.add(ESP.getCycleCount() - start);
+
+        start = ESP.getCycleCount();
+        odometry.update(velocity, scalar_t(0.001));
+        odometry_stats.add(ESP.getCycleCount() - start);
+
+        start = ESP.getCycleCount();
+        advance_tick(control_tick, micros(), scalar_t(0.001));
+        robot_controller.set_latest_command(command);
+        robot_controller.update(control_tick);
+        odometry.update(robot_controller.get_robot_velocity(),
+                        scalar_t(0.001));
+        tick_stats.add(ESP.getCycleCount() - start);
+
+        delayMicroseconds(100);
+    }
+
+    Serial.printf("scalar_t: %s, %u ticks, CPU %u MHz\n",
+                  sizeof(scalar_t) == sizeof(float) ? "float" : "double",
+                  (unsigned)TICKS, (unsigned)ESP.getCpuFreqMHz());
+    pid_stats.print("pid");
+    kinematics_stats.print("kinematics");
+    odometry_stats.print("odometry");
+    tick_stats.print("full tick");
+    Serial.println();
+
+    delay(5000);
+}
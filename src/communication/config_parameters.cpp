@@ -0,0 +1,301 @@
+/**
+ * @file config_parameters.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the ConfigParameters class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "communication/config_parameters.hpp"
+#include "conf_hardware.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char PREFIX[] = "config.";
+static const size_t PREFIX_LENGTH = sizeof(PREFIX) - 1;
+static const char MOTOR_PREFIX[] = "motor_";
+static const size_t MOTOR_PREFIX_LENGTH = sizeof(MOTOR_PREFIX) - 1;
+static const size_t NAME_LENGTH = 48;
+
+static const int64_t MAX_PIN = 39;         // GPIOs of the ESP32
+static const int64_t MAX_OUTPUT_PIN = 33;  // GPIO 34 to 39 are input only
+static const int64_t MAX_PWM_CHANNEL = 15; // LEDC channels of the ESP32
+
+/**
+ * @brief A pin or channel of a MotorConfig.
+ */
+struct PinParameter
+{
+    const char* name;
+    uint8_t MotorConfig::*member;
+    int64_t max;
+};
+
+static const PinParameter PIN_PARAMETERS[] = {
+    {"in1", &MotorConfig::pin_in1, MAX_OUTPUT_PIN},
+    {"in2", &MotorConfig::pin_in2, MAX_OUTPUT_PIN},
+    {"ena", &MotorConfig::pin_ena, MAX_OUTPUT_PIN},
+    {"pwm_channel", &MotorConfig::pwm_channel, MAX_PWM_CHANNEL},
+    {"encoder_a", &MotorConfig::encoder_a, MAX_PIN},
+    {"encoder_b", &MotorConfig::encoder_b, MAX_PIN}};
+static const size_t PIN_PARAMETER_COUNT =
+    sizeof(PIN_PARAMETERS) / sizeof(PIN_PARAMETERS[0]);
+
+/**
+ * @brief Parse a name like "motor_1.in1".
+ *
+ * @param name The name without the prefix.
+ * @param motor_count The number of motors.
+ * @param index Set to the index of the motor.
+ * @return const char* The name of the motor parameter, nullptr if the name
+ * does not belong to a motor.
+ */
+static const char* parse_motor(const char* name, const int motor_count,
+                               uint8_t& index)
+{
+    if (strncmp(name, MOTOR_PREFIX, MOTOR_PREFIX_LENGTH) != 0)
+    {
+        return nullptr;
+    }
+    const char character = name[MOTOR_PREFIX_LENGTH];
+    if (character < '0' || character >= '0' + motor_count ||
+        name[MOTOR_PREFIX_LENGTH + 1] != '.')
+    {
+        return nullptr;
+    }
+    index = uint8_t(character - '0');
+    return name + MOTOR_PREFIX_LENGTH + 2;
+}
+
+template <int WheelCount>
+ConfigParameters<WheelCount>::ConfigParameters(
+    const RobotConfig<WheelCount>& config)
+    : config_(config)
+{
+    static_assert(WheelCount <= 10, "Motors are named by a single digit");
+}
+
+template <int WheelCount>
+rcl_ret_t ConfigParameters<WheelCount>::declare(
+    rclc_parameter_server_t* parameter_server) const
+{
+    char name[NAME_LENGTH];
+    rcl_ret_t ret;
+
+#define DECLARE(type, setter, value, ...)                                      \
+    snprintf(name, sizeof(name), __VA_ARGS__);                                 \
+    ret = rclc_add_parameter(parameter_server, name, (type));                  \
+    if (ret == RCL_RET_OK)                                                     \
+    {                                                                          \
+        ret = setter(parameter_server, name, (value));                         \
+    }                                                                          \
+    if (ret != RCL_RET_OK)                                                     \
+    {                                                                          \
+        return ret;                                                            \
+    }
+#define DECLARE_DOUBLE(value, ...)                                             \
+    DECLARE(RCLC_PARAMETER_DOUBLE, rclc_parameter_set_double, double(value),   \
+            __VA_ARGS__)
+#define DECLARE_INTEGER(value, ...)                                            \
+    DECLARE(RCLC_PARAMETER_INT, rclc_parameter_set_int, int64_t(value),        \
+            __VA_ARGS__)
+
+    const ControlLimits& limits = config_.limits;
+    DECLARE_DOUBLE(limits.setpoint.max_acceleration(0),
+                   "%smax_linear_acceleration", PREFIX);
+    DECLARE_DOUBLE(limits.setpoint.max_acceleration(2),
+                   "%smax_angular_acceleration", PREFIX);
+    DECLARE_DOUBLE(limits.setpoint.max_jerk(0), "%smax_linear_jerk", PREFIX);
+    DECLARE_DOUBLE(limits.setpoint.max_jerk(2), "%smax_angular_jerk", PREFIX);
+    DECLARE_DOUBLE(limits.setpoint.timeout_us * 1e-6, "%scmd_vel_timeout",
+                   PREFIX);
+    DECLARE_DOUBLE(limits.max_wheel_speed, "%smax_wheel_speed", PREFIX);
+    DECLARE_INTEGER(limits.saturation_policy, "%ssaturation_policy", PREFIX);
+
+    DECLARE_DOUBLE(config_.wheel_radius, "%swheel_radius", PREFIX);
+    DECLARE_DOUBLE(config_.wheel_base, "%swheel_base", PREFIX);
+    DECLARE_DOUBLE(config_.track_width, "%strack_width", PREFIX);
+    DECLARE_INTEGER(config_.pwm_frequency, "%spwm_frequency", PREFIX);
+    DECLARE_INTEGER(config_.pwm_resolution, "%spwm_resolution", PREFIX);
+
+    for (uint8_t i = 0; i < WheelCount; i++)
+    {
+        const MotorConfig& motor = config_.motors[i];
+        for (size_t j = 0; j < PIN_PARAMETER_COUNT; j++)
+        {
+            DECLARE_INTEGER(motor.*PIN_PARAMETERS[j].member, "%s%s%u.%s",
+                            PREFIX, MOTOR_PREFIX, i, PIN_PARAMETERS[j].name);
+        }
+        DECLARE_INTEGER(motor.encoder_resolution, "%s%s%u.encoder_resolution",
+                        PREFIX, MOTOR_PREFIX, i);
+        DECLARE_DOUBLE(motor.min_output, "%s%s%u.min_output", PREFIX,
+                       MOTOR_PREFIX, i);
+    }
+
+#undef DECLARE_INTEGER
+#undef DECLARE_DOUBLE
+#undef DECLARE
+    return RCL_RET_OK;
+}
+
+template <int WheelCount>
+bool ConfigParameters<WheelCount>::apply(const Parameter& parameter)
+{
+    if (parameter.name.data == nullptr ||
+        strncmp(parameter.name.data, PREFIX, PREFIX_LENGTH) != 0)
+    {
+        return false;
+    }
+
+    const char* name = parameter.name.data + PREFIX_LENGTH;
+    switch (parameter.value.type)
+    {
+    case RCLC_PARAMETER_DOUBLE:
+        return apply_double(name, scalar_t(parameter.value.double_value));
+    case RCLC_PARAMETER_INT:
+        return apply_integer(name, parameter.value.integer_value);
+    default:
+        return false;
+    }
+}
+
+template <int WheelCount>
+const RobotConfig<WheelCount>& ConfigParameters<WheelCount>::get_config() const
+{
+    return config_;
+}
+
+template <int WheelCount>
+bool ConfigParameters<WheelCount>::apply_double(const char* name,
+                                                const scalar_t value)
+{
+    if (!(value >= 0))
+    {
+        return false;
+    }
+
+    SetpointLimits& setpoint = config_.limits.setpoint;
+    uint8_t i;
+    if (strcmp(name, "max_linear_acceleration") == 0)
+    {
+        setpoint.max_acceleration(0) = value;
+        setpoint.max_acceleration(1) = value;
+    }
+    else if (strcmp(name, "max_angular_acceleration") == 0)
+    {
+        setpoint.max_acceleration(2) = value;
+    }
+    else if (strcmp(name, "max_linear_jerk") == 0)
+    {
+        setpoint.max_jerk(0) = value;
+        setpoint.max_jerk(1) = value;
+    }
+    else if (strcmp(name, "max_angular_jerk") == 0)
+    {
+        setpoint.max_jerk(2) = value;
+    }
+    else if (strcmp(name, "cmd_vel_timeout") == 0 &&
+             value * CONTROL_SETPOINT_FREQUENCY >= 1 && value < 3600)
+    {
+        // At least one setpoint cycle, 0 would disable the watchdog
+        setpoint.timeout_us = uint32_t(value * scalar_t(1e6));
+    }
+    else if (strcmp(name, "max_wheel_speed") == 0)
+    {
+        config_.limits.max_wheel_speed = value;
+    }
+    else if (strcmp(name, "wheel_radius") == 0 && value > 0)
+    {
+        config_.wheel_radius = value;
+    }
+    else if (strcmp(name, "wheel_base") == 0 && value > 0)
+    {
+        config_.wheel_base = value;
+    }
+    else if (strcmp(name, "track_width") == 0 && value > 0)
+    {
+        config_.track_width = value;
+    }
+    else if (const char* motor_name = parse_motor(name, WheelCount, i))
+    {
+        if (strcmp(motor_name, "min_output") != 0 || value > 1)
+        {
+            return false;
+        }
+        config_.motors[i].min_output = value;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+template <int WheelCount>
+bool ConfigParameters<WheelCount>::apply_integer(const char* name,
+                                                 const int64_t value)
+{
+    uint8_t i;
+    if (strcmp(name, "saturation_policy") == 0)
+    {
+        if (value < 0 ||
+            value > int64_t(SaturationPolicy::PRIORITIZE_TRANSLATION))
+        {
+            return false;
+        }
+        config_.limits.saturation_policy = SaturationPolicy(value);
+    }
+    else if (strcmp(name, "pwm_frequency") == 0)
+    {
+        if (value <= 0 || value > 40000000)
+        {
+            return false;
+        }
+        config_.pwm_frequency = uint32_t(value);
+    }
+    else if (strcmp(name, "pwm_resolution") == 0)
+    {
+        if (value < 1 || value > 20)
+        {
+            return false;
+        }
+        config_.pwm_resolution = uint8_t(value);
+    }
+    else if (const char* motor_name = parse_motor(name, WheelCount, i))
+    {
+        MotorConfig& motor = config_.motors[i];
+        if (strcmp(motor_name, "encoder_resolution") == 0)
+        {
+            if (value < 1 || value > UINT16_MAX)
+            {
+                return false;
+            }
+            motor.encoder_resolution = uint16_t(value);
+            return true;
+        }
+        for (size_t j = 0; j < PIN_PARAMETER_COUNT; j++)
+        {
+            if (strcmp(motor_name, PIN_PARAMETERS[j].name) == 0)
+            {
+                if (value < 0 || value > PIN_PARAMETERS[j].max)
+                {
+                    return false;
+                }
+                motor.*PIN_PARAMETERS[j].member = uint8_t(value);
+                return true;
+            }
+        }
+        return false;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+// Supported wheel counts
+template class ConfigParameters<4>;
@@ -0,0 +1,88 @@
+/**
+ * @file connection_manager.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the ConnectionManager class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "communication/connection_manager.hpp"
+#include <rmw_microros/rmw_microros.h>
+
+ConnectionManager::ConnectionManager(CreateCallback create,
+                                     DestroyCallback destroy,
+                                     const ConnectionConfig& config)
+    : create_(create), destroy_(destroy), config_(config)
+{
+}
+
+ConnectionState ConnectionManager::update(const uint32_t now_ms)
+{
+    switch (state_)
+    {
+    case ConnectionState::WAITING_AGENT:
+        if (is_due(now_ms, config_.ping_interval_ms))
+        {
+            pinged_ = true;
+            last_ping_ms_ = now_ms;
+            if (rmw_uros_ping_agent(config_.ping_timeout_ms, 1) == RMW_RET_OK)
+            {
+                state_ = ConnectionState::AGENT_AVAILABLE;
+            }
+        }
+        break;
+    case ConnectionState::AGENT_AVAILABLE:
+        if (create_())
+        {
+            state_ = ConnectionState::CONNECTED;
+            connection_count_++;
+            // The heartbeat starts one interval after the creation
+            pinged_ = true;
+            last_ping_ms_ = now_ms;
+        }
+        else
+        {
+            state_ = ConnectionState::DISCONNECTED;
+        }
+        break;
+    case ConnectionState::CONNECTED:
+        if (is_due(now_ms, config_.heartbeat_interval_ms))
+        {
+            last_ping_ms_ = now_ms;
+            if (rmw_uros_ping_agent(config_.ping_timeout_ms,
+                                    config_.heartbeat_attempts) != RMW_RET_OK)
+            {
+                state_ = ConnectionState::DISCONNECTED;
+            }
+        }
+        break;
+    case ConnectionState::DISCONNECTED:
+        destroy_();
+        state_ = ConnectionState::WAITING_AGENT;
+        // Ping again right away, the agent may only have restarted
+        pinged_ = false;
+        break;
+    }
+    return state_;
+}
+
+ConnectionState ConnectionManager::get_state() const { return state_; }
+
+bool ConnectionManager::is_connected() const
+{
+    return state_ == ConnectionState::CONNECTED;
+}
+
+uint32_t ConnectionManager::get_connection_count() const
+{
+    return connection_count_;
+}
+
+bool ConnectionManager::is_due(const uint32_t now_ms,
+                               const uint32_t interval_ms) const
+{
+    return !pinged_ || now_ms - last_ping_ms_ >= interval_ms;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file gain_schedule_parameters.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the GainScheduleParameters class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "communication/gain_schedule_parameters.hpp"
+#include <stdio.h>
+#include <string.h>
+
+static const char PREFIX[] = "gain_schedule.";
+static const size_t PREFIX_LENGTH = sizeof(PREFIX) - 1;
+static const size_t NAME_LENGTH = 48;
+
+/**
+ * @brief Parse a single digit breakpoint index.
+ *
+ * @return true If the character is a digit below GainSchedule::BREAKPOINTS.
+ */
+static bool parse_index(const char character, uint8_t& index)
+{
+    if (character < '0' || character >= '0' + GainSchedule::BREAKPOINTS)
+    {
+        return false;
+    }
+    index = uint8_t(character - '0');
+    return true;
+}
+
+/**
+ * @brief Parse a name like "wheel_speed_1" with the given prefix.
+ *
+ * @return true If the name consists of the prefix and a valid index.
+ */
+static bool parse_breakpoint(const char* name, const char* prefix,
+                             uint8_t& index)
+{
+    const size_t length = strlen(prefix);
+    return strncmp(name, prefix, length) == 0 &&
+           parse_index(name[length], index) && name[length + 1] == '\0';
+}
+
+GainScheduleParameters::GainScheduleParameters(const GainSchedule& schedule)
+    : schedule_(schedule)
+{
+}
+
+rcl_ret_t GainScheduleParameters::declare(
+    rclc_parameter_server_t* parameter_server) const
+{
+    char name[NAME_LENGTH];
+    rcl_ret_t ret;
+
+#define DECLARE(value, ...)                                                    \
+    snprintf(name, sizeof(name), __VA_ARGS__);                                 \
+    ret = rclc_add_parameter(parameter_server, name, RCLC_PARAMETER_DOUBLE);   \
+    if (ret == RCL_RET_OK)                                                     \
+    {                                                                          \
+        ret = rclc_parameter_set_double(parameter_server, name, (value));      \
+    }                                                                          \
+    if (ret != RCL_RET_OK)                                                     \
+    {                                                                          \
+        return ret;                                                            \
+    }
+
+    DECLARE(schedule_.get_rotation_radius(), "%srotation_radius", PREFIX);
+    for (uint8_t i = 0; i < GainSchedule::BREAKPOINTS; i++)
+    {
+        DECLARE(schedule_.get_wheel_speed(i), "%swheel_speed_%u", PREFIX, i);
+        DECLARE(schedule_.get_twist_breakpoint(i), "%stwist_%u", PREFIX, i);
+    }
+    for (uint8_t i = 0; i < GainSchedule::BREAKPOINTS; i++)
+    {
+        for (uint8_t j = 0; j < GainSchedule::BREAKPOINTS; j++)
+        {
+            const PIDGains& gains = schedule_.get_gains(i, j);
+            DECLARE(gains.kp, "%skp_%u_%u", PREFIX, i, j);
+            DECLARE(gains.ki, "%ski_%u_%u", PREFIX, i, j);
+            DECLARE(gains.kd, "%skd_%u_%u", PREFIX, i, j);
+        }
+    }
+
+#undef DECLARE
+    return RCL_RET_OK;
+}
+
+bool GainScheduleParameters::apply(const Parameter& parameter)
+{
+    if (parameter.name.data == nullptr ||
+        strncmp(parameter.name.data, PREFIX, PREFIX_LENGTH) != 0 ||
+        parameter.value.type != RCLC_PARAMETER_DOUBLE)
+    {
+        return false;
+    }
+
+    const char* name = parameter.name.data + PREFIX_LENGTH;
+    const scalar_t value = scalar_t(parameter.value.double_value);
+    if (!(value >= 0))
+    {
+        return false;
+    }
+
+    uint8_t i, j;
+    if (strcmp(name, "rotation_radius") == 0)
+    {
+        schedule_.set_rotation_radius(value);
+    }
+    else if (parse_breakpoint(name, "wheel_speed_", i))
+    {
+        schedule_.set_wheel_speed(i, value);
+    }
+    else if (parse_breakpoint(name, "twist_", i))
+    {
+        schedule_.set_twist_breakpoint(i, value);
+    }
+    else if (strlen(name) == 6 && name[0] == 'k' && name[2] == '_' &&
+             name[4] == '_' && parse_index(name[3], i) &&
+             parse_index(name[5], j))
+    {
+        // Names like "ki_1_2"
+        PIDGains gains = schedule_.get_gains(i, j);
+        switch (name[1])
+        {
+        case 'p':
+            gains.kp = value;
+            break;
+        case 'i':
+            gains.ki = value;
+            break;
+        case 'd':
+            gains.kd = value;
+            break;
+        default:
+            return false;
+        }
+        schedule_.set_gains(i, j, gains);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+const GainSchedule& GainScheduleParameters::get_schedule() const
+{
+    return schedule_;
+}
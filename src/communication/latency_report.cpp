@@ -0,0 +1,95 @@
+/**
+ * @file latency_report.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the LatencyReport class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "communication/latency_report.hpp"
+#include <stdio.h>
+#include <string.h>
+
+LatencyReport::LatencyReport(const char* name)
+{
+    memset(&message_, 0, sizeof(message_));
+    message_.name.data = const_cast<char*>(name);
+    message_.name.size = strlen(name);
+    message_.name.capacity = message_.name.size + 1;
+    message_.message.data = const_cast<char*>("");
+    message_.message.capacity = 1;
+    message_.hardware_id.data = const_cast<char*>("");
+    message_.hardware_id.capacity = 1;
+
+    for (uint8_t i = 0; i < MAX_VALUES; i++)
+    {
+        keys_[i][0] = '\0';
+        value_strings_[i][0] = '\0';
+        set_string(values_[i].key, keys_[i]);
+        set_string(values_[i].value, value_strings_[i]);
+    }
+    message_.values.data = values_;
+    message_.values.capacity = MAX_VALUES;
+
+    clear();
+}
+
+bool LatencyReport::add(const char* stage, const LatencySummary& summary)
+{
+    if (message_.values.size + 5 > MAX_VALUES)
+    {
+        return false;
+    }
+
+    char key[KEY_LENGTH];
+    snprintf(key, sizeof(key), "%s.count", stage);
+    add(key, summary.count);
+    snprintf(key, sizeof(key), "%s.min_us", stage);
+    add(key, summary.min_us);
+    snprintf(key, sizeof(key), "%s.max_us", stage);
+    add(key, summary.max_us);
+    snprintf(key, sizeof(key), "%s.mean_us", stage);
+    add(key, summary.mean_us);
+    snprintf(key, sizeof(key), "%s.p99_us", stage);
+    add(key, summary.p99_us);
+    return true;
+}
+
+bool LatencyReport::add(const char* key, const uint32_t value)
+{
+    if (message_.values.size >= MAX_VALUES)
+    {
+        return false;
+    }
+
+    const size_t index = message_.values.size++;
+    snprintf(keys_[index], KEY_LENGTH, "%s", key);
+    snprintf(value_strings_[index], VALUE_LENGTH, "%u", (unsigned)value);
+    set_string(values_[index].key, keys_[index]);
+    set_string(values_[index].value, value_strings_[index]);
+    return true;
+}
+
+void LatencyReport::clear()
+{
+    message_.values.size = 0;
+    message_.level = diagnostic_msgs__msg__DiagnosticStatus__OK;
+}
+
+void LatencyReport::set_level(const uint8_t level) { message_.level = level; }
+
+const diagnostic_msgs__msg__DiagnosticStatus&
+LatencyReport::get_message() const
+{
+    return message_;
+}
+
+void LatencyReport::set_string(rosidl_runtime_c__String& string, char* buffer)
+{
+    string.data = buffer;
+    string.size = strlen(buffer);
+    string.capacity = string.size + 1;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file message_pool.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the MessagePool class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "communication/message_pool.hpp"
+#include <string.h>
+
+template <int JointCount>
+MessagePool<JointCount>::MessagePool(
+    const char* odom_frame_id, const char* base_frame_id,
+    const char* const (&joint_names)[JointCount],
+    const double (&covariance_diagonal)[6])
+{
+    memset(&odometry_, 0, sizeof(odometry_));
+    memset(&joint_state_, 0, sizeof(joint_state_));
+    memset(&wanted_joint_state_, 0, sizeof(wanted_joint_state_));
+    memset(&twist_, 0, sizeof(twist_));
+
+    // Odometry
+    set_string(odometry_.header.frame_id, odom_frame_id_, odom_frame_id);
+    set_string(odometry_.child_frame_id, base_frame_id_, base_frame_id);
+    odometry_.pose.pose.orientation.w = 1.0;
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        odometry_.pose.covariance[i * 7] = covariance_diagonal[i];
+        odometry_.twist.covariance[i * 7] = covariance_diagonal[i];
+    }
+
+    // Joint states
+    for (uint8_t i = 0; i < JointCount; i++)
+    {
+        set_string(joint_name_strings_[i], joint_names_[i], joint_names[i]);
+        joint_positions_[i] = 0.0;
+        joint_velocities_[i] = 0.0;
+        wanted_joint_velocities_[i] = 0.0;
+    }
+
+    set_string(joint_state_.header.frame_id, base_frame_id_, base_frame_id);
+    joint_state_.name.data = joint_name_strings_;
+    joint_state_.name.size = JointCount;
+    joint_state_.name.capacity = JointCount;
+    set_sequence(joint_state_.position, joint_positions_, JointCount);
+    set_sequence(joint_state_.velocity, joint_velocities_, JointCount);
+
+    set_string(wanted_joint_state_.header.frame_id, base_frame_id_,
+               base_frame_id);
+    wanted_joint_state_.name.data = joint_name_strings_;
+    wanted_joint_state_.name.size = JointCount;
+    wanted_joint_state_.name.capacity = JointCount;
+    set_sequence(wanted_joint_state_.velocity, wanted_joint_velocities_,
+                 JointCount);
+}
+
+template <int JointCount>
+nav_msgs__msg__Odometry& MessagePool<JointCount>::get_odometry()
+{
+    return odometry_;
+}
+
+template <int JointCount>
+sensor_msgs__msg__JointState& MessagePool<JointCount>::get_joint_state()
+{
+    return joint_state_;
+}
+
+template <int JointCount>
+sensor_msgs__msg__JointState& MessagePool<JointCount>::get_wanted_joint_state()
+{
+    return wanted_joint_state_;
+}
+
+template <int JointCount>
+geometry_msgs__msg__Twist& MessagePool<JointCount>::get_twist()
+{
+    return twist_;
+}
+
+template <int JointCount>
+void MessagePool<JointCount>::set_string(rosidl_runtime_c__String& string,
+                                         char* buffer, const char* value)
+{
+    strncpy(buffer, value, MAX_NAME_LENGTH - 1);
+    buffer[MAX_NAME_LENGTH - 1] = '\0';
+    string.data = buffer;
+    string.size = strlen(buffer);
+    string.capacity = MAX_NAME_LENGTH;
+}
+
+template <int JointCount>
+void MessagePool<JointCount>::set_sequence(
+    rosidl_runtime_c__double__Sequence& sequence, double* buffer,
+    const size_t size)
+{
+    sequence.data = buffer;
+    sequence.size = size;
+    sequence.capacity = size;
+}
+
+// Supported joint counts
+template class MessagePool<4>;
@@ -0,0 +1,81 @@
+/**
+ * @file publisher_scheduler.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the PublisherScheduler class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "communication/publisher_scheduler.hpp"
+
+int8_t PublisherScheduler::add_topic(const float rate,
+                                     PublishCallback callback,
+                                     const float max_request_rate)
+{
+    if (topic_count_ >= MAX_TOPICS)
+    {
+        return -1;
+    }
+
+    Topic& topic = topics_[topic_count_];
+    topic.period_us = rate > 0.0f ? (unsigned long)(1000000.0f / rate) : 0;
+    topic.next_due_us = 0;
+    topic.min_interval_us =
+        max_request_rate > 0.0f
+            ? (unsigned long)(1000000.0f / max_request_rate)
+            : 0;
+    topic.last_published_us = 0;
+    topic.published = false;
+    topic.requested = false;
+    topic.callback = callback;
+    return topic_count_++;
+}
+
+void PublisherScheduler::request(const int8_t topic)
+{
+    if (topic >= 0 && topic < topic_count_)
+    {
+        topics_[topic].requested = true;
+    }
+}
+
+uint8_t PublisherScheduler::update(const unsigned long now_us)
+{
+    uint8_t published = 0;
+    for (uint8_t i = 0; i < topic_count_; i++)
+    {
+        Topic& topic = topics_[i];
+        // Signed difference, so the comparison survives the micros() overflow
+        const bool due = topic.period_us > 0 &&
+                         long(now_us - topic.next_due_us) >= 0;
+        // Requests wait for the minimum interval, and are merged meanwhile
+        const bool request_due =
+            topic.requested &&
+            (!topic.published ||
+             now_us - topic.last_published_us >= topic.min_interval_us);
+        if (!due && !request_due)
+        {
+            continue;
+        }
+
+        if (due)
+        {
+            topic.next_due_us += topic.period_us;
+            // Skip the missed publications instead of catching up
+            if (long(now_us - topic.next_due_us) >= 0)
+            {
+                topic.next_due_us = now_us + topic.period_us;
+            }
+        }
+        topic.requested = false;
+        topic.published = true;
+        topic.last_published_us = now_us;
+
+        topic.callback();
+        published++;
+    }
+    return published;
+}
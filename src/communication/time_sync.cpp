@@ -0,0 +1,122 @@
+/**
+ * @file time_sync.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the TimeSync class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "communication/time_sync.hpp"
+#include <esp_timer.h>
+#include <rmw_microros/rmw_microros.h>
+#include <stdlib.h>
+
+// A sample deviating more than this from the fitted line means the agent clock
+// jumped, so the history is discarded instead of bending the fit.
+static const int64_t MAX_RESIDUAL_NS = 10000000; // 10 ms
+
+TimeSync::TimeSync(const uint32_t sync_interval_ms, const int timeout_ms)
+    : sync_interval_ms_(sync_interval_ms), timeout_ms_(timeout_ms)
+{
+}
+
+void TimeSync::update()
+{
+    const int64_t now = local_ns();
+    if (now - last_attempt_ns_ < int64_t(sync_interval_ms_) * 1000000)
+    {
+        return;
+    }
+    last_attempt_ns_ = now;
+
+    if (rmw_uros_sync_session(timeout_ms_) != RMW_RET_OK ||
+        !rmw_uros_epoch_synchronized())
+    {
+        return;
+    }
+
+    const int64_t sample_local_ns = local_ns();
+    const int64_t sample_epoch_ns = rmw_uros_epoch_nanos();
+    add_sample(sample_local_ns, sample_epoch_ns - sample_local_ns);
+}
+
+int64_t TimeSync::now_ns() const
+{
+    const int64_t now = local_ns();
+    return now + offset_ns_ + int64_t(skew_ * double(now - reference_ns_));
+}
+
+void TimeSync::to_stamp(const int64_t time_ns,
+                        builtin_interfaces__msg__Time& stamp)
+{
+    stamp.sec = int32_t(time_ns / 1000000000);
+    stamp.nanosec = uint32_t(time_ns % 1000000000);
+}
+
+bool TimeSync::is_synchronized() const { return sample_size_ > 0; }
+
+double TimeSync::get_skew() const { return skew_; }
+
+int64_t TimeSync::local_ns() { return esp_timer_get_time() * 1000; }
+
+void TimeSync::add_sample(const int64_t local_ns, const int64_t offset_ns)
+{
+    if (sample_size_ > 0)
+    {
+        const int64_t predicted =
+            offset_ns_ + int64_t(skew_ * double(local_ns - reference_ns_));
+        if (llabs(offset_ns - predicted) > MAX_RESIDUAL_NS)
+        {
+            sample_size_ = 0;
+        }
+    }
+
+    sample_local_ns_[sample_head_] = local_ns;
+    sample_offset_ns_[sample_head_] = offset_ns;
+    sample_head_ = (sample_head_ + 1) % SAMPLE_COUNT;
+    if (sample_size_ < SAMPLE_COUNT)
+    {
+        sample_size_++;
+    }
+
+    fit();
+}
+
+void TimeSync::fit()
+{
+    // Work relative to the newest sample, the absolute values are too large
+    // to be summed in 64 bit or represented exactly as double.
+    const uint8_t newest = (sample_head_ + SAMPLE_COUNT - 1) % SAMPLE_COUNT;
+    const int64_t base_local = sample_local_ns_[newest];
+    const int64_t base_offset = sample_offset_ns_[newest];
+
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+    for (uint8_t i = 0; i < sample_size_; i++)
+    {
+        const uint8_t index = (newest + SAMPLE_COUNT - i) % SAMPLE_COUNT;
+        mean_x += double(sample_local_ns_[index] - base_local);
+        mean_y += double(sample_offset_ns_[index] - base_offset);
+    }
+    mean_x /= sample_size_;
+    mean_y /= sample_size_;
+
+    double sxx = 0.0;
+    double sxy = 0.0;
+    for (uint8_t i = 0; i < sample_size_; i++)
+    {
+        const uint8_t index = (newest + SAMPLE_COUNT - i) % SAMPLE_COUNT;
+        const double dx = double(sample_local_ns_[index] - base_local) - mean_x;
+        const double dy =
+            double(sample_offset_ns_[index] - base_offset) - mean_y;
+        sxx += dx * dx;
+        sxy += dx * dy;
+    }
+
+    reference_ns_ = base_local + int64_t(mean_x);
+    offset_ns_ = base_offset + int64_t(mean_y);
+    skew_ = sxx > 0.0 ? sxy / sxx : 0.0;
+}
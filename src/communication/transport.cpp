@@ -0,0 +1,81 @@
+/**
+ * @file transport.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the MicroRosTransport class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "communication/transport.hpp"
+#include <Arduino.h>
+#include <micro_ros_platformio.h>
+#include <rclc/rclc.h>
+
+#ifdef MICRO_ROS_TRANSPORT_WIFI
+#include "conf_network.h"
+#endif
+
+// Stringify the baud rate for the profile name
+#define TRANSPORT_STR(x) #x
+#define TRANSPORT_XSTR(x) TRANSPORT_STR(x)
+
+void MicroRosTransport::begin()
+{
+#ifdef MICRO_ROS_TRANSPORT_WIFI
+    IPAddress agent_ip(AGENT_IP);
+    set_microros_wifi_transports((char*)SSID, (char*)SSID_PW, agent_ip,
+                                 AGENT_PORT);
+#else
+    Serial.begin(MICRO_ROS_SERIAL_BAUD);
+    set_microros_serial_transports(Serial);
+#endif
+}
+
+const char* MicroRosTransport::get_profile_name()
+{
+#ifdef MICRO_ROS_TRANSPORT_WIFI
+    return "wifi_udp";
+#else
+    return "serial_" TRANSPORT_XSTR(MICRO_ROS_SERIAL_BAUD);
+#endif
+}
+
+bool MicroRosTransport::is_best_effort()
+{
+#ifdef MICRO_ROS_TRANSPORT_WIFI
+    return true;
+#else
+    return false;
+#endif
+}
+
+rcl_ret_t MicroRosTransport::init_publisher(
+    rcl_publisher_t* publisher, const rcl_node_t* node,
+    const rosidl_message_type_support_t* type_support, const char* topic_name,
+    const bool best_effort)
+{
+    if (best_effort || is_best_effort())
+    {
+        return rclc_publisher_init_best_effort(publisher, node, type_support,
+                                               topic_name);
+    }
+    return rclc_publisher_init_default(publisher, node, type_support,
+                                       topic_name);
+}
+
+rcl_ret_t MicroRosTransport::init_subscription(
+    rcl_subscription_t* subscription, const rcl_node_t* node,
+    const rosidl_message_type_support_t* type_support, const char* topic_name,
+    const bool best_effort)
+{
+    if (best_effort || is_best_effort())
+    {
+        return rclc_subscription_init_best_effort(subscription, node,
+                                                  type_support, topic_name);
+    }
+    return rclc_subscription_init_default(subscription, node, type_support,
+                                          topic_name);
+}
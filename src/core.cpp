@@ -25,43 +25,47 @@
 #include <rclc/executor.h>
 
 #include <rclc/rclc.h>
-#include <rosidl_runtime_c/string_functions.h>
+#include <rclc_parameter/rclc_parameter.h>
+#include <rmw_microros/rmw_microros.h>
 
 #include <geometry_msgs/msg/twist.h>
 #include <nav_msgs/msg/odometry.h>
 #include <sensor_msgs/msg/joint_state.h>
-
-#ifdef DEBUG
-#include <diagnostic_msgs/msg/diagnostic_status.h>
-#endif
-
+#include <std_msgs/msg/u_int8_multi_array.h>
+#include <std_srvs/srv/trigger.h>
+
+#include "communication/config_parameters.hpp"
+#include "communication/connection_manager.hpp"
+#include "communication/gain_schedule_parameters.hpp"
+#include "communication/latency_report.hpp"
+#include "communication/message_pool.hpp"
+#include "communication/publisher_scheduler.hpp"
+#include "communication/telemetry.hpp"
+#include "communication/time_sync.hpp"
+#include "communication/trace_dump.hpp"
+#include "communication/transport.hpp"
 #include "conf_hardware.h"
-// #include "conf_network.h"
+#include "drive_stack.hpp"
 #include "motor-control/encoder.hpp"
+#include "motor-control/fault_monitor.hpp"
+#include "motor-control/feed_forward_motor_controller.hpp"
 #include "motor-control/motor-drivers/l298n_motor_driver.hpp"
 #include "motor-control/pid_motor_controller.hpp"
 #include "motor-control/simple_motor_controller.hpp"
+#include "rtos/control_task.hpp"
+#include "utils/autotune_storage.hpp"
+#include "utils/config_store.hpp"
+#include "utils/instrumentation.hpp"
+#include "utils/trace_buffer.hpp"
 #include "velocity_controller.hpp"
 
-L298NMotorDriver driver_M0(M0_IN1, M0_IN2, M0_ENA, M0_PWM_CNL);
-L298NMotorDriver driver_M1(M1_IN1, M1_IN2, M1_ENA, M1_PWM_CNL);
-L298NMotorDriver driver_M2(M2_IN1, M2_IN2, M2_ENA, M2_PWM_CNL);
-L298NMotorDriver driver_M3(M3_IN1, M3_IN2, M3_ENA, M3_PWM_CNL);
-
-HalfQuadEncoder encoder_M0(M0_ENC_A, M0_ENC_B, M0_ENC_RESOLUTION);
-HalfQuadEncoder encoder_M1(M1_ENC_A, M1_ENC_B, M1_ENC_RESOLUTION);
-HalfQuadEncoder encoder_M2(M2_ENC_A, M2_ENC_B, M2_ENC_RESOLUTION);
-HalfQuadEncoder encoder_M3(M3_ENC_A, M3_ENC_B, M3_ENC_RESOLUTION);
-
-double base_kp = 0.105;
-// double modifier_kp = 1.0;
-double base_ki = 0.125;
-double modifier_ki_linear = 2.0;
-double modifier_ki_rotational = 1.1;
-double base_kd = 0.005;
-// double modifier_kd = 1.0;
-double max_expected_sampling_time = 0.2;
-double max_integral = 5.2;
+scalar_t base_kp = WHEEL_PID_KP;
+scalar_t base_ki = WHEEL_PID_KI;
+scalar_t modifier_ki_linear = 2.0;
+scalar_t modifier_ki_rotational = 1.1;
+scalar_t base_kd = WHEEL_PID_KD;
+scalar_t max_expected_sampling_time = WHEEL_PID_MAX_SAMPLING_TIME;
+scalar_t max_integral = WHEEL_PID_MAX_INTEGRAL;
 
 PIDController controller_M0(base_kp, base_ki, base_kd,
                             max_expected_sampling_time, max_integral);
@@ -72,95 +76,244 @@ PIDController controller_M2(base_kp, base_ki, base_kd,
 PIDController controller_M3(base_kp, base_ki, base_kd,
                             max_expected_sampling_time, max_integral);
 
-// LowPassFilter encoder_input_filter_M0 = LowPassFilter(100.0, 0.01);
-// LowPassFilter encoder_input_filter_M1 = LowPassFilter(100.0, 0.01);
-// LowPassFilter encoder_input_filter_M2 = LowPassFilter(100.0, 0.01);
-// LowPassFilter encoder_input_filter_M3 = LowPassFilter(100.0, 0.01);
-
-NoFilter encoder_input_filter_M0 = NoFilter();
-NoFilter encoder_input_filter_M1 = NoFilter();
-NoFilter encoder_input_filter_M2 = NoFilter();
-NoFilter encoder_input_filter_M3 = NoFilter();
-
-// MovingAverageFilter motor_output_filter_M0 = MovingAverageFilter(2);
-// MovingAverageFilter motor_output_filter_M1 = MovingAverageFilter(2);
-// MovingAverageFilter motor_output_filter_M2 = MovingAverageFilter(2);
-// MovingAverageFilter motor_output_filter_M3 = MovingAverageFilter(2);
-
-// LowPassFilter motor_output_filter_M0 = LowPassFilter(1.0, 0.2);
-// LowPassFilter motor_output_filter_M1 = LowPassFilter(1.0, 0.2);
-// LowPassFilter motor_output_filter_M2 = LowPassFilter(1.0, 0.2);
-// LowPassFilter motor_output_filter_M3 = LowPassFilter(1.0, 0.2);
-
-NoFilter motor_output_filter_M0 = NoFilter();
-NoFilter motor_output_filter_M1 = NoFilter();
-NoFilter motor_output_filter_M2 = NoFilter();
-NoFilter motor_output_filter_M3 = NoFilter();
-
-static double MIN_OUTPUT = 0.35;
-
-PIDMotorController motor_controller_M0(driver_M0, encoder_M0, controller_M0,
-                                       encoder_input_filter_M0,
-                                       motor_output_filter_M0, MIN_OUTPUT);
-PIDMotorController motor_controller_M1(driver_M1, encoder_M1, controller_M1,
-                                       encoder_input_filter_M1,
-                                       motor_output_filter_M1, MIN_OUTPUT);
-PIDMotorController motor_controller_M2(driver_M2, encoder_M2, controller_M2,
-                                       encoder_input_filter_M2,
-                                       motor_output_filter_M2, MIN_OUTPUT);
-PIDMotorController motor_controller_M3(driver_M3, encoder_M3, controller_M3,
-                                       encoder_input_filter_M3,
-                                       motor_output_filter_M3, MIN_OUTPUT);
-
-MotorControllerManager motor_control_manager{
-    {&motor_controller_M0, &motor_controller_M1, &motor_controller_M2,
-     &motor_controller_M3}};
-
-MecanumKinematics4W kinematics(WHEEL_RADIUS, WHEEL_BASE, TRACK_WIDTH);
-VelocityController robot_controller(motor_control_manager, &kinematics);
-
-MovingAverageFilter cmd_vel_filter_x = MovingAverageFilter(2);
-MovingAverageFilter cmd_vel_filter_y = MovingAverageFilter(2);
-MovingAverageFilter cmd_vel_filter_rot = MovingAverageFilter(4);
-
-Eigen::Matrix<double, 3, 1> smoothed_cmd_vel;
+PIDController* controllers[] = {&controller_M0, &controller_M1,
+                                &controller_M2, &controller_M3};
+
+// The drivers, encoders and everything depending on them are created by
+// createControlStack() in setup(), from the configuration stored in the NVS
+// or the defaults of conf_hardware.h, see createDefaultConfig(). The motors
+// are built by create_drive_stack() in drive_stack.cpp.
+//
+// Filters are composed at compile time, e.g.
+// typedef FilterChain<LowPassFilter> EncoderInputFilter;
+// typedef FilterChain<MovingAverageFilter<2>, LowPassFilter> MotorOutputFilter;
+// new PIDMotorController<EncoderInputFilter, MotorOutputFilter>(
+//     *drivers[i], *encoders[i], *controllers[i],
+//     EncoderInputFilter(LowPassFilter(100.0, 0.01)),
+//     MotorOutputFilter(MovingAverageFilter<2>(), LowPassFilter(1.0, 0.2)),
+//     motor.min_output);
+// For tuning, TunablePIDMotorController takes Filter& instead. A
+// HalfQuadEncoder takes the same arguments as the EdgeTimingEncoder.
+//
+// Alternatively, FeedForwardMotorController adds feed-forward (ks covers the
+// stiction region below MOTOR_MIN_OUTPUT) to a velocity form PID with
+// anti-windup:
+// FeedForwardConfig feed_forward_config;
+// feed_forward_config.pid = PIDGains{0.05, 0.5, 0.0};
+// feed_forward_config.kv = 0.035; // Output per rad/s at steady state
+// feed_forward_config.ks = MOTOR_MIN_OUTPUT;
+// new FeedForwardMotorController<>(*drivers[i], *encoders[i],
+//                                  feed_forward_config);
+// The "autotune" service identifies the motors and stores the tuned gains and
+// feed-forward in the NVS (AutotuneStorage::load(), AutotuneResult).
+DriveStack drive_stack;
+MecanumKinematics4W* kinematics;
+VelocityController<4>* robot_controller;
+ControlTask<4>* control_task;
+
+// Stalled motors are derated, encoder faults cut the output. Current sensors
+// enable the overcurrent check, e.g. with the L298N SENSE pins on ADC1:
+// AnalogCurrentSensor current_sensor_M0(36, 0.5);
+// fault_monitor.set_current_sensor(0, &current_sensor_M0);
+// with FaultConfig::max_current set.
+FaultMonitor fault_monitor(4);
 
 rcl_subscription_t cmd_vel_subscriber;
 rcl_publisher_t odom_publisher;
 rcl_publisher_t joint_state_publisher, wanted_joint_state_publisher;
-#ifdef DEBUG
+rcl_publisher_t telemetry_publisher;
+rcl_publisher_t trace_publisher;
+rcl_service_t autotune_service;
+std_srvs__srv__Trigger_Request autotune_request;
+std_srvs__srv__Trigger_Response autotune_response;
+rcl_service_t config_save_service;
+std_srvs__srv__Trigger_Request config_save_request;
+std_srvs__srv__Trigger_Response config_save_response;
+rcl_service_t config_reset_service;
+std_srvs__srv__Trigger_Request config_reset_request;
+std_srvs__srv__Trigger_Response config_reset_response;
+rcl_service_t trace_trigger_service;
+std_srvs__srv__Trigger_Request trace_trigger_request;
+std_srvs__srv__Trigger_Response trace_trigger_response;
 rcl_publisher_t diagnostic_publisher;
-#endif
-
-geometry_msgs__msg__Twist twist_msg;
-nav_msgs__msg__Odometry odom_msg;
-sensor_msgs__msg__JointState joint_state_msg, wanted_joint_state_msg;
-
-#ifdef DEBUG
-diagnostic_msgs__msg__DiagnosticStatus diagnostic_msg;
-#endif
+rcl_service_t fault_clear_service;
+std_srvs__srv__Trigger_Request fault_clear_request;
+std_srvs__srv__Trigger_Response fault_clear_response;
+
+// All messages and their strings and sequences are preallocated in the pool
+const char* const joint_names[4] = {
+    "wheel_front_left_joint", "wheel_front_right_joint",
+    "wheel_back_left_joint", "wheel_back_right_joint"};
+// z, roll and pitch are fixed by the floor, the planar entries are estimated
+// by the odometry of the control task
+const double odom_covariance_diagonal[6] = {0.0, 0.0, 1e-6, 1e-6, 1e-6, 0.0};
+MessagePool<4> message_pool("odom", "base_link", joint_names,
+                            odom_covariance_diagonal);
+
+geometry_msgs__msg__Twist& twist_msg = message_pool.get_twist();
+nav_msgs__msg__Odometry& odom_msg = message_pool.get_odometry();
+sensor_msgs__msg__JointState& joint_state_msg = message_pool.get_joint_state();
+sensor_msgs__msg__JointState& wanted_joint_state_msg =
+    message_pool.get_wanted_joint_state();
 
 rclc_executor_t executor;
 rclc_support_t support;
 rcl_allocator_t allocator;
 rcl_node_t node;
+rclc_parameter_server_t parameter_server;
 
-unsigned long last_time = 0;
-Eigen::Vector3d pose = Eigen::Vector3d::Zero();
+// The twist magnitude is |(vx, vy)| + GAIN_SCHEDULE_ROTATION_RADIUS * |wz|,
+// rotating with wz moves the wheels at about this radius
+const scalar_t GAIN_SCHEDULE_ROTATION_RADIUS = (WHEEL_BASE + TRACK_WIDTH) / 2;
+
+/**
+ * @brief Create the default gain schedule. The integral gain rises with the
+ * commanded twist, up to base_ki * modifier_ki_linear at 0.5 m/s. A pure
+ * rotation at 1 rad/s reaches about base_ki * modifier_ki_rotational.
+ *
+ * @return GainSchedule The gain schedule, independent of the wheel speed.
+ */
+GainSchedule createDefaultGainSchedule()
+{
+    GainSchedule schedule(PIDGains{base_kp, base_ki, base_kd}, 10.0, 0.5,
+                          GAIN_SCHEDULE_ROTATION_RADIUS);
+    schedule.set_twist_breakpoint(1, GAIN_SCHEDULE_ROTATION_RADIUS);
+    for (uint8_t i = 0; i < GainSchedule::BREAKPOINTS; i++)
+    {
+        schedule.set_gains(
+            i, 1, PIDGains{base_kp, base_ki * modifier_ki_rotational, base_kd});
+        schedule.set_gains(
+            i, 2, PIDGains{base_kp, base_ki * modifier_ki_linear, base_kd});
+    }
+    return schedule;
+}
+
+GainScheduleParameters gain_schedule_parameters(createDefaultGainSchedule());
+
+// Scales of the scheduled gains per motor, set by the autotune
+ControlTask<4>::GainScales gain_scales;
+
+// Erasing and writing the NVS disables the flash cache of both cores, which
+// stalls the control task for milliseconds. The NVS is therefore only written
+// while the robot stands still and no motor is tuned.
+const scalar_t STANDSTILL_SPEED = 0.1; // rad/s, on every wheel
+bool standing_still = false;
+// Autotune results waiting for the standstill to be stored
+bool autotune_pending[4] = {false, false, false, false};
+AutotuneResult autotune_pending_results[4];
+
+/**
+ * @brief Scale the scheduled gains of a motor to the gains tuned for it. The
+ * tuned gains take the place of the base gains, the schedule keeps its shape.
+ *
+ * @param motor The index of the motor.
+ * @param result The autotune result of the motor.
+ */
+void applyAutotuneResult(const uint8_t motor, const AutotuneResult& result)
+{
+    gain_scales[motor].kp = result.pid.kp / base_kp;
+    gain_scales[motor].ki = result.pid.ki / base_ki;
+    gain_scales[motor].kd = base_kd > 0 ? result.pid.kd / base_kd : 1;
+}
 
-unsigned long last_time_sync_ms = 0;
-unsigned long last_time_sync_ns = 0;
-const unsigned long time_sync_interval = 1000;
-const int timeout_ms = 500;
-int64_t synced_time_ms = 0;
-int64_t synced_time_ns = 0;
+/**
+ * @brief Create the default configuration from conf_hardware.h, used until a
+ * configuration was saved to the NVS.
+ *
+ * @return RobotConfig<4> The default configuration.
+ */
+RobotConfig<4> createDefaultConfig()
+{
+    RobotConfig<4> config;
+    set_default_hardware(config);
+
+    config.gain_schedule = createDefaultGainSchedule();
+    SetpointLimits& setpoint = config.limits.setpoint;
+    setpoint.max_acceleration << MAX_LINEAR_ACCELERATION,
+        MAX_LINEAR_ACCELERATION, MAX_ANGULAR_ACCELERATION;
+    setpoint.max_jerk << MAX_LINEAR_JERK, MAX_LINEAR_JERK, MAX_ANGULAR_JERK;
+    setpoint.timeout_us = CMD_VEL_TIMEOUT;
+    config.limits.max_wheel_speed = MAX_WHEEL_SPEED;
+    config.limits.saturation_policy = SaturationPolicy::UNIFORM;
+    return config;
+}
+
+ConfigParameters<4> config_parameters(createDefaultConfig());
+
+/**
+ * @brief Create the motor drivers, encoders and motor controllers and the
+ * control task driving them. Called once in setup(), a changed wiring or
+ * geometry therefore takes effect on the next boot.
+ *
+ * @param config The configuration to build from.
+ */
+void createControlStack(const RobotConfig<4>& config)
+{
+    drive_stack = create_drive_stack(config, controllers, &fault_monitor);
+    kinematics = new MecanumKinematics4W(config.wheel_radius,
+                                         config.wheel_base, config.track_width);
+    robot_controller = new VelocityController<4>(
+        *drive_stack.motor_control_manager, kinematics);
+
+    ControlRates rates;
+    rates.setpoint = {CONTROL_SETPOINT_FREQUENCY, CONTROL_SETPOINT_DEADLINE_US};
+    rates.kinematics = {CONTROL_KINEMATICS_FREQUENCY,
+                        CONTROL_KINEMATICS_DEADLINE_US};
+    rates.motors = {CONTROL_MOTOR_FREQUENCY, CONTROL_MOTOR_DEADLINE_US};
+    rates.odometry = {CONTROL_ODOMETRY_FREQUENCY, CONTROL_ODOMETRY_DEADLINE_US};
+    control_task = new ControlTask<4>(*robot_controller, CONTROL_TASK_FREQUENCY,
+                                      CONTROL_TASK_CORE, CONTROL_TASK_PRIORITY,
+                                      CONTROL_TASK_STACK_SIZE, rates);
+}
+
+unsigned long last_time = 0;
+OdometryEstimate odometry_estimate;
+
+// Each topic is published at its own rate, the control states seen in between
+// are reduced by the decimated values
+PublisherScheduler publisher_scheduler;
+int8_t wanted_joint_state_topic = -1;
+uint32_t last_control_tick = 0;
+DecimatedValue<Vector3> odom_velocity(SampleMode::AVERAGE, Vector3::Zero());
+DecimatedValue<MecanumKinematics4W::WheelVector>
+    joint_velocities(SampleMode::AVERAGE,
+                     MecanumKinematics4W::WheelVector::Zero());
+MecanumKinematics4W::WheelVector wanted_wheel_velocities =
+    MecanumKinematics4W::WheelVector::Zero();
+
+const uint32_t time_sync_interval_ms = 1000;
+const int time_sync_timeout_ms = 10;
+TimeSync time_sync(time_sync_interval_ms, time_sync_timeout_ms);
+
+TelemetryBatch<4, TELEMETRY_BATCH_SIZE> telemetry_batch;
+TelemetrySample<4> telemetry_sample;
+
+// Allocated in setup(), the trace is disabled if the allocation fails
+TraceBuffer<TraceRecord<4>> trace_buffer;
+TraceDump<4, TRACE_CHUNK_SIZE> trace_dump(trace_buffer);
+
+// Latency of the loop() stages, the control task measures itself
+LatencyHistogram time_sync_histogram(500);
+LatencyHistogram spin_histogram(500);
+LatencyHistogram odometry_histogram(10);
+LatencyHistogram publish_histogram(100);
 
 #ifdef DEBUG
 #ifdef DEBUG_TIME
-unsigned long last_time_debug = 0;
+const unsigned long latency_report_interval_ms = 1000;
+unsigned long last_latency_report_time = 0;
+ControlTiming control_timing;
+LatencyReport latency_report("roboost_pmc_latency");
 #endif
 #endif
 
+// The MotorFault flags are published when they change and periodically while
+// a motor is faulty
+const unsigned long fault_report_interval_ms = 1000;
+unsigned long last_fault_report_time = 0;
+uint8_t reported_faults[4] = {0, 0, 0, 0};
+LatencyReport fault_report("roboost_pmc_motor_faults");
+
 /**
  * @brief Callback function for handling incoming cmd_vel (velocity command)
  * messages.
@@ -178,322 +331,710 @@ void cmd_vel_subscription_callback(const void* msgin)
 {
     const auto* msg = reinterpret_cast<const geometry_msgs__msg__Twist*>(msgin);
 
-    smoothed_cmd_vel(0) = cmd_vel_filter_x.update(msg->linear.x);
-    smoothed_cmd_vel(1) = cmd_vel_filter_y.update(msg->linear.y);
-    smoothed_cmd_vel(2) = cmd_vel_filter_rot.update(msg->angular.z);
+    // The control task ramps towards the command and schedules the gains on
+    // the ramped velocity
+    ControlSetpoint setpoint;
+    setpoint.velocity << msg->linear.x, msg->linear.y, msg->angular.z;
+    control_task->set_setpoint(setpoint);
+}
 
-    // Based on max velocity multiply the ki value by a factor
-    if (abs(smoothed_cmd_vel(0)) > 0.5 || abs(smoothed_cmd_vel(1)) > 0.5)
+/**
+ * @brief Callback function for changed ROS parameters.
+ *
+ * @param old_param The parameter before the change, NULL if it is new.
+ * @param new_param The parameter after the change, NULL if it was deleted.
+ * @param context Unused.
+ * @return true If the change is accepted.
+ */
+bool on_parameter_changed(const Parameter* old_param,
+                          const Parameter* new_param, void* context)
+{
+    (void)old_param;
+    (void)context;
+    if (new_param == NULL)
     {
-        controller_M0.set_ki(base_ki * modifier_ki_linear);
-        controller_M1.set_ki(base_ki * modifier_ki_linear);
-        controller_M2.set_ki(base_ki * modifier_ki_linear);
-        controller_M3.set_ki(base_ki * modifier_ki_linear);
+        return false;
     }
-    else if (abs(smoothed_cmd_vel(2)) > 1.0)
+
+    if (gain_schedule_parameters.apply(*new_param))
     {
-        controller_M0.set_ki(base_ki * modifier_ki_rotational);
-        controller_M1.set_ki(base_ki * modifier_ki_rotational);
-        controller_M2.set_ki(base_ki * modifier_ki_rotational);
-        controller_M3.set_ki(base_ki * modifier_ki_rotational);
+        // Ignored while the breakpoints are not increasing, e.g. halfway
+        // through moving them one by one
+        control_task->set_gain_schedule(
+            gain_schedule_parameters.get_schedule());
+        return true;
     }
-    else
+    if (config_parameters.apply(*new_param))
     {
-        controller_M0.set_ki(base_ki);
-        controller_M1.set_ki(base_ki);
-        controller_M2.set_ki(base_ki);
-        controller_M3.set_ki(base_ki);
+        // The hardware part only takes effect once saved and rebooted, the
+        // limits are handed over as a whole
+        control_task->set_limits(config_parameters.get_config().limits);
+        return true;
     }
-
-    robot_controller.set_latest_command(smoothed_cmd_vel);
+    return false;
 }
 
 #ifdef DEBUG
+#ifdef DEBUG_TIME
 /**
- * @brief Publishes a diagnostic message with the given message.
+ * @brief Publishes the latency summaries of all stages and resets them.
  *
- * @param message The message to publish.
  */
-void publishDiagnosticMessage(const char* message)
+void publishLatencyReport()
 {
-    diagnostic_msg.level = diagnostic_msgs__msg__DiagnosticStatus__STALE;
-    diagnostic_msg.message.data = (char*)message;
-    diagnostic_msg.message.size = strlen(diagnostic_msg.message.data);
-    diagnostic_msg.message.capacity = diagnostic_msg.message.size + 1;
+    control_task->get_timing(control_timing);
+
+    latency_report.clear();
+    latency_report.add("time_sync", time_sync_histogram.get_summary());
+    latency_report.add("spin", spin_histogram.get_summary());
+    latency_report.add("odometry", odometry_histogram.get_summary());
+    latency_report.add("publish", publish_histogram.get_summary());
+    latency_report.add("control_cycle", control_timing.cycle);
+    latency_report.add("control_period", control_timing.period);
+    latency_report.add("deadline_misses", control_timing.deadline_misses);
+    const RateGroupTiming* groups[] = {
+        &control_timing.setpoint, &control_timing.kinematics,
+        &control_timing.motors, &control_timing.odometry};
+    const char* group_names[] = {"setpoint", "kinematics", "motors",
+                                 "odometry"};
+    uint32_t overruns = 0;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        char key[LatencyReport::KEY_LENGTH];
+        snprintf(key, sizeof(key), "group.%s.max_us", group_names[i]);
+        latency_report.add(key, groups[i]->duration.max_us);
+        snprintf(key, sizeof(key), "group.%s.overruns", group_names[i]);
+        latency_report.add(key, groups[i]->overruns);
+        overruns += groups[i]->overruns;
+    }
+    // Heap allocations of the control task must stay at zero
+    latency_report.add("alloc", control_task->get_allocation_count());
+    latency_report.add("heap_min", HeapMonitor::get_free_heap_watermark());
+    if (control_timing.deadline_misses > 0 || overruns > 0 ||
+        control_task->get_allocation_count() > 0)
+    {
+        latency_report.set_level(diagnostic_msgs__msg__DiagnosticStatus__WARN);
+    }
+
+    RCSOFTCHECK(rcl_publish(&diagnostic_publisher,
+                            &latency_report.get_message(), NULL));
 
-    RCSOFTCHECK(rcl_publish(&diagnostic_publisher, &diagnostic_msg, NULL));
+    time_sync_histogram.reset();
+    spin_histogram.reset();
+    odometry_histogram.reset();
+    publish_histogram.reset();
 }
 #endif
+#endif
 
-bool performInitializationWithFeedback(std::function<rcl_ret_t()> initFunction)
+/**
+ * @brief Publishes the MotorFault flags of all motors if they changed since
+ * the last report, or if a motor is faulty and fault_report_interval_ms
+ * passed. The level is ERROR if an output was cut and WARN if one is derated.
+ *
+ * @param control_state The latest state of the control task.
+ * @param now The current time in milliseconds.
+ */
+void publishFaultReport(const ControlState<4>& control_state,
+                        const unsigned long now)
 {
-    while (true)
+    bool changed = false;
+    bool faulty = false;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        changed =
+            changed || control_state.motor_faults[i] != reported_faults[i];
+        faulty = faulty || control_state.motor_faults[i] != MOTOR_FAULT_NONE;
+    }
+    if (!changed &&
+        !(faulty && now - last_fault_report_time >= fault_report_interval_ms))
     {
-        if (initFunction() == RCL_RET_OK)
+        return;
+    }
+    last_fault_report_time = now;
+
+    fault_report.clear();
+    uint8_t level = diagnostic_msgs__msg__DiagnosticStatus__OK;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        const uint8_t faults = control_state.motor_faults[i];
+        reported_faults[i] = faults;
+        char key[16];
+        snprintf(key, sizeof(key), "motor_%u", i);
+        fault_report.add(key, faults);
+        if (faults & MOTOR_FAULTS_LATCHED)
         {
-            return true; // Initialization successful
+            level = diagnostic_msgs__msg__DiagnosticStatus__ERROR;
         }
-        else
+        else if (faults != MOTOR_FAULT_NONE &&
+                 level == diagnostic_msgs__msg__DiagnosticStatus__OK)
         {
-            // Flash LED to indicate failure
-            digitalWrite(LED_BUILTIN, HIGH);
-            delay(100);
-            digitalWrite(LED_BUILTIN, LOW);
-            delay(100);
+            level = diagnostic_msgs__msg__DiagnosticStatus__WARN;
         }
     }
-}
+    fault_report.set_level(level);
 
-#define INIT(initCall)                                                         \
-    performInitializationWithFeedback([&]() { return (initCall); })
+    RCSOFTCHECK(rcl_publish(&diagnostic_publisher, &fault_report.get_message(),
+                            NULL));
+}
 
 /**
- * @brief Setup function for initializing micro-ROS, pin modes, etc.
+ * @brief Publishes the odometry with the latest pose and its covariance and the
+ * velocity of the last decimation window.
  *
  */
-void setup()
+void publishOdometry()
 {
-    // Configure serial transport
-    Serial.begin(115200); // disable in production
+    const Vector3 robot_velocity = odom_velocity.get();
+    odom_velocity.reset();
+
+    const Vector3& pose = odometry_estimate.pose;
+    odom_msg.pose.pose.position.x = pose(0);
+    odom_msg.pose.pose.position.y = pose(1);
+    // Orientation in quaternion notation
+    odom_msg.pose.pose.orientation.w = std::cos(pose(2) / scalar_t(2.0));
+    odom_msg.pose.pose.orientation.z = std::sin(pose(2) / scalar_t(2.0));
 
-    // IPAddress agent_ip(AGENT_IP);
-    // uint16_t agent_port = AGENT_PORT;
+    // Row major 6x6 over (x, y, z, roll, pitch, yaw), the planar entries are
+    // x, y and yaw
+    static const uint8_t planar[3] = {0, 1, 5};
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            odom_msg.pose.covariance[planar[i] * 6 + planar[j]] =
+                odometry_estimate.pose_covariance(i, j);
+        }
+        odom_msg.twist.covariance[planar[i] * 7] =
+            odometry_estimate.velocity_variance(i);
+    }
 
-    // ! uncomment this for serial and remove the wifi transport below and in
-    // ! the platformio.ini
-    set_microros_serial_transports(Serial);
+    odom_msg.twist.twist.linear.x = robot_velocity(0);
+    odom_msg.twist.twist.linear.y = robot_velocity(1);
+    odom_msg.twist.twist.angular.z = robot_velocity(2);
 
-    // set_microros_wifi_transports((char*)SSID, (char*)SSID_PW, agent_ip,
-    //                              agent_port);
-    delay(2000);
+    TimeSync::to_stamp(time_sync.now_ns(), odom_msg.header.stamp);
 
-    allocator = rcl_get_default_allocator();
+    RCSOFTCHECK(rcl_publish(&odom_publisher, &odom_msg, NULL));
+}
 
-    // create init_options
-    // clang-format off
-    INIT(rclc_support_init(&support, 0, NULL, &allocator));
-    INIT(rclc_node_init_default(&node, "roboost_pmc_node", "", &support));
-    INIT(rclc_publisher_init_default(&odom_publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(nav_msgs, msg, Odometry), "odom"));
-    INIT(rclc_publisher_init_default(&joint_state_publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(sensor_msgs, msg, JointState), "joint_states"));
-    INIT(rclc_publisher_init_default(&wanted_joint_state_publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(sensor_msgs, msg, JointState), "wanted_joint_states"));
-#ifdef DEBUG
-    INIT(rclc_publisher_init_default(&diagnostic_publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(diagnostic_msgs, msg, DiagnosticStatus), "diagnostics"));
-#endif
-    INIT(rclc_subscription_init_default(&cmd_vel_subscriber, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(geometry_msgs, msg, Twist), "cmd_vel"));
-    INIT(rclc_executor_init(&executor, &support.context, 1, &allocator));
-    INIT(rclc_executor_add_subscription(&executor, &cmd_vel_subscriber, &twist_msg, &cmd_vel_subscription_callback, ON_NEW_DATA));
-    // clang-format on
+/**
+ * @brief Publishes the integrated wheel positions and the wheel velocities of
+ * the last decimation window.
+ *
+ */
+void publishJointStates()
+{
+    const MecanumKinematics4W::WheelVector wheel_velocities =
+        joint_velocities.get();
+    joint_velocities.reset();
 
-    delay(500);
-    pinMode(LED_BUILTIN, OUTPUT);
-    digitalWrite(LED_BUILTIN, HIGH);
+    joint_state_msg.velocity.data[0] = wheel_velocities(0);
+    joint_state_msg.velocity.data[1] = wheel_velocities(1);
+    joint_state_msg.velocity.data[2] = wheel_velocities(2);
+    joint_state_msg.velocity.data[3] = wheel_velocities(3);
+
+    TimeSync::to_stamp(time_sync.now_ns(), joint_state_msg.header.stamp);
+
+    RCSOFTCHECK(rcl_publish(&joint_state_publisher, &joint_state_msg, NULL));
+}
 
-    odom_msg.header.frame_id.data = "odom";
-    odom_msg.header.frame_id.size = strlen(odom_msg.header.frame_id.data);
-    odom_msg.header.frame_id.capacity = odom_msg.header.frame_id.size + 1;
-    odom_msg.child_frame_id.data = "base_link";
-    odom_msg.child_frame_id.size = strlen(odom_msg.child_frame_id.data);
-    odom_msg.child_frame_id.capacity = odom_msg.child_frame_id.size + 1;
+/**
+ * @brief Publishes the wheel velocities set by the velocity controller.
+ *
+ */
+void publishWantedJointStates()
+{
+    wanted_joint_state_msg.velocity.data[0] = wanted_wheel_velocities(0);
+    wanted_joint_state_msg.velocity.data[1] = wanted_wheel_velocities(1);
+    wanted_joint_state_msg.velocity.data[2] = wanted_wheel_velocities(2);
+    wanted_joint_state_msg.velocity.data[3] = wanted_wheel_velocities(3);
 
-    double* temp_covariance = (double*)malloc(36 * sizeof(double));
+    TimeSync::to_stamp(time_sync.now_ns(),
+                       wanted_joint_state_msg.header.stamp);
 
-    // TODO: determine correct covariance values
-    for (int i = 0; i < 36; i++)
+    RCSOFTCHECK(rcl_publish(&wanted_joint_state_publisher,
+                            &wanted_joint_state_msg, NULL));
+}
+
+/**
+ * @brief Publishes the telemetry recorded by the control task in batches of
+ * TELEMETRY_BATCH_SIZE samples.
+ *
+ */
+void publishTelemetry()
+{
+    while (control_task->pop_telemetry(telemetry_sample))
     {
-        if (i % 7 != 0)
+        if (telemetry_batch.add(telemetry_sample))
         {
-            temp_covariance[i] = 0.0;
+            const uint32_t dropped = control_task->get_telemetry_drop_count();
+            RCSOFTCHECK(rcl_publish(&telemetry_publisher,
+                                    &telemetry_batch.finish(dropped), NULL));
         }
     }
-    temp_covariance[0 + 0] = 0.8;  // x
-    temp_covariance[6 + 1] = 0.8;  // y
-    temp_covariance[12 + 2] = 0.8; // z
-    temp_covariance[18 + 3] = 0;   // rotation about X axis
-    temp_covariance[24 + 4] = 0;   // rotation about Y axis
-    temp_covariance[30 + 5] = 0.8; // rotation about Z axis
-
-    memcpy(odom_msg.pose.covariance, temp_covariance, 36 * sizeof(double));
-    memcpy(odom_msg.twist.covariance, temp_covariance, 36 * sizeof(double));
-    free(temp_covariance);
-
-    // Initialize the joint state message
-    joint_state_msg.header.frame_id.data = "base_link";
-    rosidl_runtime_c__String__Sequence__init(&joint_state_msg.name, 4);
-    rosidl_runtime_c__String__assign(&joint_state_msg.name.data[0],
-                                     "wheel_front_left_joint");
-    rosidl_runtime_c__String__assign(&joint_state_msg.name.data[1],
-                                     "wheel_front_right_joint");
-    rosidl_runtime_c__String__assign(&joint_state_msg.name.data[2],
-                                     "wheel_back_left_joint");
-    rosidl_runtime_c__String__assign(&joint_state_msg.name.data[3],
-                                     "wheel_back_right_joint");
-    joint_state_msg.name.size = 4;
-    joint_state_msg.name.capacity = 4;
-
-    joint_state_msg.position.data = (double*)malloc(4 * sizeof(double));
-    joint_state_msg.position.size = 4;
-    joint_state_msg.position.capacity = 4;
-
-    joint_state_msg.velocity.data = (double*)malloc(4 * sizeof(double));
-    joint_state_msg.velocity.size = 4;
-    joint_state_msg.velocity.capacity = 4;
 }
 
 /**
- * @brief Main loop for continuously updating and publishing the robot's
- * odometry.
+ * @brief Callback function for the trace/trigger service. Freezes the trace
+ * TRACE_POST_TRIGGER control cycles later.
  *
+ * @param request Pointer to the std_srvs__srv__Trigger_Request (unused).
+ * @param response Pointer to the std_srvs__srv__Trigger_Response.
  */
-void loop()
+void trace_trigger_service_callback(const void* request, void* response)
 {
-#ifdef DEBUG
-#ifdef DEBUG_TIME
-    char debug_str[200];
-    strcpy(debug_str, "");
-
-    // Publish debug time information for diagnostics 0
-    unsigned long now_debug = millis();
-    double dt_debug = (now_debug - last_time_debug) / 1000.0;
-    char dt_part[50];
-    sprintf(dt_part, "[0]: %f; ", dt_debug);
-    strcat(debug_str, dt_part);
-    last_time_debug = now_debug;
-#endif
-#endif
+    (void)request;
+    auto* res = reinterpret_cast<std_srvs__srv__Trigger_Response*>(response);
+
+    // A trace is only triggered again once the previous one was sent
+    static char busy_message[] = "previous trace is still being sent";
+    static char ok_message[] = "trace triggered";
+    res->success = !trace_dump.is_pending();
+    if (res->success)
+    {
+        trace_buffer.trigger();
+    }
+    char* message = res->success ? ok_message : busy_message;
+    res->message.data = message;
+    res->message.size = strlen(message);
+    res->message.capacity = res->message.size + 1;
+}
 
-    // Time synchronization
-    if (millis() - last_time_sync_ms > time_sync_interval)
+/**
+ * @brief Callback function for the autotune service. Identifies and tunes the
+ * motors one after another, the results are applied and stored in the NVS by
+ * the loop.
+ *
+ * @param request Pointer to the std_srvs__srv__Trigger_Request (unused).
+ * @param response Pointer to the std_srvs__srv__Trigger_Response.
+ */
+void autotune_service_callback(const void* request, void* response)
+{
+    (void)request;
+    auto* res = reinterpret_cast<std_srvs__srv__Trigger_Response*>(response);
+
+    static char busy_message[] = "autotune is already running";
+    static char ok_message[] = "autotune started, the robot must be lifted";
+    res->success = !control_task->get_state().autotuning;
+    if (res->success)
     {
-        // Synchronize time with the agent
-        rmw_uros_sync_session(timeout_ms);
+        control_task->start_autotune(AutotuneConfig());
+    }
+    char* message = res->success ? ok_message : busy_message;
+    res->message.data = message;
+    res->message.size = strlen(message);
+    res->message.capacity = res->message.size + 1;
+}
 
-        if (rmw_uros_epoch_synchronized())
-        {
-            // Get time in milliseconds or nanoseconds
-            synced_time_ms = rmw_uros_epoch_millis();
-            synced_time_ns = rmw_uros_epoch_nanos();
-            last_time_sync_ms = millis();
-            last_time_sync_ns = micros() * 1000;
-        }
+/**
+ * @brief Callback function for the faults/clear service. Clears the faults of
+ * all motors, faults whose cause persists are detected again.
+ *
+ * @param request Pointer to the std_srvs__srv__Trigger_Request (unused).
+ * @param response Pointer to the std_srvs__srv__Trigger_Response.
+ */
+void fault_clear_service_callback(const void* request, void* response)
+{
+    (void)request;
+    auto* res = reinterpret_cast<std_srvs__srv__Trigger_Response*>(response);
+
+    static char ok_message[] = "motor faults cleared";
+    control_task->clear_faults();
+    res->success = true;
+    res->message.data = ok_message;
+    res->message.size = strlen(ok_message);
+    res->message.capacity = res->message.size + 1;
+}
+
+/**
+ * @brief Callback function for the config/save service. Stores the current
+ * parameters in the NVS, they replace the compiled defaults from the next boot
+ * on. Refused unless the robot stands still.
+ *
+ * @param request Pointer to the std_srvs__srv__Trigger_Request (unused).
+ * @param response Pointer to the std_srvs__srv__Trigger_Response.
+ */
+void config_save_service_callback(const void* request, void* response)
+{
+    (void)request;
+    auto* res = reinterpret_cast<std_srvs__srv__Trigger_Response*>(response);
+
+    static char moving_message[] = "the robot must stand still to save";
+    static char failed_message[] = "writing the NVS failed";
+    static char ok_message[] = "config saved, hardware changes apply on boot";
+    char* message = moving_message;
+    res->success = false;
+    if (standing_still)
+    {
+        RobotConfig<4> config = config_parameters.get_config();
+        config.gain_schedule = gain_schedule_parameters.get_schedule();
+        res->success = ConfigStore::save(config);
+        message = res->success ? ok_message : failed_message;
     }
+    res->message.data = message;
+    res->message.size = strlen(message);
+    res->message.capacity = res->message.size + 1;
+}
 
-#ifdef DEBUG
-#ifdef DEBUG_TIME
-    // Publish debug time information to diagnostics 1
-    now_debug = millis();
-    dt_debug = (now_debug - last_time_debug) / 1000.0;
-    sprintf(dt_part, "[1]: %f; ", dt_debug);
-    strcat(debug_str, dt_part);
-    last_time_debug = now_debug;
-#endif
-#endif
+/**
+ * @brief Callback function for the config/reset service. Deletes the stored
+ * configuration, the next boot uses the compiled defaults. Refused unless the
+ * robot stands still.
+ *
+ * @param request Pointer to the std_srvs__srv__Trigger_Request (unused).
+ * @param response Pointer to the std_srvs__srv__Trigger_Response.
+ */
+void config_reset_service_callback(const void* request, void* response)
+{
+    (void)request;
+    auto* res = reinterpret_cast<std_srvs__srv__Trigger_Response*>(response);
+
+    static char moving_message[] = "the robot must stand still to reset";
+    static char failed_message[] = "clearing the NVS failed";
+    static char ok_message[] = "config cleared, defaults apply on boot";
+    char* message = moving_message;
+    res->success = false;
+    if (standing_still)
+    {
+        res->success = ConfigStore::clear();
+        message = res->success ? ok_message : failed_message;
+    }
+    res->message.data = message;
+    res->message.size = strlen(message);
+    res->message.capacity = res->message.size + 1;
+}
 
-    RCSOFTCHECK(rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10)));
+/**
+ * @brief Publishes the next chunk of a frozen trace.
+ *
+ */
+void publishTraceChunk()
+{
+    if (trace_dump.is_pending())
+    {
+        RCSOFTCHECK(
+            rcl_publish(&trace_publisher, &trace_dump.next_chunk(), NULL));
+    }
+}
 
-#ifdef DEBUG
-#ifdef DEBUG_TIME
-    // Publish debug time information to diagnostics 2
-    now_debug = millis();
-    dt_debug = (now_debug - last_time_debug) / 1000.0;
-    sprintf(dt_part, "[2]: %f; ", dt_debug);
-    strcat(debug_str, dt_part);
-    last_time_debug = now_debug;
-#endif
-#endif
+#define CREATE(call)                                                           \
+    if ((call) != RCL_RET_OK)                                                  \
+    {                                                                          \
+        return false;                                                          \
+    }
 
-    robot_controller.update();
+// Entities whose fini is not safe on a zero initialized handle
+bool support_created = false;
+bool parameter_server_created = false;
 
-#ifdef DEBUG
-#ifdef DEBUG_TIME
-    // Publish debug time information to diagnostics 3
-    now_debug = millis();
-    dt_debug = (now_debug - last_time_debug) / 1000.0;
-    sprintf(dt_part, "[3]: %f; ", dt_debug);
-    strcat(debug_str, dt_part);
-    last_time_debug = now_debug;
-#endif
-#endif
+/**
+ * @brief Create the micro-ROS entities. Called by the connection manager once
+ * the agent answered.
+ *
+ * @return true If all entities were created.
+ * @return false If one failed, the ones created so far are left to
+ * destroyEntities().
+ */
+bool createEntities()
+{
+    allocator = rcl_get_default_allocator();
 
-    Eigen::Vector3d robot_velocity = robot_controller.get_robot_velocity();
+    // The gain schedule and the configuration are the only parameters
+    rclc_parameter_options_t parameter_options;
+    parameter_options.notify_changed_over_dds = false;
+    parameter_options.max_params = GainScheduleParameters::PARAMETER_COUNT +
+                                   ConfigParameters<4>::PARAMETER_COUNT;
+    parameter_options.allow_undeclared_parameters = false;
+    // Parameters are handled one at a time, which saves the memory of batches
+    parameter_options.low_mem_mode = true;
 
-    // Calculate the delta time for odometry calculation
-    unsigned long now = millis();
-    double dt = (now - last_time) / 1000.0;
-    last_time = now;
+    // clang-format off
+    executor = rclc_executor_get_zero_initialized_executor();
+    CREATE(rclc_support_init(&support, 0, NULL, &allocator));
+    support_created = true;
+    CREATE(rclc_node_init_default(&node, "roboost_pmc_node", "", &support));
+    CREATE(MicroRosTransport::init_publisher(&odom_publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(nav_msgs, msg, Odometry), "odom", ODOM_BEST_EFFORT));
+    CREATE(MicroRosTransport::init_publisher(&joint_state_publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(sensor_msgs, msg, JointState), "joint_states", JOINT_STATE_BEST_EFFORT));
+    CREATE(MicroRosTransport::init_publisher(&wanted_joint_state_publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(sensor_msgs, msg, JointState), "wanted_joint_states", WANTED_JOINT_STATE_BEST_EFFORT));
+    if (TELEMETRY_DECIMATION > 0)
+    {
+        CREATE(MicroRosTransport::init_publisher(&telemetry_publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, UInt8MultiArray), "telemetry", TELEMETRY_BEST_EFFORT));
+    }
+    if (trace_buffer.is_allocated())
+    {
+        CREATE(MicroRosTransport::init_publisher(&trace_publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, UInt8MultiArray), "trace", TRACE_BEST_EFFORT));
+        CREATE(rclc_service_init_default(&trace_trigger_service, &node, ROSIDL_GET_SRV_TYPE_SUPPORT(std_srvs, srv, Trigger), "trace/trigger"));
+    }
+    CREATE(MicroRosTransport::init_publisher(&diagnostic_publisher, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(diagnostic_msgs, msg, DiagnosticStatus), "diagnostics", DIAGNOSTICS_BEST_EFFORT));
+    CREATE(MicroRosTransport::init_subscription(&cmd_vel_subscriber, &node, ROSIDL_GET_MSG_TYPE_SUPPORT(geometry_msgs, msg, Twist), "cmd_vel", CMD_VEL_BEST_EFFORT));
+    CREATE(rclc_service_init_default(&autotune_service, &node, ROSIDL_GET_SRV_TYPE_SUPPORT(std_srvs, srv, Trigger), "autotune"));
+    CREATE(rclc_service_init_default(&config_save_service, &node, ROSIDL_GET_SRV_TYPE_SUPPORT(std_srvs, srv, Trigger), "config/save"));
+    CREATE(rclc_service_init_default(&config_reset_service, &node, ROSIDL_GET_SRV_TYPE_SUPPORT(std_srvs, srv, Trigger), "config/reset"));
+    CREATE(rclc_service_init_default(&fault_clear_service, &node, ROSIDL_GET_SRV_TYPE_SUPPORT(std_srvs, srv, Trigger), "faults/clear"));
+    CREATE(rclc_parameter_server_init_with_option(&parameter_server, &node, &parameter_options));
+    parameter_server_created = true;
+    CREATE(gain_schedule_parameters.declare(&parameter_server));
+    CREATE(config_parameters.declare(&parameter_server));
+    CREATE(rclc_executor_init(&executor, &support.context, 5 + RCLC_EXECUTOR_PARAMETER_SERVER_HANDLES + (trace_buffer.is_allocated() ? 1 : 0), &allocator));
+    CREATE(rclc_executor_add_subscription(&executor, &cmd_vel_subscriber, &twist_msg, &cmd_vel_subscription_callback, ON_NEW_DATA));
+    CREATE(rclc_executor_add_service(&executor, &autotune_service, &autotune_request, &autotune_response, &autotune_service_callback));
+    CREATE(rclc_executor_add_service(&executor, &config_save_service, &config_save_request, &config_save_response, &config_save_service_callback));
+    CREATE(rclc_executor_add_service(&executor, &config_reset_service, &config_reset_request, &config_reset_response, &config_reset_service_callback));
+    CREATE(rclc_executor_add_service(&executor, &fault_clear_service, &fault_clear_request, &fault_clear_response, &fault_clear_service_callback));
+    CREATE(rclc_executor_add_parameter_server_with_context(&executor, &parameter_server, &on_parameter_changed, NULL));
+    if (trace_buffer.is_allocated())
+    {
+        CREATE(rclc_executor_add_service(&executor, &trace_trigger_service, &trace_trigger_request, &trace_trigger_response, &trace_trigger_service_callback));
+    }
+    // clang-format on
+    return true;
+}
 
-    pose(0) += robot_velocity(0) * cos(pose(2)) * dt -
-               robot_velocity(1) * sin(pose(2)) * dt;
-    pose(1) += robot_velocity(0) * sin(pose(2)) * dt +
-               robot_velocity(1) * cos(pose(2)) * dt;
-    pose(2) += robot_velocity(2) * dt;
-    pose(2) = atan2(sin(pose(2)), cos(pose(2)));
+/**
+ * @brief Destroy the micro-ROS entities after the agent was lost or their
+ * creation failed. The agent is not waited for, and the robot is stopped
+ * until the next command arrives over a new session.
+ *
+ */
+void destroyEntities()
+{
+    control_task->set_setpoint(ControlSetpoint());
 
-    odom_msg.pose.pose.position.x = pose(0);
-    odom_msg.pose.pose.position.y = pose(1);
-    // Orientation in quaternion notation
-    odom_msg.pose.pose.orientation.w = cos(pose(2) / 2.0);
-    odom_msg.pose.pose.orientation.z = sin(pose(2) / 2.0);
+    if (support_created)
+    {
+        rmw_context_t* rmw_context =
+            rcl_context_get_rmw_context(&support.context);
+        if (rmw_context != NULL)
+        {
+            (void)rmw_uros_set_context_entity_destroy_session_timeout(
+                rmw_context, 0);
+        }
+    }
 
-    odom_msg.twist.twist.linear.x = robot_velocity(0);
-    odom_msg.twist.twist.linear.y = robot_velocity(1);
-    odom_msg.twist.twist.angular.z = robot_velocity(2);
+    // The fini functions ignore handles which were never initialized
+    (void)rclc_executor_fini(&executor);
+    if (parameter_server_created)
+    {
+        (void)rclc_parameter_server_fini(&parameter_server, &node);
+        parameter_server_created = false;
+    }
+    (void)rcl_service_fini(&trace_trigger_service, &node);
+    (void)rcl_service_fini(&fault_clear_service, &node);
+    (void)rcl_service_fini(&config_reset_service, &node);
+    (void)rcl_service_fini(&config_save_service, &node);
+    (void)rcl_service_fini(&autotune_service, &node);
+    (void)rcl_subscription_fini(&cmd_vel_subscriber, &node);
+    (void)rcl_publisher_fini(&diagnostic_publisher, &node);
+    (void)rcl_publisher_fini(&trace_publisher, &node);
+    (void)rcl_publisher_fini(&telemetry_publisher, &node);
+    (void)rcl_publisher_fini(&wanted_joint_state_publisher, &node);
+    (void)rcl_publisher_fini(&joint_state_publisher, &node);
+    (void)rcl_publisher_fini(&odom_publisher, &node);
+    (void)rcl_node_fini(&node);
+    if (support_created)
+    {
+        (void)rclc_support_fini(&support);
+        support_created = false;
+    }
+}
 
-    odom_msg.header.stamp.sec =
-        (synced_time_ms + millis() - last_time_sync_ms) / 1000;
-    odom_msg.header.stamp.nanosec =
-        synced_time_ns + (micros() * 1000 - last_time_sync_ns);
-    odom_msg.header.stamp.nanosec %= 1000000000; // nanoseconds are in [0, 1e9)
+ConnectionManager connection_manager(&createEntities, &destroyEntities,
+                                     ConnectionConfig{
+                                         AGENT_PING_INTERVAL_MS,
+                                         AGENT_HEARTBEAT_INTERVAL_MS,
+                                         AGENT_PING_TIMEOUT_MS,
+                                         AGENT_HEARTBEAT_ATTEMPTS});
 
-    RCSOFTCHECK(rcl_publish(&odom_publisher, &odom_msg, NULL));
+/**
+ * @brief Setup function for the configuration, the control task and the
+ * micro-ROS transport. Returns within milliseconds, the session with the agent
+ * is brought up by the connection manager in loop().
+ *
+ */
+void setup()
+{
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, LOW);
+
+    // A stored configuration replaces the compiled defaults. Flash is only
+    // read here, the control task receives copies through its buffers.
+    RobotConfig<4> robot_config = createDefaultConfig();
+    // Motors tuned before use their identified gains, and their stiction as
+    // the minimum output, so the parameters show the values in use
+    AutotuneResult autotune_results[4];
+    bool tuned[4];
+    load_stored_config(robot_config, autotune_results, tuned);
+    gain_scales.fill(PIDGains{1, 1, 1});
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        if (tuned[i])
+        {
+            applyAutotuneResult(i, autotune_results[i]);
+        }
+    }
+    config_parameters = ConfigParameters<4>(robot_config);
+    gain_schedule_parameters =
+        GainScheduleParameters(robot_config.gain_schedule);
+    createControlStack(robot_config);
+
+    // Start the control loop first, so the motors are actively held at zero
+    // and the command timeout is watched from power-on, with or without agent
+    control_task->add_gain_scheduled_controller(&controller_M0);
+    control_task->add_gain_scheduled_controller(&controller_M1);
+    control_task->add_gain_scheduled_controller(&controller_M2);
+    control_task->add_gain_scheduled_controller(&controller_M3);
+    control_task->set_gain_schedule(gain_schedule_parameters.get_schedule());
+    control_task->set_gain_scales(gain_scales);
+    control_task->set_telemetry_decimation(TELEMETRY_DECIMATION);
+    // An IMU driver can feed its yaw rate with control_task->set_gyro_rate()
+    control_task->set_odometry_config(OdometryConfig());
+    control_task->set_limits(robot_config.limits);
+    if (TRACE_CAPACITY > 0 &&
+        trace_buffer.allocate(TRACE_CAPACITY, TRACE_POST_TRIGGER))
+    {
+        control_task->set_trace(&trace_buffer, TRACE_TRIGGER_THRESHOLD);
+    }
+    control_task->start();
+
+    // Configure the transport of the selected profile (see conf_transport.h)
+    MicroRosTransport::begin();
+
+    publisher_scheduler.add_topic(ODOM_PUBLISH_RATE, &publishOdometry);
+    publisher_scheduler.add_topic(JOINT_STATE_PUBLISH_RATE,
+                                  &publishJointStates);
+    wanted_joint_state_topic = publisher_scheduler.add_topic(
+        WANTED_JOINT_STATE_PUBLISH_RATE, &publishWantedJointStates,
+        WANTED_JOINT_STATE_MAX_RATE);
+    if (trace_buffer.is_allocated())
+    {
+        publisher_scheduler.add_topic(TRACE_CHUNK_RATE, &publishTraceChunk);
+    }
+}
 
-#ifdef DEBUG
-#ifdef DEBUG_TIME
-    // Publish debug time information to diagnostics 4
-    now_debug = millis();
-    dt_debug = (now_debug - last_time_debug) / 1000.0;
-    sprintf(dt_part, "[4]: %f; [dt]: %f s", dt_debug, dt);
-    strcat(debug_str, dt_part);
-    last_time_debug = now_debug;
-
-    publishDiagnosticMessage(debug_str);
-#endif
-#endif
+/**
+ * @brief Main loop for continuously updating and publishing the robot's
+ * odometry.
+ *
+ */
+void loop()
+{
+    // Brings the session up or down step by step, blocks for at most a ping
+    // or the creation of the entities
+    unsigned long now = millis();
+    const bool connected =
+        connection_manager.update(now) == ConnectionState::CONNECTED;
+    // Solid while connected, blinking while the agent is searched
+    digitalWrite(LED_BUILTIN, connected || (now / 250) % 2 == 0 ? HIGH : LOW);
+
+    if (connected)
+    {
+        {
+            // Time synchronization, blocks the loop once per second for the
+            // round trip to the agent, at most time_sync_timeout_ms
+            ScopedTimer timer(time_sync_histogram);
+            time_sync.update();
+        }
+
+        {
+            ScopedTimer timer(spin_histogram);
+            RCSOFTCHECK(rclc_executor_spin_some(&executor, RCL_MS_TO_NS(1)));
+        }
+    }
+
+    // Apply the gains of tuned motors right away, they are stored once the
+    // robot stands still. The stiction is applied to the minimum output on
+    // the next boot.
+    AutotuneReport autotune_report;
+    while (control_task->pop_autotune_report(autotune_report))
+    {
+        if (autotune_report.state == AutotuneState::DONE)
+        {
+            applyAutotuneResult(autotune_report.motor, autotune_report.result);
+            control_task->set_gain_scales(gain_scales);
+            autotune_pending[autotune_report.motor] = true;
+            autotune_pending_results[autotune_report.motor] =
+                autotune_report.result;
+        }
+    }
 
-    // Update the joint state message
+    uint32_t stage_start = CycleCounter::now();
 
-    Eigen::Vector4d wheel_velocities =
-        kinematics.calculate_wheel_velocity(robot_velocity);
+    // The motors are controlled by the control task, only fetch its state
+    // The pose is integrated by the control task at the control rate
+    const ControlState<4>& control_state = control_task->get_state();
+    const MecanumKinematics4W::WheelVector& wheel_velocities =
+        control_state.measured_wheel_velocities;
+
+    standing_still = !control_state.autotuning &&
+                     control_state.set_wheel_velocities.isZero() &&
+                     wheel_velocities.cwiseAbs().maxCoeff() < STANDSTILL_SPEED;
+    for (uint8_t i = 0; i < 4 && standing_still; i++)
+    {
+        if (autotune_pending[i])
+        {
+            AutotuneStorage::save(i, autotune_pending_results[i]);
+            autotune_pending[i] = false;
+        }
+    }
+
+    // Calculate the delta time for the joint positions
+    now = millis();
+    scalar_t dt = scalar_t(now - last_time) / scalar_t(1000.0);
+    last_time = now;
 
     joint_state_msg.position.data[0] += wheel_velocities(0) * dt;
     joint_state_msg.position.data[1] += wheel_velocities(1) * dt;
     joint_state_msg.position.data[2] += wheel_velocities(2) * dt;
     joint_state_msg.position.data[3] += wheel_velocities(3) * dt;
 
-    joint_state_msg.velocity.data[0] = wheel_velocities(0);
-    joint_state_msg.velocity.data[1] = wheel_velocities(1);
-    joint_state_msg.velocity.data[2] = wheel_velocities(2);
-    joint_state_msg.velocity.data[3] = wheel_velocities(3);
-
-    joint_state_msg.header.stamp.sec = synced_time_ms / 1000;
-    joint_state_msg.header.stamp.nanosec = synced_time_ns;
+    // Only feed states of new control cycles into the decimation windows
+    if (control_state.tick != last_control_tick)
+    {
+        last_control_tick = control_state.tick;
+        odometry_estimate = control_state.odometry;
+        odom_velocity.add(control_state.odometry.velocity);
+        joint_velocities.add(wheel_velocities);
 
-    RCSOFTCHECK(rcl_publish(&joint_state_publisher, &joint_state_msg, NULL));
+        if (control_state.set_wheel_velocities != wanted_wheel_velocities)
+        {
+            wanted_wheel_velocities = control_state.set_wheel_velocities;
+            publisher_scheduler.request(wanted_joint_state_topic);
+        }
+    }
 
-    // Update the wanted joint state message
+    odometry_histogram.record(
+        CycleCounter::to_us(CycleCounter::now() - stage_start));
+    stage_start = CycleCounter::now();
 
-    Eigen::Vector4d wanted_wheel_velocities =
-        robot_controller.get_set_wheel_velocities();
+    if (!connected)
+    {
+        delay(1);
+        return;
+    }
 
-    wanted_joint_state_msg.velocity.data[0] = wanted_wheel_velocities(0);
-    wanted_joint_state_msg.velocity.data[1] = wanted_wheel_velocities(1);
-    wanted_joint_state_msg.velocity.data[2] = wanted_wheel_velocities(2);
-    wanted_joint_state_msg.velocity.data[3] = wanted_wheel_velocities(3);
+    // Publish the topics which are due
+    if (TELEMETRY_DECIMATION > 0)
+    {
+        publishTelemetry();
+    }
+    if (publisher_scheduler.update(micros()) > 0)
+    {
+        publish_histogram.record(
+            CycleCounter::to_us(CycleCounter::now() - stage_start));
+    }
 
-    wanted_joint_state_msg.header.stamp.sec = synced_time_ms / 1000;
-    wanted_joint_state_msg.header.stamp.nanosec = synced_time_ns;
+#ifdef DEBUG
+#ifdef DEBUG_TIME
+    if (now - last_latency_report_time >= latency_report_interval_ms)
+    {
+        last_latency_report_time = now;
+        publishLatencyReport();
+    }
+#endif
+#endif
 
-    RCSOFTCHECK(rcl_publish(&wanted_joint_state_publisher,
-                            &wanted_joint_state_msg, NULL));
+    publishFaultReport(control_state, now);
 
-    delay(10);
+    delay(1);
 }
@@ -0,0 +1,74 @@
+/**
+ * @file drive_stack.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the drive stack.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "drive_stack.hpp"
+#include "conf_hardware.h"
+#include "utils/autotune_storage.hpp"
+
+void set_default_hardware(RobotConfig<4>& config)
+{
+    const MotorConfig motors[4] = {
+        {M0_IN1, M0_IN2, M0_ENA, M0_PWM_CNL, M0_ENC_A, M0_ENC_B,
+         M0_ENC_RESOLUTION, MOTOR_MIN_OUTPUT},
+        {M1_IN1, M1_IN2, M1_ENA, M1_PWM_CNL, M1_ENC_A, M1_ENC_B,
+         M1_ENC_RESOLUTION, MOTOR_MIN_OUTPUT},
+        {M2_IN1, M2_IN2, M2_ENA, M2_PWM_CNL, M2_ENC_A, M2_ENC_B,
+         M2_ENC_RESOLUTION, MOTOR_MIN_OUTPUT},
+        {M3_IN1, M3_IN2, M3_ENA, M3_PWM_CNL, M3_ENC_A, M3_ENC_B,
+         M3_ENC_RESOLUTION, MOTOR_MIN_OUTPUT}};
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        config.motors[i] = motors[i];
+    }
+    config.pwm_frequency = M_PWM_FRQ;
+    config.pwm_resolution = M_PWM_RES;
+    config.wheel_radius = WHEEL_RADIUS;
+    config.wheel_base = WHEEL_BASE;
+    config.track_width = TRACK_WIDTH;
+}
+
+void load_stored_config(RobotConfig<4>& config, AutotuneResult results[4],
+                        bool tuned[4])
+{
+    ConfigStore::load(config);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        tuned[i] = AutotuneStorage::load(i, results[i]);
+        if (tuned[i])
+        {
+            config.motors[i].min_output = results[i].plant.stiction;
+        }
+    }
+}
+
+DriveStack create_drive_stack(const RobotConfig<4>& config,
+                              PIDController* const controllers[4],
+                              FaultMonitor* fault_monitor)
+{
+    DriveStack stack;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        const MotorConfig& motor = config.motors[i];
+        stack.drivers[i] = new L298NMotorDriver(
+            motor.pin_in1, motor.pin_in2, motor.pin_ena, motor.pwm_channel,
+            config.pwm_frequency, config.pwm_resolution);
+        stack.encoders[i] = new EdgeTimingEncoder(
+            motor.encoder_a, motor.encoder_b, motor.encoder_resolution);
+        stack.motor_controllers[i] = new PIDMotorController<>(
+            *stack.drivers[i], *stack.encoders[i], *controllers[i],
+            motor.min_output);
+    }
+    stack.motor_control_manager = new MotorControllerManager{
+        {stack.motor_controllers[0], stack.motor_controllers[1],
+         stack.motor_controllers[2], stack.motor_controllers[3]}};
+    stack.motor_control_manager->set_fault_monitor(fault_monitor);
+    return stack;
+}
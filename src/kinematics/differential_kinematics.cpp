@@ -0,0 +1,22 @@
+/**
+ * @file differential_kinematics.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the DifferentialKinematics class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "kinematics/kinematics.hpp"
+
+DifferentialKinematics::DifferentialKinematics(const float& wheel_radius,
+                                               const float& track_width)
+    : GeometricKinematics<2>(
+          {{{0, scalar_t(track_width / 2.0), 0, scalar_t(M_PI / 2.0),
+             scalar_t(wheel_radius)},
+            {0, scalar_t(-track_width / 2.0), 0, scalar_t(M_PI / 2.0),
+             scalar_t(wheel_radius)}}})
+{
+}
@@ -0,0 +1,84 @@
+/**
+ * @file geometric_kinematics.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the GeometricKinematics class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "kinematics/kinematics.hpp"
+#include <cmath>
+
+template <int WheelCount>
+GeometricKinematics<WheelCount>::GeometricKinematics(const Geometry& geometry)
+{
+    set_geometry(geometry);
+}
+
+template <int WheelCount>
+void GeometricKinematics<WheelCount>::set_geometry(const Geometry& geometry)
+{
+    geometry_ = geometry;
+
+    for (int i = 0; i < WheelCount; ++i)
+    {
+        const WheelGeometry& wheel = geometry[i];
+        const scalar_t roller_direction =
+            wheel.drive_angle + wheel.roller_angle - scalar_t(M_PI / 2.0);
+        const scalar_t n_x = std::cos(roller_direction);
+        const scalar_t n_y = std::sin(roller_direction);
+        const scalar_t scale =
+            scalar_t(1.0) / (wheel.radius * std::sin(wheel.roller_angle));
+
+        forward_kinematics_(i, 0) = n_x * scale;
+        forward_kinematics_(i, 1) = n_y * scale;
+        forward_kinematics_(i, 2) = (wheel.x * n_y - wheel.y * n_x) * scale;
+    }
+
+    // Least squares inverse (J^T J)^-1 J^T. An axis no wheel drives has a
+    // zero column, its diagonal entry is set to 1 so its row of the inverse
+    // becomes 0 and the rest stays regular
+    Matrix3 normal = forward_kinematics_.transpose() * forward_kinematics_;
+    const scalar_t threshold = scalar_t(1e-9) * normal.diagonal().maxCoeff();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (normal(axis, axis) <= threshold)
+        {
+            forward_kinematics_.col(axis).setZero();
+            normal.row(axis).setZero();
+            normal.col(axis).setZero();
+            normal(axis, axis) = 1;
+        }
+    }
+    inverse_kinematics_ = normal.inverse() * forward_kinematics_.transpose();
+}
+
+template <int WheelCount>
+typename GeometricKinematics<WheelCount>::WheelVector
+GeometricKinematics<WheelCount>::calculate_wheel_velocity(
+    const Vector3& robot_velocity)
+{
+    return forward_kinematics_ * robot_velocity;
+}
+
+template <int WheelCount>
+Vector3 GeometricKinematics<WheelCount>::calculate_robot_velocity(
+    const WheelVector& wheel_velocity)
+{
+    return inverse_kinematics_ * wheel_velocity;
+}
+
+template <int WheelCount>
+const typename GeometricKinematics<WheelCount>::Geometry&
+GeometricKinematics<WheelCount>::get_geometry() const
+{
+    return geometry_;
+}
+
+// Supported wheel counts
+template class GeometricKinematics<2>;
+template class GeometricKinematics<3>;
+template class GeometricKinematics<4>;
@@ -10,45 +10,33 @@
  */
 #include "kinematics/kinematics.hpp"
 
-MecanumKinematics4W::MecanumKinematics4W(const float& wheel_radius,
-                                         const float& wheel_base,
-                                         const float& track_width)
-    : wheel_radius_(wheel_radius), wheel_base_(wheel_base),
-      track_width_(track_width)
+/**
+ * @brief Geometry of a mecanum drive. The motors of the right wheels are
+ * mounted mirrored, so these roll backwards for positive wheel velocities.
+ */
+static GeometricKinematics<4>::Geometry
+mecanum_geometry(const float& wheel_radius, const float& wheel_base,
+                 const float& track_width)
 {
-
-    const double l = wheel_base / 2.0 + track_width / 2.0;
+    const scalar_t x = scalar_t(wheel_base / 2.0);
+    const scalar_t y = scalar_t(track_width / 2.0);
+    const scalar_t r = scalar_t(wheel_radius);
+    const scalar_t forward = 0;
+    const scalar_t backward = scalar_t(M_PI);
+    const scalar_t roller = scalar_t(M_PI / 4.0);
 
     // clang-format off
-    forward_kinematics_ << 1, -1, -l,
-                           -1, -1, -l,
-                           1, 1, -l,
-                           -1, 1, -l;
-
-    inverse_kinematics_ << 1, -1, 1, -1, 
-                           -1, -1, 1, 1, 
-                           -1/l, -1/l, -1/l, -1/l;
+    return {{{ x,  y, forward,   roller, r},
+             { x, -y, backward, -roller, r},
+             {-x,  y, forward,  -roller, r},
+             {-x, -y, backward,  roller, r}}};
     // clang-format on
 }
 
-Eigen::VectorXd MecanumKinematics4W::calculate_wheel_velocity(
-    const Eigen::Vector3d& robot_velocity)
+MecanumKinematics4W::MecanumKinematics4W(const float& wheel_radius,
+                                         const float& wheel_base,
+                                         const float& track_width)
+    : GeometricKinematics<4>(
+          mecanum_geometry(wheel_radius, wheel_base, track_width))
 {
-    Eigen::VectorXd wheel_velocity(4);
-
-    wheel_velocity = forward_kinematics_ * robot_velocity;
-    wheel_velocity *= 1 / wheel_radius_;
-
-    return wheel_velocity;
 }
-
-Eigen::Vector3d MecanumKinematics4W::calculate_robot_velocity(
-    const Eigen::VectorXd& wheel_velocity)
-{
-    Eigen::Vector3d robot_velocity;
-
-    robot_velocity = inverse_kinematics_ * wheel_velocity;
-    robot_velocity *= wheel_radius_ / 4.0;
-
-    return robot_velocity;
-}
\ No newline at end of file
@@ -0,0 +1,134 @@
+/**
+ * @file odometry.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the Odometry class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "kinematics/odometry.hpp"
+#include <algorithm>
+#include <cmath>
+
+Odometry::Odometry(const OdometryConfig& config) : config_(config) {}
+
+void Odometry::update(const Vector3& velocity, const scalar_t dt)
+{
+    if (dt <= 0)
+    {
+        return;
+    }
+
+    const scalar_t distance = std::hypot(velocity(0), velocity(1)) * dt;
+    const scalar_t angle = std::abs(velocity(2)) * dt;
+    integrate(velocity, dt,
+              config_.rotation_noise * angle + config_.drift_noise * distance);
+}
+
+void Odometry::update(const Vector3& velocity, const scalar_t gyro_rate,
+                      const scalar_t dt)
+{
+    if (dt <= 0)
+    {
+        return;
+    }
+
+    // The gyro only reads its bias while the wheels stand still
+    const bool standstill =
+        std::abs(velocity(0)) < config_.standstill_velocity &&
+        std::abs(velocity(1)) < config_.standstill_velocity &&
+        std::abs(velocity(2)) < config_.standstill_velocity;
+    if (standstill && config_.gyro_bias_time_constant > 0)
+    {
+        const scalar_t weight =
+            std::min(dt / config_.gyro_bias_time_constant, scalar_t(1.0));
+        gyro_bias_ += weight * (gyro_rate - gyro_bias_);
+    }
+
+    const scalar_t gyro_weight =
+        std::clamp(config_.gyro_weight, scalar_t(0.0), scalar_t(1.0));
+    Vector3 fused = velocity;
+    fused(2) = standstill ? scalar_t(0.0)
+                          : gyro_weight * (gyro_rate - gyro_bias_) +
+                                (1 - gyro_weight) * velocity(2);
+
+    // The heading variance of the blend, the wheel part grows with the motion
+    const scalar_t distance = std::hypot(velocity(0), velocity(1)) * dt;
+    const scalar_t angle = std::abs(fused(2)) * dt;
+    const scalar_t wheel_variance =
+        config_.rotation_noise * angle + config_.drift_noise * distance;
+    integrate(fused, dt,
+              gyro_weight * gyro_weight * config_.gyro_noise * dt +
+                  (1 - gyro_weight) * (1 - gyro_weight) * wheel_variance);
+}
+
+const OdometryEstimate& Odometry::get_estimate() const { return estimate_; }
+
+scalar_t Odometry::get_gyro_bias() const { return gyro_bias_; }
+
+void Odometry::set_config(const OdometryConfig& config) { config_ = config; }
+
+const OdometryConfig& Odometry::get_config() const { return config_; }
+
+void Odometry::reset(const Vector3& pose)
+{
+    estimate_ = OdometryEstimate();
+    estimate_.pose = pose;
+}
+
+void Odometry::integrate(const Vector3& velocity, const scalar_t dt,
+                         const scalar_t heading_variance)
+{
+    const scalar_t heading_change = velocity(2) * dt;
+
+    // sin(dth) / dth and (1 - cos(dth)) / dth, by their series close to 0
+    scalar_t a, b;
+    if (std::abs(heading_change) < scalar_t(1e-4))
+    {
+        a = 1 - heading_change * heading_change / 6;
+        b = heading_change / 2;
+    }
+    else
+    {
+        a = std::sin(heading_change) / heading_change;
+        b = (1 - std::cos(heading_change)) / heading_change;
+    }
+    const scalar_t body_dx = (a * velocity(0) - b * velocity(1)) * dt;
+    const scalar_t body_dy = (b * velocity(0) + a * velocity(1)) * dt;
+
+    Vector3& pose = estimate_.pose;
+    const scalar_t cos_theta = std::cos(pose(2));
+    const scalar_t sin_theta = std::sin(pose(2));
+    const scalar_t dx = cos_theta * body_dx - sin_theta * body_dy;
+    const scalar_t dy = sin_theta * body_dx + cos_theta * body_dy;
+
+    pose(0) += dx;
+    pose(1) += dy;
+    pose(2) += heading_change;
+    pose(2) = std::atan2(std::sin(pose(2)), std::cos(pose(2)));
+
+    // The position change depends on the heading at the start of the cycle
+    Matrix3 jacobian = Matrix3::Identity();
+    jacobian(0, 2) = -dy;
+    jacobian(1, 2) = dx;
+
+    // Slip moves the robot in any direction, proportional to the distance
+    const scalar_t position_variance =
+        config_.translation_noise * std::hypot(body_dx, body_dy);
+    Matrix3& covariance = estimate_.pose_covariance;
+    covariance = jacobian * covariance * jacobian.transpose();
+    covariance(0, 0) += position_variance;
+    covariance(1, 1) += position_variance;
+    covariance(2, 2) += heading_variance;
+
+    estimate_.velocity = velocity;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        estimate_.velocity_variance(i) =
+            config_.velocity_variance +
+            config_.velocity_noise * velocity(i) * velocity(i);
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * @file omni_kinematics_3w.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the OmniKinematics3W class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "kinematics/kinematics.hpp"
+#include <cmath>
+
+/**
+ * @brief Geometry of three omni wheels at 120 degrees, rolling tangentially.
+ */
+static GeometricKinematics<3>::Geometry omni_geometry(const float& wheel_radius,
+                                                      const float& base_radius)
+{
+    GeometricKinematics<3>::Geometry geometry;
+    for (int i = 0; i < 3; ++i)
+    {
+        const scalar_t angle = scalar_t(i * 2.0 * M_PI / 3.0);
+        geometry[i].x = scalar_t(base_radius) * std::cos(angle);
+        geometry[i].y = scalar_t(base_radius) * std::sin(angle);
+        geometry[i].drive_angle = angle + scalar_t(M_PI / 2.0);
+        geometry[i].roller_angle = scalar_t(M_PI / 2.0);
+        geometry[i].radius = scalar_t(wheel_radius);
+    }
+    return geometry;
+}
+
+OmniKinematics3W::OmniKinematics3W(const float& wheel_radius,
+                                   const float& base_radius)
+    : GeometricKinematics<3>(omni_geometry(wheel_radius, base_radius))
+{
+}
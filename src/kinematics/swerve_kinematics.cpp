@@ -0,0 +1,133 @@
+/**
+ * @file swerve_kinematics.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the SwerveKinematics class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "kinematics/kinematics.hpp"
+#include <cmath>
+
+/**
+ * @brief Wrap an angle to (-pi, pi].
+ */
+static scalar_t wrap_angle(scalar_t angle)
+{
+    const scalar_t pi = scalar_t(M_PI);
+    while (angle > pi)
+    {
+        angle -= 2 * pi;
+    }
+    while (angle <= -pi)
+    {
+        angle += 2 * pi;
+    }
+    return angle;
+}
+
+template <int WheelCount>
+SwerveKinematics<WheelCount>::SwerveKinematics(const Geometry& geometry)
+    : geometry_(geometry)
+{
+    // Contact point velocities (vx - wz * y, vy + wz * x) of all modules,
+    // the robot velocity is their least squares fit
+    Eigen::Matrix<scalar_t, 2 * WheelCount, 3> contact_velocity;
+    for (int i = 0; i < WheelCount; ++i)
+    {
+        // clang-format off
+        contact_velocity.row(2 * i) << 1, 0, -geometry[i].y;
+        contact_velocity.row(2 * i + 1) << 0, 1, geometry[i].x;
+        // clang-format on
+    }
+    const Matrix3 normal = contact_velocity.transpose() * contact_velocity;
+    inverse_kinematics_ = normal.inverse() * contact_velocity.transpose();
+
+    set_steer_angles(WheelVector::Zero());
+}
+
+template <int WheelCount>
+typename SwerveKinematics<WheelCount>::WheelVector
+SwerveKinematics<WheelCount>::calculate_wheel_velocity(
+    const Vector3& robot_velocity)
+{
+    WheelVector wheel_velocity;
+    for (int i = 0; i < WheelCount; ++i)
+    {
+        const WheelGeometry& module = geometry_[i];
+        const scalar_t v_x = robot_velocity(0) - robot_velocity(2) * module.y;
+        const scalar_t v_y = robot_velocity(1) + robot_velocity(2) * module.x;
+        const scalar_t speed = std::hypot(v_x, v_y);
+        if (speed < scalar_t(1e-6))
+        {
+            // No direction to steer to, keep the angle
+            wheel_velocity(i) = 0;
+            continue;
+        }
+
+        scalar_t angle = wrap_angle(std::atan2(v_y, v_x) - module.drive_angle);
+        wheel_velocity(i) = speed / module.radius;
+        if (std::abs(wrap_angle(angle - steer_angles_(i))) >
+            scalar_t(M_PI / 2.0))
+        {
+            // Reversing the wheel is the shorter way
+            angle = wrap_angle(angle + scalar_t(M_PI));
+            wheel_velocity(i) = -wheel_velocity(i);
+        }
+        steer_angles_(i) = angle;
+        directions_(0, i) = v_x / speed;
+        directions_(1, i) = v_y / speed;
+        if (wheel_velocity(i) < 0)
+        {
+            directions_.col(i) = -directions_.col(i);
+        }
+    }
+    return wheel_velocity;
+}
+
+template <int WheelCount>
+Vector3 SwerveKinematics<WheelCount>::calculate_robot_velocity(
+    const WheelVector& wheel_velocity)
+{
+    Eigen::Matrix<scalar_t, 2 * WheelCount, 1> contact_velocity;
+    for (int i = 0; i < WheelCount; ++i)
+    {
+        const scalar_t speed = wheel_velocity(i) * geometry_[i].radius;
+        contact_velocity(2 * i) = speed * directions_(0, i);
+        contact_velocity(2 * i + 1) = speed * directions_(1, i);
+    }
+    return inverse_kinematics_ * contact_velocity;
+}
+
+template <int WheelCount>
+bool SwerveKinematics<WheelCount>::is_linear() const
+{
+    return false;
+}
+
+template <int WheelCount>
+const typename SwerveKinematics<WheelCount>::WheelVector&
+SwerveKinematics<WheelCount>::get_steer_angles() const
+{
+    return steer_angles_;
+}
+
+template <int WheelCount>
+void SwerveKinematics<WheelCount>::set_steer_angles(
+    const WheelVector& steer_angles)
+{
+    for (int i = 0; i < WheelCount; ++i)
+    {
+        steer_angles_(i) = wrap_angle(steer_angles(i));
+        const scalar_t direction = steer_angles_(i) + geometry_[i].drive_angle;
+        directions_(0, i) = std::cos(direction);
+        directions_(1, i) = std::sin(direction);
+    }
+}
+
+// Supported module counts
+template class SwerveKinematics<3>;
+template class SwerveKinematics<4>;
@@ -0,0 +1,240 @@
+/**
+ * @file autotune.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the MotorAutotuner class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "motor-control/autotune.hpp"
+#include <algorithm>
+#include <cmath>
+
+MotorAutotuner::MotorAutotuner(const AutotuneConfig& config) : config_(config)
+{
+}
+
+void MotorAutotuner::start(const AutotuneConfig& config)
+{
+    config_ = config;
+    result_ = AutotuneResult();
+    starting_ = true;
+    stiction_found_ = false;
+}
+
+void MotorAutotuner::abort()
+{
+    starting_ = false;
+    state_ = AutotuneState::IDLE;
+}
+
+scalar_t MotorAutotuner::update(const scalar_t rotation_speed,
+                                const ControlTick& tick)
+{
+    if (starting_)
+    {
+        starting_ = false;
+        enter(AutotuneState::STOP, tick.timestamp_us);
+    }
+    const scalar_t elapsed =
+        scalar_t(tick.timestamp_us - phase_start_us_) * scalar_t(1e-6);
+
+    switch (state_)
+    {
+    case AutotuneState::STICTION:
+    {
+        const scalar_t output = std::min(elapsed * config_.ramp_rate,
+                                         scalar_t(1.0));
+        if (rotation_speed < -config_.motion_threshold)
+        {
+            // Positive outputs must turn the motor forward
+            enter(AutotuneState::FAILED, tick.timestamp_us);
+            return 0;
+        }
+        if (rotation_speed > config_.motion_threshold)
+        {
+            if (output >= config_.step_output)
+            {
+                enter(AutotuneState::FAILED, tick.timestamp_us);
+                return 0;
+            }
+            // The breakaway is detected late, the encoder needs edges to
+            // measure the speed. Lower the output slowly from here instead.
+            breakaway_output_ = output;
+            enter(AutotuneState::RELEASE, tick.timestamp_us);
+            return output;
+        }
+        if (output >= 1)
+        {
+            // The motor does not turn, or the encoder is not connected
+            enter(AutotuneState::FAILED, tick.timestamp_us);
+            return 0;
+        }
+        return output;
+    }
+    case AutotuneState::RELEASE:
+    {
+        const scalar_t output =
+            breakaway_output_ - elapsed * config_.release_rate;
+        if (rotation_speed < config_.motion_threshold)
+        {
+            result_.plant.stiction = output;
+            stiction_found_ = true;
+            enter(AutotuneState::STOP, tick.timestamp_us);
+            return 0;
+        }
+        if (output <= 0)
+        {
+            // The motor turns without an output
+            enter(AutotuneState::FAILED, tick.timestamp_us);
+            return 0;
+        }
+        return output;
+    }
+    case AutotuneState::STOP:
+        if (elapsed >= config_.stop_duration &&
+            std::abs(rotation_speed) < config_.motion_threshold)
+        {
+            // Both excitations start from standstill
+            if (!stiction_found_)
+            {
+                enter(AutotuneState::STICTION, tick.timestamp_us);
+                return 0;
+            }
+            enter(AutotuneState::STEP, tick.timestamp_us);
+            return config_.step_output;
+        }
+        if (elapsed >= 10 * config_.stop_duration)
+        {
+            enter(AutotuneState::FAILED, tick.timestamp_us);
+        }
+        return 0;
+    case AutotuneState::STEP:
+    {
+        // Sample k is taken at k * step_duration / SAMPLE_COUNT
+        const scalar_t interval = config_.step_duration / SAMPLE_COUNT;
+        while (sample_count_ < SAMPLE_COUNT &&
+               elapsed >= sample_count_ * interval)
+        {
+            samples_[sample_count_++] = rotation_speed;
+        }
+        if (sample_count_ < SAMPLE_COUNT)
+        {
+            return config_.step_output;
+        }
+        enter(identify() ? AutotuneState::DONE : AutotuneState::FAILED,
+              tick.timestamp_us);
+        return 0;
+    }
+    default:
+        return 0;
+    }
+}
+
+AutotuneState MotorAutotuner::get_state() const { return state_; }
+
+bool MotorAutotuner::is_running() const
+{
+    return starting_ || state_ == AutotuneState::STICTION ||
+           state_ == AutotuneState::RELEASE || state_ == AutotuneState::STOP ||
+           state_ == AutotuneState::STEP;
+}
+
+const AutotuneResult& MotorAutotuner::get_result() const { return result_; }
+
+AutotuneResult MotorAutotuner::tune(const PlantModel& plant,
+                                    const AutotuneConfig& config)
+{
+    AutotuneResult result;
+    result.plant = plant;
+
+    const scalar_t closed_loop_time_constant =
+        std::max(config.closed_loop_ratio * plant.time_constant,
+                 plant.dead_time);
+    const scalar_t horizon = closed_loop_time_constant + plant.dead_time;
+    result.pid.kp = plant.time_constant / (plant.gain * horizon);
+    result.pid.ki =
+        result.pid.kp / std::min(plant.time_constant, 4 * horizon);
+    result.pid.kd = 0;
+
+    result.feed_forward.pid = result.pid;
+    result.feed_forward.kv = scalar_t(1.0) / plant.gain;
+    result.feed_forward.ks = plant.stiction;
+    return result;
+}
+
+void MotorAutotuner::enter(const AutotuneState state,
+                           const unsigned long timestamp_us)
+{
+    state_ = state;
+    phase_start_us_ = timestamp_us;
+    sample_count_ = 0;
+}
+
+bool MotorAutotuner::identify()
+{
+    // The final speed is the mean of the last eighth, which must not differ
+    // much from the eighth before if the response has settled
+    const uint16_t window = SAMPLE_COUNT / 8;
+    scalar_t final_speed = 0;
+    scalar_t previous_speed = 0;
+    for (uint16_t i = 0; i < window; i++)
+    {
+        final_speed += samples_[SAMPLE_COUNT - window + i];
+        previous_speed += samples_[SAMPLE_COUNT - 2 * window + i];
+    }
+    final_speed /= window;
+    previous_speed /= window;
+    if (final_speed <= config_.motion_threshold ||
+        std::abs(final_speed - previous_speed) > scalar_t(0.02) * final_speed)
+    {
+        return false;
+    }
+
+    const scalar_t t28 = get_crossing_time(scalar_t(0.283) * final_speed);
+    const scalar_t t63 = get_crossing_time(scalar_t(0.632) * final_speed);
+    if (t28 < 0 || t63 <= t28)
+    {
+        return false;
+    }
+
+    PlantModel plant;
+    plant.time_constant = scalar_t(1.5) * (t63 - t28);
+    plant.dead_time = std::max(t63 - plant.time_constant, scalar_t(0.0));
+
+    // The motor fell below the motion threshold at the stiction plus the
+    // output for the threshold, threshold / K with K = final / (step -
+    // stiction), minus what the output fell while the motor lagged behind
+    const scalar_t release_output = result_.plant.stiction;
+    const scalar_t lag = config_.release_rate *
+                         (plant.time_constant + plant.dead_time);
+    const scalar_t threshold_ratio = config_.motion_threshold / final_speed;
+    plant.stiction = std::max(
+        (release_output + lag - threshold_ratio * config_.step_output) /
+            (1 - threshold_ratio),
+        scalar_t(0.0));
+    plant.gain = final_speed / (config_.step_output - plant.stiction);
+    result_ = tune(plant, config_);
+    return true;
+}
+
+scalar_t MotorAutotuner::get_crossing_time(const scalar_t level) const
+{
+    const scalar_t interval = config_.step_duration / SAMPLE_COUNT;
+    for (uint16_t i = 1; i < SAMPLE_COUNT; i++)
+    {
+        if (samples_[i] >= level)
+        {
+            const scalar_t rise = samples_[i] - samples_[i - 1];
+            const scalar_t fraction =
+                rise > 0 ? (level - samples_[i - 1]) / rise : scalar_t(1.0);
+            return (i - 1 + std::clamp(fraction, scalar_t(0.0),
+                                       scalar_t(1.0))) *
+                   interval;
+        }
+    }
+    return -1;
+}
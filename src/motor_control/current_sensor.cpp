@@ -0,0 +1,29 @@
+/**
+ * @file current_sensor.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the AnalogCurrentSensor class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "motor-control/current_sensor.hpp"
+#include <Arduino.h>
+#include <cmath>
+
+AnalogCurrentSensor::AnalogCurrentSensor(const uint8_t pin,
+                                         const scalar_t sense_resistance,
+                                         const scalar_t offset)
+    : pin_(pin), amps_per_millivolt_(scalar_t(1e-3) / sense_resistance),
+      offset_(offset)
+{
+}
+
+scalar_t AnalogCurrentSensor::read_current()
+{
+    const scalar_t current =
+        scalar_t(analogReadMilliVolts(pin_)) * amps_per_millivolt_ - offset_;
+    return std::abs(current);
+}
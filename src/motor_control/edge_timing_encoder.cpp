@@ -0,0 +1,106 @@
+/**
+ * @file edge_timing_encoder.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the EdgeTimingEncoder class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "motor-control/encoder.hpp"
+
+EdgeTimingEncoder::EdgeTimingEncoder(const u_int8_t& pin_A,
+                                     const u_int8_t& pin_B,
+                                     const u_int16_t& resolution,
+                                     const bool reverse,
+                                     const uint32_t standstill_timeout)
+    : pin_B_(pin_B), step_increment_(scalar_t(2.0 * PI / resolution)),
+      reverse_(reverse), standstill_timeout_(standstill_timeout)
+{
+    // GPIOs 34 to 39 are input only and have no internal pull resistors
+    pinMode(pin_A, pin_A < 34 ? INPUT_PULLDOWN : INPUT);
+    pinMode(pin_B, pin_B < 34 ? INPUT_PULLDOWN : INPUT);
+    attachInterruptArg(digitalPinToInterrupt(pin_A),
+                       &EdgeTimingEncoder::handle_edge, this, FALLING);
+}
+
+void IRAM_ATTR EdgeTimingEncoder::handle_edge(void* encoder)
+{
+    EdgeTimingEncoder* self = static_cast<EdgeTimingEncoder*>(encoder);
+    const uint32_t now = micros();
+    const int8_t direction = digitalRead(self->pin_B_) == LOW ? 1 : -1;
+
+    portENTER_CRITICAL_ISR(&self->mux_);
+    self->edge_count_ += direction;
+    self->last_edge_period_ = now - self->last_edge_time_;
+    self->last_edge_time_ = now;
+    self->last_edge_direction_ = direction;
+    portEXIT_CRITICAL_ISR(&self->mux_);
+}
+
+scalar_t EdgeTimingEncoder::get_angle() { return position_; }
+
+scalar_t EdgeTimingEncoder::get_velocity() { return velocity_; }
+
+int32_t EdgeTimingEncoder::get_count() { return window_count_; }
+
+void EdgeTimingEncoder::update(const ControlTick& tick)
+{
+    portENTER_CRITICAL(&mux_);
+    const int32_t count = edge_count_;
+    const uint32_t edge_time = last_edge_time_;
+    const uint32_t edge_period = last_edge_period_;
+    const int8_t edge_direction = last_edge_direction_;
+    portEXIT_CRITICAL(&mux_);
+
+    const scalar_t sign = reverse_ ? scalar_t(-1.0) : scalar_t(1.0);
+    const int32_t delta_count = count - window_count_;
+    const uint32_t edge_interval = edge_time - window_edge_time_;
+
+    if (delta_count != 0 && edge_interval > 0 &&
+        edge_interval <= standstill_timeout_)
+    {
+        // M/T method: edges since the last update over the exact time
+        // between the respective last edges
+        velocity_ = sign * scalar_t(delta_count) * step_increment_ /
+                    (scalar_t(edge_interval) * scalar_t(1e-6));
+    }
+    else if (delta_count != 0)
+    {
+        // First edges after standstill, only the period of the last two
+        // edges is meaningful
+        velocity_ = edge_period > 0 && edge_period <= standstill_timeout_
+                        ? sign * scalar_t(edge_direction) * step_increment_ /
+                              (scalar_t(edge_period) * scalar_t(1e-6))
+                        : scalar_t(0.0);
+    }
+    else
+    {
+        // T method: without a new edge the wheel turns at most one step per
+        // time since the last edge
+        const uint32_t since_edge = uint32_t(tick.timestamp_us) - window_edge_time_;
+        if (since_edge > standstill_timeout_)
+        {
+            velocity_ = scalar_t(0.0);
+        }
+        else
+        {
+            const scalar_t bound =
+                step_increment_ / (scalar_t(since_edge) * scalar_t(1e-6));
+            if (std::abs(velocity_) > bound)
+            {
+                velocity_ = std::copysign(bound, velocity_);
+            }
+        }
+    }
+
+    if (delta_count != 0)
+    {
+        window_count_ = count;
+        window_edge_time_ = edge_time;
+    }
+
+    position_ = sign * scalar_t(count) * step_increment_;
+}
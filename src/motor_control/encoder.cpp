@@ -10,24 +10,23 @@ HalfQuadEncoder::HalfQuadEncoder(const u_int8_t& pin_A, const u_int8_t& pin_B,
     step_increment_ = 2.0 * PI / resolution_;
 }
 
-double HalfQuadEncoder::get_angle() { return position_; }
+scalar_t HalfQuadEncoder::get_angle() { return position_; }
 
-double HalfQuadEncoder::get_velocity() { return velocity_; }
+scalar_t HalfQuadEncoder::get_velocity() { return velocity_; }
 
-void HalfQuadEncoder::update()
-{
-    unsigned long current_time = micros();
-    double elapsed_time = (current_time - last_time_) * 1e-6;
+int32_t HalfQuadEncoder::get_count() { return int32_t(prev_count_); }
 
+void HalfQuadEncoder::update(const ControlTick& tick)
+{
     int64_t count = encoder_.getCount();
 
-    double position_change =
-        ((count - prev_count_) * step_increment_) * (reverse_ ? -1.0 : 1.0);
+    scalar_t position_change =
+        (scalar_t(count - prev_count_) * step_increment_) *
+        (reverse_ ? scalar_t(-1.0) : scalar_t(1.0));
 
-    position_ = count * step_increment_;
+    position_ = scalar_t(count) * step_increment_;
 
-    velocity_ = position_change / elapsed_time;
+    velocity_ = position_change / tick.dt;
 
-    last_time_ = current_time;
     prev_count_ = count;
 }
\ No newline at end of file
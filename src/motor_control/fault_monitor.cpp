@@ -0,0 +1,123 @@
+/**
+ * @file fault_monitor.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the FaultMonitor class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "motor-control/fault_monitor.hpp"
+#include <algorithm>
+#include <cmath>
+
+FaultMonitor::FaultMonitor(const uint8_t motor_count,
+                           const FaultConfig& config)
+    : config_(config), motors_(motor_count)
+{
+}
+
+void FaultMonitor::set_current_sensor(const uint8_t motor_index,
+                                      CurrentSensor* sensor)
+{
+    if (motor_index < motors_.size())
+    {
+        motors_[motor_index].current_sensor = sensor;
+    }
+}
+
+scalar_t FaultMonitor::check(const uint8_t motor_index, const scalar_t output,
+                             const scalar_t speed, const ControlTick& tick)
+{
+    MotorState& motor = motors_[motor_index];
+    const scalar_t dt = tick.dt;
+    const scalar_t magnitude = std::abs(output);
+    const scalar_t abs_speed = std::abs(speed);
+    const scalar_t previous_speed = std::abs(motor.previous_speed);
+    const bool driving = magnitude >= config_.stall_output;
+    const bool standing = abs_speed < config_.stall_speed;
+
+    // Checked on the requested output, so a derated motor stays stalled until
+    // it turns or the controller backs off
+    motor.stall_time = driving && standing ? motor.stall_time + dt : 0;
+    if (motor.stall_time >= config_.stall_time)
+    {
+        motor.faults |= MOTOR_FAULT_STALL;
+    }
+    else if (motor.stall_time == 0)
+    {
+        motor.faults &= ~MOTOR_FAULT_STALL;
+    }
+
+    // A wheel driven forward cannot stop within a cycle, its encoder can
+    if (driving && standing && output * motor.previous_speed > 0 &&
+        previous_speed - abs_speed > config_.max_deceleration * dt)
+    {
+        motor.faults |= MOTOR_FAULT_ENCODER_LOSS;
+    }
+
+    // Braking also drives against the speed, but only until the wheel stops
+    motor.reversal_time =
+        driving && output * speed < 0 && abs_speed >= config_.reversal_speed
+            ? motor.reversal_time + dt
+            : 0;
+    if (motor.reversal_time >= config_.reversal_time)
+    {
+        motor.faults |= MOTOR_FAULT_REVERSAL;
+    }
+
+    // One sensor per cycle, each is read every motor count cycles
+    if (motor.current_sensor != nullptr &&
+        tick.index % motors_.size() == motor_index)
+    {
+        motor.current = motor.current_sensor->read_current();
+        motor.overcurrent_time =
+            config_.max_current > 0 && motor.current > config_.max_current
+                ? motor.overcurrent_time + scalar_t(motors_.size()) * dt
+                : 0;
+        if (motor.overcurrent_time >= config_.current_time)
+        {
+            motor.faults |= MOTOR_FAULT_OVERCURRENT;
+        }
+    }
+
+    motor.previous_speed = speed;
+
+    if (motor.faults & MOTOR_FAULTS_LATCHED)
+    {
+        return scalar_t(0.0);
+    }
+    if (motor.faults & MOTOR_FAULT_STALL)
+    {
+        return std::clamp(output, -config_.derate_output,
+                          config_.derate_output);
+    }
+    return output;
+}
+
+uint8_t FaultMonitor::get_faults(const uint8_t motor_index) const
+{
+    return motors_[motor_index].faults;
+}
+
+scalar_t FaultMonitor::get_current(const uint8_t motor_index) const
+{
+    return motors_[motor_index].current;
+}
+
+void FaultMonitor::clear_faults()
+{
+    for (MotorState& motor : motors_)
+    {
+        motor.faults = MOTOR_FAULT_NONE;
+        motor.stall_time = 0;
+        motor.reversal_time = 0;
+        motor.overcurrent_time = 0;
+    }
+}
+
+void FaultMonitor::set_config(const FaultConfig& config) { config_ = config; }
+
+const FaultConfig& FaultMonitor::get_config() const { return config_; }
@@ -13,23 +13,25 @@
 
 MotorControllerManager::MotorControllerManager(
     std::initializer_list<MotorController*> motor_controllers)
+    : motor_controllers_(motor_controllers),
+      desired_speeds_(motor_controllers.size(), scalar_t(0.0)),
+      measured_speeds_(motor_controllers.size(), scalar_t(0.0)),
+      outputs_(motor_controllers.size(), scalar_t(0.0)),
+      overridden_(motor_controllers.size(), 0),
+      output_overrides_(motor_controllers.size(), scalar_t(0.0))
 {
-    for (MotorController* motor_controller : motor_controllers)
-    {
-        motor_controllers_.push_back({motor_controller, 0.0f});
-    }
 }
 
 MotorControllerManager::~MotorControllerManager()
 {
-    for (std::pair<MotorController*, float>& pair : motor_controllers_)
+    for (MotorController* motor_controller : motor_controllers_)
     {
-        delete pair.first;
+        delete motor_controller;
     }
 }
 
 void MotorControllerManager::set_motor_speed(const uint8_t motor_index,
-                                             float desired_speed)
+                                             scalar_t desired_speed)
 {
     if (motor_index < 0 || motor_index >= motor_controllers_.size())
     {
@@ -37,28 +39,29 @@ void MotorControllerManager::set_motor_speed(const uint8_t motor_index,
     }
     else
     {
-        motor_controllers_[motor_index].second = desired_speed;
+        desired_speeds_[motor_index] = desired_speed;
     }
 }
 
-void MotorControllerManager::set_all_motor_speeds(const float desired_speed)
+void MotorControllerManager::set_all_motor_speeds(const scalar_t desired_speed)
 {
-    for (std::pair<MotorController*, float>& pair : motor_controllers_)
+    for (scalar_t& speed : desired_speeds_)
     {
-        pair.second = desired_speed;
+        speed = desired_speed;
     }
 }
 
-float MotorControllerManager::get_motor_speed(const uint8_t motor_index) const
+scalar_t
+MotorControllerManager::get_motor_speed(const uint8_t motor_index) const
 {
     if (motor_index < 0 || motor_index >= motor_controllers_.size())
     {
         Serial.println("Invalid motor index");
-        return 0.0f;
+        return scalar_t(0.0);
     }
     else
     {
-        return motor_controllers_[motor_index].first->get_rotation_speed();
+        return measured_speeds_[motor_index];
     }
 }
 
@@ -67,21 +70,87 @@ uint8_t MotorControllerManager::get_motor_count() const
     return motor_controllers_.size();
 }
 
-void MotorControllerManager::update()
+void MotorControllerManager::get_telemetry(const uint8_t motor_index,
+                                           MotorTelemetry& telemetry) const
+{
+    telemetry.setpoint = desired_speeds_[motor_index];
+    telemetry.measured = measured_speeds_[motor_index];
+    telemetry.output = outputs_[motor_index];
+    motor_controllers_[motor_index]->get_telemetry(telemetry);
+}
+
+void MotorControllerManager::set_output_override(const uint8_t motor_index,
+                                                 const scalar_t output)
 {
-    int i = 0;
-    for (std::pair<MotorController*, float>& pair : motor_controllers_)
+    if (motor_index >= motor_controllers_.size())
+    {
+        Serial.println("Invalid motor index");
+        return;
+    }
+    output_overrides_[motor_index] = output;
+    overridden_[motor_index] = 1;
+}
+
+void MotorControllerManager::clear_output_override(const uint8_t motor_index)
+{
+    if (motor_index >= motor_controllers_.size())
+    {
+        Serial.println("Invalid motor index");
+        return;
+    }
+    overridden_[motor_index] = 0;
+}
+
+void MotorControllerManager::set_fault_monitor(FaultMonitor* fault_monitor)
+{
+    fault_monitor_ = fault_monitor;
+}
+
+uint8_t MotorControllerManager::get_faults(const uint8_t motor_index) const
+{
+    if (fault_monitor_ == nullptr || motor_index >= motor_controllers_.size())
+    {
+        return MOTOR_FAULT_NONE;
+    }
+    return fault_monitor_->get_faults(motor_index);
+}
+
+void MotorControllerManager::clear_faults()
+{
+    if (fault_monitor_ != nullptr)
+    {
+        fault_monitor_->clear_faults();
+    }
+}
+
+void MotorControllerManager::update(const ControlTick& tick)
+{
+    const size_t motor_count = motor_controllers_.size();
+
+    // Latch the feedback of all motors at the same time
+    for (size_t i = 0; i < motor_count; i++)
+    {
+        motor_controllers_[i]->sample(tick);
+    }
+
+    for (size_t i = 0; i < motor_count; i++)
+    {
+        outputs_[i] =
+            overridden_[i]
+                ? output_overrides_[i]
+                : motor_controllers_[i]->compute(desired_speeds_[i], tick);
+        measured_speeds_[i] = motor_controllers_[i]->get_rotation_speed();
+        if (fault_monitor_ != nullptr)
+        {
+            // A faulty motor is derated or cut in the cycle of the detection
+            outputs_[i] = fault_monitor_->check(i, outputs_[i],
+                                                measured_speeds_[i], tick);
+        }
+    }
+
+    // Commit all outputs back to back
+    for (size_t i = 0; i < motor_count; i++)
     {
-        // Serial.print(">motor ");
-        // Serial.print(i);
-        // Serial.print(" setpoint:");
-        // Serial.println(pair.second);
-        // Serial.print(">motor ");
-        // Serial.print(i);
-        // Serial.print(" measured:");
-        // Serial.println(pair.first->get_rotation_speed());
-
-        pair.first->set_rotation_speed(pair.second);
-        i++;
+        motor_controllers_[i]->apply(outputs_[i]);
     }
 }
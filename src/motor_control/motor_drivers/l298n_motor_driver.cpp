@@ -10,13 +10,54 @@
  */
 #include "motor-control/motor-drivers/l298n_motor_driver.hpp"
 #include <Arduino.h>
+#include <algorithm>
+#include <soc/gpio_struct.h>
+
+/**
+ * @brief Set or clear an output pin through the GPIO set and clear registers,
+ * without the overhead of digitalWrite().
+ *
+ * @param pin The pin, outputs are 0 to 33.
+ * @param level The level to set.
+ */
+static inline void write_pin(const uint8_t pin, const bool level)
+{
+    if (pin < 32)
+    {
+        const uint32_t mask = uint32_t(1) << pin;
+        if (level)
+        {
+            GPIO.out_w1ts = mask;
+        }
+        else
+        {
+            GPIO.out_w1tc = mask;
+        }
+    }
+    else
+    {
+        const uint32_t mask = uint32_t(1) << (pin - 32);
+        if (level)
+        {
+            GPIO.out1_w1ts.val = mask;
+        }
+        else
+        {
+            GPIO.out1_w1tc.val = mask;
+        }
+    }
+}
 
 L298NMotorDriver::L298NMotorDriver(const uint8_t& pin_in1,
                                    const uint8_t& pin_in2,
                                    const uint8_t& pin_ena,
-                                   const uint8_t& pwm_channel)
+                                   const uint8_t& pwm_channel,
+                                   const uint32_t pwm_frequency,
+                                   const uint8_t pwm_resolution,
+                                   const StopMode stop_mode)
     : pin_in1_(pin_in1), pin_in2_(pin_in2), pin_ena_(pin_ena),
-      pwm_channel_(pwm_channel)
+      pwm_channel_(pwm_channel), pwm_resolution_(pwm_resolution),
+      stop_mode_(stop_mode)
 {
     // Initialize L298N...
     // setting pin modes
@@ -24,29 +65,69 @@ L298NMotorDriver::L298NMotorDriver(const uint8_t& pin_in1,
     pinMode(pin_in2_, OUTPUT);
     pinMode(pin_ena_, OUTPUT);
 
-    // setting PWM properties
-    const uint16_t freq = 5000;
-    const uint8_t resolution = 8;
-
-    // configure PWM functionalities
-    ledcSetup(pwm_channel_, freq, resolution);
+    // configure PWM functionalities, the timer clock divided by 2^resolution
+    // must reach the frequency
+    while (ledcSetup(pwm_channel_, pwm_frequency, pwm_resolution_) == 0 &&
+           pwm_resolution_ > 1)
+    {
+        pwm_resolution_--;
+    }
+    max_duty_ = (uint32_t(1) << pwm_resolution_) - 1;
 
     // attach the channel to the GPIO to be controlled
     ledcAttachPin(pin_ena_, pwm_channel_);
+
+    apply(BridgeState::COAST, 0);
 }
 
-void L298NMotorDriver::set_motor_control(float control_value)
+void L298NMotorDriver::set_motor_control(scalar_t control_value)
 {
     // control_value should be between -1 and 1
-    control_value = (control_value < -1.0) ? -1.0 : control_value;
-    control_value = (control_value > 1.0) ? 1.0 : control_value;
-
-    // Set direction for L298N...
-    bool direction = control_value >= 0;
-    digitalWrite(pin_in1_, direction ? HIGH : LOW);
-    digitalWrite(pin_in2_, direction ? LOW : HIGH);
-
-    // Set PWM for L298N...
-    u_int8_t pwm = static_cast<int>(std::abs(control_value) * 255);
-    ledcWrite(pwm_channel_, pwm);
-}
\ No newline at end of file
+    control_value = std::clamp(control_value, scalar_t(-1.0), scalar_t(1.0));
+
+    const uint32_t duty =
+        uint32_t(std::abs(control_value) * scalar_t(max_duty_) + scalar_t(0.5));
+    if (duty == 0)
+    {
+        stop_mode_ == StopMode::BRAKE ? brake() : coast();
+        return;
+    }
+
+    apply(control_value > 0 ? BridgeState::FORWARD : BridgeState::BACKWARD,
+          duty);
+}
+
+void L298NMotorDriver::brake()
+{
+    // Fast motor stop: equal inputs with the bridge enabled
+    apply(BridgeState::BRAKE, max_duty_);
+}
+
+void L298NMotorDriver::coast() { apply(BridgeState::COAST, 0); }
+
+void L298NMotorDriver::set_stop_mode(const StopMode stop_mode)
+{
+    stop_mode_ = stop_mode;
+}
+
+uint8_t L298NMotorDriver::get_pwm_resolution() const
+{
+    return pwm_resolution_;
+}
+
+void L298NMotorDriver::apply(const BridgeState state, const uint32_t duty)
+{
+    if (state != state_)
+    {
+        // Brake and coast both keep the inputs low, they differ in the duty
+        write_pin(pin_in1_, state == BridgeState::FORWARD);
+        write_pin(pin_in2_, state == BridgeState::BACKWARD);
+        state_ = state;
+    }
+
+    if (duty != duty_)
+    {
+        ledcWrite(pwm_channel_, duty);
+        duty_ = duty;
+    }
+}
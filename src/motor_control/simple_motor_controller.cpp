@@ -15,22 +15,23 @@
 #include <algorithm>
 
 SimpleMotorController::SimpleMotorController(MotorDriver& motor_driver,
-                                             float max_rotation_speed)
+                                             scalar_t max_rotation_speed)
     : MotorController(motor_driver), max_rotation_speed_(max_rotation_speed)
 {
 }
 
-void SimpleMotorController::set_rotation_speed(float desired_rotation_speed)
+scalar_t SimpleMotorController::compute(scalar_t desired_rotation_speed,
+                                        const ControlTick& tick)
 {
     desired_rotation_speed = std::clamp(
         desired_rotation_speed, -max_rotation_speed_, max_rotation_speed_);
 
     rotation_speed_setpoint_ = desired_rotation_speed / max_rotation_speed_;
 
-    motor_driver_.set_motor_control(rotation_speed_setpoint_);
+    return rotation_speed_setpoint_;
 }
 
-float SimpleMotorController::get_rotation_speed()
+scalar_t SimpleMotorController::get_rotation_speed()
 {
     return rotation_speed_setpoint_;
 }
\ No newline at end of file
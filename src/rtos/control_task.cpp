@@ -0,0 +1,443 @@
+/**
+ * @file control_task.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the ControlTask class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "rtos/control_task.hpp"
+#include <algorithm>
+#include <cmath>
+
+template <int WheelCount>
+ControlTask<WheelCount>::ControlTask(
+    VelocityController<WheelCount>& velocity_controller,
+    const uint16_t frequency, const BaseType_t core,
+    const UBaseType_t priority, const uint32_t stack_size,
+    const ControlRates& rates)
+    : velocity_controller_(velocity_controller),
+      period_ticks_(std::max<TickType_t>(1, configTICK_RATE_HZ / frequency)),
+      period_us_(period_ticks_ * (1000000 / configTICK_RATE_HZ)),
+      timing_window_(std::max<uint16_t>(1, configTICK_RATE_HZ / period_ticks_)),
+      core_(core), priority_(priority), stack_size_(stack_size),
+      // Staggered, the kinematics follow the setpoint one cycle later
+      setpoint_group_(configTICK_RATE_HZ / period_ticks_, rates.setpoint, 0),
+      kinematics_group_(configTICK_RATE_HZ / period_ticks_, rates.kinematics,
+                        1),
+      motor_group_(configTICK_RATE_HZ / period_ticks_, rates.motors, 0),
+      odometry_group_(configTICK_RATE_HZ / period_ticks_, rates.odometry, 3),
+      cycle_histogram_(std::max<uint32_t>(1, period_us_ / 64)),
+      period_histogram_(std::max<uint32_t>(1, period_us_ / 16))
+{
+    gain_scales_.fill(PIDGains{1, 1, 1});
+}
+
+template <int WheelCount>
+bool ControlTask<WheelCount>::add_gain_scheduled_controller(
+    PIDController* controller)
+{
+    if (gain_scheduled_controller_count_ >= WheelCount)
+    {
+        return false;
+    }
+    gain_scheduled_controllers_[gain_scheduled_controller_count_++] =
+        controller;
+    return true;
+}
+
+template <int WheelCount>
+bool ControlTask<WheelCount>::start()
+{
+    if (task_handle_ != nullptr)
+    {
+        return true;
+    }
+
+    return xTaskCreatePinnedToCore(&ControlTask::task_entry, "control",
+                                   stack_size_, this, priority_, &task_handle_,
+                                   core_) == pdPASS;
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::set_setpoint(const ControlSetpoint& setpoint)
+{
+    setpoint_buffer_.write(setpoint);
+}
+
+template <int WheelCount>
+bool ControlTask<WheelCount>::set_gain_schedule(const GainSchedule& schedule)
+{
+    if (!schedule.is_valid())
+    {
+        return false;
+    }
+    gain_schedule_buffer_.write(schedule);
+    return true;
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::set_gain_scales(const GainScales& scales)
+{
+    gain_scales_buffer_.write(scales);
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::start_autotune(const AutotuneConfig& config)
+{
+    autotune_buffer_.write(config);
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::clear_faults()
+{
+    fault_clear_buffer_.write(true);
+}
+
+template <int WheelCount>
+bool ControlTask<WheelCount>::pop_autotune_report(AutotuneReport& report)
+{
+    return autotune_reports_.pop(report);
+}
+
+template <int WheelCount>
+const ControlState<WheelCount>& ControlTask<WheelCount>::get_state()
+{
+    return state_buffer_.read();
+}
+
+template <int WheelCount>
+TickType_t ControlTask<WheelCount>::get_period_ticks() const
+{
+    return period_ticks_;
+}
+
+template <int WheelCount>
+uint32_t ControlTask<WheelCount>::get_allocation_count() const
+{
+    return HeapMonitor::get_allocation_count();
+}
+
+template <int WheelCount>
+bool ControlTask<WheelCount>::get_timing(ControlTiming& timing)
+{
+    return timing_buffer_.read(timing);
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::set_telemetry_decimation(
+    const uint16_t decimation)
+{
+    telemetry_decimation_ = decimation;
+}
+
+template <int WheelCount>
+bool ControlTask<WheelCount>::pop_telemetry(
+    TelemetrySample<WheelCount>& sample)
+{
+    return telemetry_buffer_.pop(sample);
+}
+
+template <int WheelCount>
+uint32_t ControlTask<WheelCount>::get_telemetry_drop_count() const
+{
+    return telemetry_buffer_.get_drop_count();
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::set_trace(
+    TraceBuffer<TraceRecord<WheelCount>>* trace,
+    const scalar_t error_threshold)
+{
+    trace_ = trace;
+    trace_error_threshold_ = error_threshold;
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::set_limits(const ControlLimits& limits)
+{
+    limits_buffer_.write(limits);
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::set_odometry_config(const OdometryConfig& config,
+                                                  const uint32_t gyro_timeout)
+{
+    odometry_.set_config(config);
+    gyro_timeout_ = gyro_timeout;
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::set_gyro_rate(const scalar_t rate)
+{
+    GyroSample sample;
+    sample.rate = rate;
+    sample.timestamp_us = micros();
+    gyro_buffer_.write(sample);
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::update_autotune(
+    const ControlState<WheelCount>& state, const ControlTick& tick)
+{
+    const uint8_t motor = autotune_motor_;
+    const scalar_t output =
+        autotuner_.update(state.measured_wheel_velocities(motor), tick);
+    if (autotuner_.is_running())
+    {
+        velocity_controller_.set_output_override(motor, output);
+        return;
+    }
+
+    // Hand the motor back to a controller without a history of the tuning
+    velocity_controller_.clear_output_override(motor);
+    if (motor < gain_scheduled_controller_count_)
+    {
+        gain_scheduled_controllers_[motor]->reset();
+    }
+
+    AutotuneReport report;
+    report.motor = motor;
+    report.state = autotuner_.get_state();
+    report.result = autotuner_.get_result();
+    autotune_reports_.push(report);
+
+    autotune_motor_++;
+    if (autotune_motor_ < WheelCount)
+    {
+        autotuner_.start(autotune_config_);
+    }
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::task_entry(void* parameter)
+{
+    static_cast<ControlTask*>(parameter)->run();
+}
+
+template <int WheelCount>
+void ControlTask<WheelCount>::run()
+{
+    // Every allocation from here on is counted, the control path must not
+    // touch the heap
+    HeapMonitor::watch_current_task();
+
+    ControlSetpoint setpoint;
+    ControlLimits limits;
+    ControlState<WheelCount> state;
+    ControlTiming timing;
+    TelemetrySample<WheelCount> telemetry;
+    TraceRecord<WheelCount> trace_record;
+    ControlTick control_tick;
+    GyroSample gyro;
+    bool has_gyro = false;
+    const scalar_t nominal_dt = scalar_t(period_us_) * scalar_t(1e-6);
+    TickType_t last_wake_time = xTaskGetTickCount();
+    uint32_t last_wake_cycles = CycleCounter::now();
+
+    while (true)
+    {
+        const uint32_t wake_cycles = CycleCounter::now();
+        if (state.tick > 0)
+        {
+            const uint32_t period =
+                CycleCounter::to_us(wake_cycles - last_wake_cycles);
+            period_histogram_.record(period);
+            if (period > period_us_ + period_us_ / 2)
+            {
+                deadline_misses_++;
+            }
+        }
+        last_wake_cycles = wake_cycles;
+
+        // One timestamp and sampling time for all stages of the cycle
+        advance_tick(control_tick, micros(), nominal_dt);
+
+        if (limits_buffer_.read(limits))
+        {
+            setpoint_generator_.set_limits(limits.setpoint);
+            velocity_controller_.set_wheel_speed_limits(
+                VelocityController<WheelCount>::WheelVector::Constant(
+                    limits.max_wheel_speed));
+            velocity_controller_.set_saturation_policy(
+                limits.saturation_policy);
+        }
+        if (setpoint_buffer_.read(setpoint))
+        {
+            setpoint_generator_.set_target(setpoint.velocity,
+                                           control_tick.timestamp_us);
+        }
+        if (autotune_buffer_.read(autotune_config_) &&
+            autotune_motor_ >= WheelCount)
+        {
+            autotune_motor_ = 0;
+            autotuner_.start(autotune_config_);
+        }
+        state.autotuning = autotune_motor_ < WheelCount;
+        if (gain_schedule_buffer_.read(gain_schedule_))
+        {
+            gain_scheduling_ = true;
+        }
+        gain_scales_buffer_.read(gain_scales_);
+
+        if (setpoint_group_.begin(control_tick))
+        {
+            state.setpoint_velocity =
+                setpoint_generator_.update(setpoint_group_.get_tick());
+            state.command_timed_out = setpoint_generator_.is_timed_out();
+            setpoint_group_.end();
+        }
+
+        if (kinematics_group_.begin(control_tick))
+        {
+            if (state.autotuning)
+            {
+                velocity_controller_.set_latest_command(Vector3::Zero());
+            }
+            else
+            {
+                velocity_controller_.set_latest_command(
+                    state.setpoint_velocity);
+            }
+            velocity_controller_.update_wheel_setpoints();
+            state.set_wheel_velocities =
+                velocity_controller_.get_set_wheel_velocities();
+            state.saturation_scale =
+                velocity_controller_.get_saturation_scale();
+            kinematics_group_.end();
+        }
+
+        if (motor_group_.begin(control_tick))
+        {
+            const ControlTick& motor_tick = motor_group_.get_tick();
+            if (state.autotuning)
+            {
+                update_autotune(state, motor_tick);
+            }
+
+            // Schedule on the wheel speeds of the previous run, the gains
+            // change at the motor rate and without bumps
+            if (gain_scheduling_)
+            {
+                const scalar_t twist_magnitude =
+                    gain_schedule_.get_twist_magnitude(state.setpoint_velocity);
+                for (uint8_t i = 0; i < gain_scheduled_controller_count_; i++)
+                {
+                    PIDGains gains = gain_schedule_.evaluate(
+                        state.measured_wheel_velocities(i), twist_magnitude);
+                    gains.kp *= gain_scales_[i].kp;
+                    gains.ki *= gain_scales_[i].ki;
+                    gains.kd *= gain_scales_[i].kd;
+                    gain_scheduled_controllers_[i]->set_gains(gains);
+                }
+            }
+
+            bool clear_requested;
+            if (fault_clear_buffer_.read(clear_requested) && clear_requested)
+            {
+                velocity_controller_.clear_motor_faults();
+            }
+            velocity_controller_.update_motors(motor_tick);
+
+            state.measured_wheel_velocities =
+                velocity_controller_.get_actual_wheel_velocities();
+            for (uint8_t i = 0; i < WheelCount; i++)
+            {
+                state.motor_faults[i] =
+                    velocity_controller_.get_motor_faults(i);
+            }
+            motor_group_.end();
+        }
+
+        if (odometry_group_.begin(control_tick))
+        {
+            const ControlTick& odometry_tick = odometry_group_.get_tick();
+            velocity_controller_.update_robot_velocity();
+            state.robot_velocity = velocity_controller_.get_robot_velocity();
+
+            // A rate written during this cycle has a negative age
+            has_gyro = gyro_buffer_.read(gyro) || has_gyro;
+            const long gyro_age =
+                long(odometry_tick.timestamp_us - gyro.timestamp_us);
+            if (has_gyro && gyro_age <= long(gyro_timeout_))
+            {
+                odometry_.update(state.robot_velocity, gyro.rate,
+                                 odometry_tick.dt);
+            }
+            else
+            {
+                odometry_.update(state.robot_velocity, odometry_tick.dt);
+            }
+            state.odometry = odometry_.get_estimate();
+            odometry_group_.end();
+        }
+        state_buffer_.write(state);
+
+        const bool record_telemetry = telemetry_decimation_ > 0 &&
+                                      state.tick % telemetry_decimation_ == 0;
+        if (record_telemetry || trace_ != nullptr)
+        {
+            telemetry.tick = state.tick;
+            for (uint8_t i = 0; i < WheelCount; i++)
+            {
+                velocity_controller_.get_motor_telemetry(
+                    i, telemetry.motors[i]);
+            }
+        }
+        if (record_telemetry)
+        {
+            telemetry_buffer_.push(telemetry);
+        }
+        if (trace_ != nullptr)
+        {
+            trace_record.timestamp_us = uint32_t(control_tick.timestamp_us);
+            for (uint8_t i = 0; i < WheelCount; i++)
+            {
+                const MotorTelemetry& motor = telemetry.motors[i];
+                trace_record.setpoint[i] = float(motor.setpoint);
+                trace_record.measured[i] = float(motor.measured);
+                trace_record.output[i] = float(motor.output);
+                trace_record.integral[i] = float(motor.i_term);
+                if (trace_error_threshold_ > 0 &&
+                    std::abs(motor.setpoint - motor.measured) >
+                        trace_error_threshold_)
+                {
+                    trace_->trigger();
+                }
+            }
+            trace_->write(trace_record);
+        }
+        state.tick++;
+
+        cycle_histogram_.record(
+            CycleCounter::to_us(CycleCounter::now() - wake_cycles));
+        if (cycle_histogram_.get_count() >= timing_window_)
+        {
+            timing.cycle = cycle_histogram_.get_summary();
+            timing.period = period_histogram_.get_summary();
+            timing.deadline_misses = deadline_misses_;
+            timing.setpoint = setpoint_group_.get_timing();
+            timing.kinematics = kinematics_group_.get_timing();
+            timing.motors = motor_group_.get_timing();
+            timing.odometry = odometry_group_.get_timing();
+            timing_buffer_.write(timing);
+            cycle_histogram_.reset();
+            period_histogram_.reset();
+            deadline_misses_ = 0;
+            setpoint_group_.reset_timing();
+            kinematics_group_.reset_timing();
+            motor_group_.reset_timing();
+            odometry_group_.reset_timing();
+        }
+
+        // Sleep until the next period. The wake time is advanced by exactly
+        // one period, so the rate does not drift with the loop duration.
+        vTaskDelayUntil(&last_wake_time, period_ticks_);
+    }
+}
+
+// Supported wheel counts
+template class ControlTask<4>;
@@ -0,0 +1,76 @@
+/**
+ * @file rate_group.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the RateGroup class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "rtos/rate_group.hpp"
+#include <algorithm>
+
+/**
+ * @brief Get the number of base cycles per run, rounded to the nearest. A
+ * group never runs faster than the base rate.
+ */
+static uint16_t get_rate_divisor(const uint16_t base_frequency,
+                                 const uint16_t frequency)
+{
+    if (frequency == 0 || frequency >= base_frequency)
+    {
+        return 1;
+    }
+    return (base_frequency + frequency / 2) / frequency;
+}
+
+RateGroup::RateGroup(const uint16_t base_frequency,
+                     const RateGroupConfig& config, const uint16_t offset)
+    : divisor_(get_rate_divisor(base_frequency, config.frequency)),
+      offset_(offset % divisor_), deadline_us_(config.deadline_us),
+      nominal_dt_(scalar_t(divisor_) / scalar_t(base_frequency)),
+      duration_histogram_(std::max<uint32_t>(1, config.deadline_us / 16))
+{
+}
+
+bool RateGroup::begin(const ControlTick& tick)
+{
+    if (tick.index % divisor_ != offset_)
+    {
+        return false;
+    }
+    start_cycles_ = CycleCounter::now();
+    advance_tick(tick_, tick.timestamp_us, nominal_dt_);
+    return true;
+}
+
+void RateGroup::end()
+{
+    const uint32_t duration =
+        CycleCounter::to_us(CycleCounter::now() - start_cycles_);
+    duration_histogram_.record(duration);
+    if (deadline_us_ > 0 && duration > deadline_us_)
+    {
+        overruns_++;
+    }
+}
+
+const ControlTick& RateGroup::get_tick() const { return tick_; }
+
+uint16_t RateGroup::get_divisor() const { return divisor_; }
+
+RateGroupTiming RateGroup::get_timing() const
+{
+    RateGroupTiming timing;
+    timing.duration = duration_histogram_.get_summary();
+    timing.overruns = overruns_;
+    return timing;
+}
+
+void RateGroup::reset_timing()
+{
+    duration_histogram_.reset();
+    overruns_ = 0;
+}
@@ -0,0 +1,516 @@
+/**
+ * @file control_benchmark.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Host benchmark of the control stack with simulated motors.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Build and run with the native-benchmark and native-benchmark-float
+ * environments, e.g. pio run -e native-benchmark -t exec. The ns/op of the
+ * filters, the PID controller, the kinematics and a full control cycle are
+ * printed, followed by the tracking of a simulated step response. With --step
+ * only the step response is printed as CSV. With --autotune the motors are
+ * identified as by the autotune of the control task, and the step response is
+ * compared between the default and the tuned gains. With --replay <file.csv>
+ * the setpoints of a Teleplot recording are replayed on the wheels, and the
+ * tracking of the recorded and the simulated wheels, the MotorFault flags of
+ * the simulated wheels and the time per control cycle are printed as one JSON
+ * object.
+ *
+ * The times are those of the host, compare them between commits on the same
+ * machine. The cycle counts on the ESP32 are measured by scalar_benchmark.cpp.
+ *
+ */
+
+#include <Arduino.h>
+#include <string.h>
+#include <vector>
+
+#include "conf_hardware.h"
+#include "kinematics/kinematics.hpp"
+#include "kinematics/odometry.hpp"
+#include "motor-control/autotune.hpp"
+#include "motor-control/encoder.hpp"
+#include "motor-control/fault_monitor.hpp"
+#include "motor-control/motor_control_manager.hpp"
+#include "motor-control/pid_motor_controller.hpp"
+#include "sim/benchmark.hpp"
+#include "sim/dc_motor_plant.hpp"
+#include "sim/sim_hal.hpp"
+#include "sim/teleplot_trace.hpp"
+#include "utils/control_tick.h"
+#include "utils/controllers.hpp"
+#include "utils/filters.hpp"
+#include "utils/setpoint_generator.hpp"
+#include "utils/tracking_metrics.hpp"
+#include "velocity_controller.hpp"
+
+static const uint32_t PERIOD_US = 1000000 / CONTROL_TASK_FREQUENCY;
+static const scalar_t NOMINAL_DT = scalar_t(PERIOD_US) * scalar_t(1e-6);
+static const uint16_t INPUT_COUNT = 256; // Power of two
+
+DCMotorPlant plant_M0(M0_ENC_A, M0_ENC_B, M0_ENC_RESOLUTION);
+DCMotorPlant plant_M1(M1_ENC_A, M1_ENC_B, M1_ENC_RESOLUTION);
+DCMotorPlant plant_M2(M2_ENC_A, M2_ENC_B, M2_ENC_RESOLUTION);
+DCMotorPlant plant_M3(M3_ENC_A, M3_ENC_B, M3_ENC_RESOLUTION);
+DCMotorPlant* plants[] = {&plant_M0, &plant_M1, &plant_M2, &plant_M3};
+
+// Same control stack as in core.cpp, with the plants as motor drivers
+EdgeTimingEncoder encoder_M0(M0_ENC_A, M0_ENC_B, M0_ENC_RESOLUTION);
+EdgeTimingEncoder encoder_M1(M1_ENC_A, M1_ENC_B, M1_ENC_RESOLUTION);
+EdgeTimingEncoder encoder_M2(M2_ENC_A, M2_ENC_B, M2_ENC_RESOLUTION);
+EdgeTimingEncoder encoder_M3(M3_ENC_A, M3_ENC_B, M3_ENC_RESOLUTION);
+
+PIDController controller_M0(0.105, 0.125, 0.005, 0.2, 5.2);
+PIDController controller_M1(0.105, 0.125, 0.005, 0.2, 5.2);
+PIDController controller_M2(0.105, 0.125, 0.005, 0.2, 5.2);
+PIDController controller_M3(0.105, 0.125, 0.005, 0.2, 5.2);
+
+static const scalar_t MIN_OUTPUT = 0.35;
+
+PIDMotorController<> motor_controller_M0(plant_M0, encoder_M0, controller_M0,
+                                         MIN_OUTPUT);
+PIDMotorController<> motor_controller_M1(plant_M1, encoder_M1, controller_M1,
+                                         MIN_OUTPUT);
+PIDMotorController<> motor_controller_M2(plant_M2, encoder_M2, controller_M2,
+                                         MIN_OUTPUT);
+PIDMotorController<> motor_controller_M3(plant_M3, encoder_M3, controller_M3,
+                                         MIN_OUTPUT);
+PIDController* controllers[] = {&controller_M0, &controller_M1,
+                                &controller_M2, &controller_M3};
+PIDMotorController<>* motor_controllers[] = {
+    &motor_controller_M0, &motor_controller_M1, &motor_controller_M2,
+    &motor_controller_M3};
+
+// The manager deletes its controllers when destroyed, which never happens on
+// the target, keep it alive past the exit of main() as well
+MotorControllerManager& motor_control_manager = *new MotorControllerManager{
+    {&motor_controller_M0, &motor_controller_M1, &motor_controller_M2,
+     &motor_controller_M3}};
+
+MecanumKinematics4W kinematics(WHEEL_RADIUS, WHEEL_BASE, TRACK_WIDTH);
+VelocityController<4> robot_controller(motor_control_manager, &kinematics);
+
+ControlTick control_tick;
+scalar_t inputs[INPUT_COUNT];
+
+/**
+ * @brief Advance the plants and the simulated time by one control period,
+ * then run one control cycle on the new encoder counts.
+ *
+ */
+void run_control_cycle()
+{
+    for (DCMotorPlant* plant : plants)
+    {
+        plant->step(PERIOD_US * 1e-6);
+    }
+    SimHal::advance_time(PERIOD_US);
+    advance_tick(control_tick, micros(), NOMINAL_DT);
+    robot_controller.update(control_tick);
+}
+
+/**
+ * @brief Run a step of the commanded velocity from standstill.
+ *
+ * @param command The commanded robot velocity.
+ * @param duration The duration in s.
+ * @param print_csv Whether to print every cycle as CSV.
+ * @param mean_error Set to the mean wheel speed error in the last quarter.
+ * @return scalar_t The largest wheel speed error in the last quarter.
+ */
+scalar_t run_step_response(const Vector3& command, const double duration,
+                           const bool print_csv, scalar_t& mean_error)
+{
+    const uint32_t cycles = uint32_t(duration * 1e6 / PERIOD_US);
+    scalar_t max_error = 0;
+    scalar_t error_sum = 0;
+
+    if (print_csv)
+    {
+        printf("time,set0,set1,set2,set3,measured0,measured1,measured2,"
+               "measured3\n");
+    }
+
+    robot_controller.set_latest_command(command);
+    for (uint32_t i = 0; i < cycles; i++)
+    {
+        run_control_cycle();
+
+        const auto set = robot_controller.get_set_wheel_velocities();
+        const auto measured = robot_controller.get_actual_wheel_velocities();
+        if (print_csv)
+        {
+            printf("%.6f,%f,%f,%f,%f,%f,%f,%f,%f\n",
+                   control_tick.timestamp_us * 1e-6, double(set(0)),
+                   double(set(1)), double(set(2)), double(set(3)),
+                   double(measured(0)), double(measured(1)),
+                   double(measured(2)), double(measured(3)));
+        }
+        if (i >= cycles * 3 / 4)
+        {
+            const auto error = (set - measured).cwiseAbs();
+            max_error = std::max(max_error, error.maxCoeff());
+            error_sum += error.mean();
+        }
+    }
+    mean_error = error_sum / scalar_t(cycles - cycles * 3 / 4);
+    return max_error;
+}
+
+/**
+ * @brief Measure both directions of a kinematics model.
+ *
+ * @param name The name of the model.
+ * @param model The model.
+ */
+template <int WheelCount>
+void run_kinematics_benchmarks(const char* name, Kinematics<WheelCount>& model)
+{
+    char label[64];
+    snprintf(label, sizeof(label), "%s::wheel_velocity", name);
+    Benchmark::run(label, [&](uint64_t i) {
+        const Vector3 command(inputs[i % INPUT_COUNT],
+                              inputs[(i + 64) % INPUT_COUNT],
+                              inputs[(i + 128) % INPUT_COUNT]);
+        do_not_optimize(model.calculate_wheel_velocity(command));
+    });
+
+    snprintf(label, sizeof(label), "%s::robot_velocity", name);
+    Benchmark::run(label, [&](uint64_t i) {
+        typename Kinematics<WheelCount>::WheelVector wheels;
+        for (int j = 0; j < WheelCount; j++)
+        {
+            wheels(j) = inputs[(i + 32 * j) % INPUT_COUNT];
+        }
+        do_not_optimize(model.calculate_robot_velocity(wheels));
+    });
+}
+
+void run_benchmarks()
+{
+    Benchmark::print_header();
+
+    LowPassFilter low_pass(10.0, NOMINAL_DT);
+    Benchmark::run("LowPassFilter::update", [&](uint64_t i) {
+        do_not_optimize(low_pass.update(inputs[i % INPUT_COUNT]));
+    });
+    Benchmark::run("LowPassFilter::update(dt)", [&](uint64_t i) {
+        do_not_optimize(low_pass.update(inputs[i % INPUT_COUNT], NOMINAL_DT));
+    });
+
+    MovingAverageFilter<8> moving_average;
+    Benchmark::run("MovingAverageFilter<8>::update", [&](uint64_t i) {
+        do_not_optimize(moving_average.update(inputs[i % INPUT_COUNT]));
+    });
+
+    MedianFilter<5> median;
+    Benchmark::run("MedianFilter<5>::update", [&](uint64_t i) {
+        do_not_optimize(median.update(inputs[i % INPUT_COUNT]));
+    });
+
+    FilterChain<MedianFilter<5>, LowPassFilter> chain(
+        MedianFilter<5>(), LowPassFilter(10.0, NOMINAL_DT));
+    Benchmark::run("FilterChain<Median<5>, LowPass>", [&](uint64_t i) {
+        do_not_optimize(chain.update(inputs[i % INPUT_COUNT], NOMINAL_DT));
+    });
+
+    PIDController pid(0.105, 0.125, 0.005, 0.2, 5.2);
+    Benchmark::run("PIDController::update", [&](uint64_t i) {
+        do_not_optimize(
+            pid.update(inputs[i % INPUT_COUNT],
+                       inputs[(i + 64) % INPUT_COUNT], NOMINAL_DT));
+    });
+
+    run_kinematics_benchmarks("MecanumKinematics4W", kinematics);
+    DifferentialKinematics differential(WHEEL_RADIUS, TRACK_WIDTH);
+    run_kinematics_benchmarks("DifferentialKinematics", differential);
+    OmniKinematics3W omni(WHEEL_RADIUS, TRACK_WIDTH / 2);
+    run_kinematics_benchmarks("OmniKinematics3W", omni);
+    SwerveKinematics<4> swerve(kinematics.get_geometry());
+    run_kinematics_benchmarks("SwerveKinematics<4>", swerve);
+
+    Odometry odometry;
+    Benchmark::run("Odometry::update", [&](uint64_t i) {
+        const Vector3 velocity(inputs[i % INPUT_COUNT],
+                               inputs[(i + 64) % INPUT_COUNT],
+                               inputs[(i + 128) % INPUT_COUNT]);
+        odometry.update(velocity, NOMINAL_DT);
+        do_not_optimize(odometry.get_estimate());
+    });
+    Benchmark::run("Odometry::update with gyro", [&](uint64_t i) {
+        const Vector3 velocity(inputs[i % INPUT_COUNT],
+                               inputs[(i + 64) % INPUT_COUNT],
+                               inputs[(i + 128) % INPUT_COUNT]);
+        odometry.update(velocity, inputs[(i + 130) % INPUT_COUNT], NOMINAL_DT);
+        do_not_optimize(odometry.get_estimate());
+    });
+
+    SetpointLimits limits;
+    limits.max_acceleration << MAX_LINEAR_ACCELERATION,
+        MAX_LINEAR_ACCELERATION, MAX_ANGULAR_ACCELERATION;
+    limits.max_jerk << MAX_LINEAR_JERK, MAX_LINEAR_JERK, MAX_ANGULAR_JERK;
+    SetpointGenerator setpoint_generator(limits);
+    ControlTick setpoint_tick;
+    Benchmark::run("SetpointGenerator::update", [&](uint64_t i) {
+        if (i % 64 == 0)
+        {
+            setpoint_generator.set_target(
+                Vector3(inputs[i / 64 % INPUT_COUNT],
+                        inputs[(i / 64 + 64) % INPUT_COUNT],
+                        inputs[(i / 64 + 128) % INPUT_COUNT]),
+                setpoint_tick.timestamp_us);
+        }
+        advance_tick(setpoint_tick, setpoint_tick.timestamp_us + PERIOD_US,
+                     NOMINAL_DT);
+        do_not_optimize(setpoint_generator.update(setpoint_tick));
+    });
+
+    Benchmark::run("DCMotorPlant::step x4 (reference)", [&](uint64_t i) {
+        for (DCMotorPlant* plant : plants)
+        {
+            plant->set_motor_control(inputs[i % INPUT_COUNT]);
+            plant->step(PERIOD_US * 1e-6);
+        }
+    });
+
+    // The plants stand still, only the control path is measured
+    Benchmark::run("VelocityController::update", [&](uint64_t i) {
+        robot_controller.set_latest_command(
+            Vector3(inputs[i % INPUT_COUNT] * scalar_t(0.5), 0, 0));
+        SimHal::advance_time(PERIOD_US);
+        advance_tick(control_tick, micros(), NOMINAL_DT);
+        robot_controller.update(control_tick);
+    });
+
+    // Includes the plant steps measured above
+    Benchmark::run("Closed loop cycle", [&](uint64_t i) {
+        if (i % INPUT_COUNT == 0)
+        {
+            robot_controller.set_latest_command(
+                Vector3(inputs[i / INPUT_COUNT % INPUT_COUNT] * 0.5, 0, 0));
+        }
+        run_control_cycle();
+    });
+}
+
+/**
+ * @brief Identify and tune all motors one after another, like
+ * ControlTask::start_autotune(), and apply the tuned gains and stiction.
+ *
+ */
+void run_autotune()
+{
+    MotorAutotuner autotuner;
+    robot_controller.set_latest_command(Vector3::Zero());
+    printf("motor,state,gain,time_constant,dead_time,stiction,kp,ki\n");
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        autotuner.start(AutotuneConfig());
+        while (true)
+        {
+            const scalar_t output = autotuner.update(
+                robot_controller.get_actual_wheel_velocities()(i),
+                control_tick);
+            if (!autotuner.is_running())
+            {
+                break;
+            }
+            robot_controller.set_output_override(i, output);
+            run_control_cycle();
+        }
+        robot_controller.clear_output_override(i);
+        controllers[i]->reset();
+
+        const AutotuneResult& result = autotuner.get_result();
+        printf("%u,%s,%f,%f,%f,%f,%f,%f\n", unsigned(i),
+               autotuner.get_state() == AutotuneState::DONE ? "done"
+                                                            : "failed",
+               double(result.plant.gain), double(result.plant.time_constant),
+               double(result.plant.dead_time), double(result.plant.stiction),
+               double(result.pid.kp), double(result.pid.ki));
+        if (autotuner.get_state() == AutotuneState::DONE)
+        {
+            controllers[i]->set_gains(result.pid);
+            motor_controllers[i]->set_min_output(result.plant.stiction);
+        }
+    }
+}
+
+/**
+ * @brief Replay the setpoints of a Teleplot recording on all wheels, held
+ * between the recorded samples. The wheel speeds are set on the motor
+ * controllers directly, bypassing the kinematics.
+ *
+ * @param path The path of the CSV file.
+ * @return int The exit code, 1 if the file could not be read.
+ */
+int run_replay(const char* path)
+{
+    TeleplotTrace trace;
+    const bool loaded = load_teleplot_trace(path, trace);
+    const uint32_t cycles = uint32_t(trace.get_duration() * 1e6 / PERIOD_US);
+    if (!loaded || trace.setpoints.empty() || cycles == 0)
+    {
+        fprintf(stderr, "no setpoints in %s\n", path);
+        return 1;
+    }
+
+    // The recorded wheel as the reference of the simulated ones
+    TrackingMetrics recorded;
+    size_t setpoint = 0;
+    double previous_time = 0;
+    for (const TimedValue& measurement : trace.measurements)
+    {
+        while (setpoint + 1 < trace.setpoints.size() &&
+               trace.setpoints[setpoint + 1].time <= measurement.time)
+        {
+            setpoint++;
+        }
+        if (trace.setpoints[setpoint].time <= measurement.time)
+        {
+            recorded.record(trace.setpoints[setpoint].value, measurement.value,
+                            scalar_t(measurement.time - previous_time));
+        }
+        previous_time = measurement.time;
+    }
+
+    robot_controller.set_latest_command(Vector3::Zero());
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        run_control_cycle();
+    }
+
+    // The fault monitor of the firmware, only for the replay so the other
+    // benchmarks keep their cost
+    FaultMonitor fault_monitor(4);
+    motor_control_manager.set_fault_monitor(&fault_monitor);
+    uint8_t faults[4] = {0, 0, 0, 0};
+
+    TrackingMetrics simulated[4];
+    std::vector<double> cycle_us;
+    cycle_us.reserve(cycles);
+    setpoint = 0;
+    for (uint32_t i = 0; i < cycles; i++)
+    {
+        const double time = double(i) * PERIOD_US * 1e-6;
+        while (setpoint + 1 < trace.setpoints.size() &&
+               trace.setpoints[setpoint + 1].time <= time)
+        {
+            setpoint++;
+        }
+        const scalar_t speed = trace.setpoints[setpoint].time <= time
+                                   ? trace.setpoints[setpoint].value
+                                   : scalar_t(0.0);
+
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            motor_control_manager.set_motor_speed(j, speed);
+            plants[j]->step(PERIOD_US * 1e-6);
+        }
+        SimHal::advance_time(PERIOD_US);
+        advance_tick(control_tick, micros(), NOMINAL_DT);
+
+        const auto start = std::chrono::steady_clock::now();
+        motor_control_manager.update(control_tick);
+        const auto end = std::chrono::steady_clock::now();
+        cycle_us.push_back(
+            std::chrono::duration<double, std::micro>(end - start).count());
+
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            simulated[j].record(speed, motor_control_manager.get_motor_speed(j),
+                                control_tick.dt);
+            faults[j] |= motor_control_manager.get_faults(j);
+        }
+    }
+
+    double cycle_sum = 0;
+    for (const double duration : cycle_us)
+    {
+        cycle_sum += duration;
+    }
+    std::sort(cycle_us.begin(), cycle_us.end());
+
+    char json[256];
+    // The path is left out, it would need escaping
+    printf("{\"scalar\":\"%s\",\"period_us\":%u,\"cycles\":%u,",
+           sizeof(scalar_t) == 4 ? "float" : "double", unsigned(PERIOD_US),
+           unsigned(cycles));
+    format_tracking_json(recorded.get_result(), json, sizeof(json));
+    printf("\"recorded\":%s,\"simulated\":[", json);
+    for (uint8_t j = 0; j < 4; j++)
+    {
+        format_tracking_json(simulated[j].get_result(), json, sizeof(json));
+        printf("%s%s", j > 0 ? "," : "", json);
+    }
+    printf("],\"faults\":[%u,%u,%u,%u]", unsigned(faults[0]),
+           unsigned(faults[1]), unsigned(faults[2]), unsigned(faults[3]));
+    printf(",\"cycle_us\":{\"min\":%.3f,\"mean\":%.3f,\"p99\":%.3f,"
+           "\"max\":%.3f}}\n",
+           cycle_us.front(), cycle_sum / cycle_us.size(),
+           cycle_us[cycle_us.size() * 99 / 100], cycle_us.back());
+    motor_control_manager.set_fault_monitor(nullptr);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    for (uint16_t i = 0; i < INPUT_COUNT; i++)
+    {
+        inputs[i] = std::sin(scalar_t(2.0 * PI * i / INPUT_COUNT));
+    }
+
+    const Vector3 step_command(0.3, 0.0, 0.0);
+    scalar_t mean_error;
+    if (argc > 1 && strcmp(argv[1], "--step") == 0)
+    {
+        run_step_response(step_command, 2.0, true, mean_error);
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "--replay") == 0)
+    {
+        return run_replay(argv[2]);
+    }
+    if (argc > 1 && strcmp(argv[1], "--autotune") == 0)
+    {
+        scalar_t max_error =
+            run_step_response(step_command, 2.0, false, mean_error);
+        printf("default gains: wheel speed error after 1.5 s mean %.3f max "
+               "%.3f rad/s\n",
+               double(mean_error), double(max_error));
+        robot_controller.set_latest_command(Vector3::Zero());
+        for (uint16_t i = 0; i < 1000; i++)
+        {
+            run_control_cycle();
+        }
+
+        run_autotune();
+        for (uint16_t i = 0; i < 1000; i++)
+        {
+            run_control_cycle();
+        }
+        max_error = run_step_response(step_command, 2.0, false, mean_error);
+        printf("tuned gains: wheel speed error after 1.5 s mean %.3f max "
+               "%.3f rad/s\n",
+               double(mean_error), double(max_error));
+        return 0;
+    }
+
+    printf("scalar_t: %s\n", sizeof(scalar_t) == 4 ? "float" : "double");
+    run_benchmarks();
+
+    robot_controller.set_latest_command(Vector3::Zero());
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        run_control_cycle();
+    }
+    const scalar_t max_error =
+        run_step_response(step_command, 2.0, false, mean_error);
+    printf("\nstep response: wheel speed error after 1.5 s mean %.3f max %.3f "
+           "rad/s\n",
+           double(mean_error), double(max_error));
+    return 0;
+}
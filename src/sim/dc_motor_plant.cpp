@@ -0,0 +1,108 @@
+/**
+ * @file dc_motor_plant.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the DCMotorPlant class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "sim/dc_motor_plant.hpp"
+#include "sim/sim_hal.hpp"
+#include "utils/constants.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <cmath>
+
+static const double MAX_SUBSTEP = 100e-6;
+
+DCMotorPlant::DCMotorPlant(const uint8_t encoder_pin_A,
+                           const uint8_t encoder_pin_B,
+                           const uint16_t encoder_resolution,
+                           const DCMotorParameters& parameters,
+                           const bool reverse)
+    : encoder_pin_A_(encoder_pin_A), encoder_pin_B_(encoder_pin_B),
+      counts_per_radian_(encoder_resolution / (2.0 * PI)), reverse_(reverse),
+      parameters_(parameters)
+{
+    SimHal::set_encoder_count(encoder_pin_A_, 0);
+    SimHal::set_pin_level(encoder_pin_B_, LOW);
+}
+
+void DCMotorPlant::set_motor_control(scalar_t control_value)
+{
+    control_value_ = std::clamp(double(control_value), -1.0, 1.0);
+}
+
+void DCMotorPlant::step(const double dt)
+{
+    if (dt <= 0)
+    {
+        return;
+    }
+
+    const DCMotorParameters& p = parameters_;
+    const double voltage =
+        (reverse_ ? -control_value_ : control_value_) * p.supply_voltage;
+    const int substeps = int(std::ceil(dt / MAX_SUBSTEP));
+    const double h = dt / substeps;
+    const uint64_t start_time_us = SimHal::get_time_us();
+
+    for (int i = 0; i < substeps; i++)
+    {
+        const double previous_angle = angle_;
+
+        const double current =
+            (voltage - p.motor_constant * velocity_) / p.resistance;
+        const double drive = p.motor_constant * current -
+                             p.viscous_friction * velocity_ - p.load_torque;
+
+        if (velocity_ == 0 && std::abs(drive) <= p.coulomb_friction)
+        {
+            // Static friction holds the shaft
+            continue;
+        }
+
+        const double direction =
+            velocity_ != 0 ? std::copysign(1.0, velocity_)
+                           : std::copysign(1.0, drive);
+        const double next =
+            velocity_ +
+            h * (drive - direction * p.coulomb_friction) / p.inertia;
+
+        // Friction stops the shaft instead of reversing it
+        velocity_ = velocity_ != 0 && next * velocity_ < 0 ? 0.0 : next;
+        angle_ += h * velocity_;
+
+        // One edge per count, at the time the angle crosses the count
+        const int64_t count = int64_t(std::floor(angle_ * counts_per_radian_));
+        while (count_ != count)
+        {
+            const int8_t direction = count > count_ ? 1 : -1;
+            const double edge_angle =
+                double(direction > 0 ? count_ + 1 : count_) /
+                counts_per_radian_;
+            const double fraction =
+                (edge_angle - previous_angle) / (angle_ - previous_angle);
+            count_ += direction;
+
+            SimHal::set_time(start_time_us +
+                             uint64_t((i + fraction) * h * 1e6 + 0.5));
+            SimHal::set_encoder_count(encoder_pin_A_, count_);
+            SimHal::set_pin_level(encoder_pin_B_, direction > 0 ? LOW : HIGH);
+            SimHal::trigger_interrupt(encoder_pin_A_);
+        }
+    }
+
+    SimHal::set_time(start_time_us);
+}
+
+double DCMotorPlant::get_velocity() const { return velocity_; }
+
+double DCMotorPlant::get_angle() const { return angle_; }
+
+double DCMotorPlant::get_control_value() const { return control_value_; }
+
+DCMotorParameters& DCMotorPlant::get_parameters() { return parameters_; }
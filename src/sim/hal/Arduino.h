@@ -0,0 +1,96 @@
+/**
+ * @file Arduino.h
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Host shim of the parts of the Arduino ESP32 core used by the control
+ * stack.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Only on the include path of the native environments. Time, input levels and
+ * interrupts are simulated, see SimHal in sim/sim_hal.hpp. Outputs do
+ * nothing, analog inputs read 0 mV.
+ *
+ */
+
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#define LOW 0
+#define HIGH 1
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define INPUT_PULLDOWN 0x09
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define IRAM_ATTR
+#define digitalPinToInterrupt(pin) (pin)
+
+unsigned long micros();
+unsigned long millis();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg,
+                        int mode);
+void detachInterrupt(uint8_t pin);
+
+// The host runs single threaded, critical sections are not needed
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux) ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux) ((void)(mux))
+
+/**
+ * @brief Serial port writing to stdout.
+ *
+ */
+class HardwareSerial
+{
+public:
+    void begin(unsigned long baud);
+    size_t print(const char* text);
+    size_t print(double value);
+    size_t println(const char* text = "");
+    size_t println(double value);
+    size_t printf(const char* format, ...)
+        __attribute__((format(printf, 2, 3)));
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * @brief CPU information, the cycle counter counts nanoseconds of the host.
+ *
+ */
+class EspClass
+{
+public:
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz();
+};
+
+extern EspClass ESP;
+
+#endif // SIM_ARDUINO_H
@@ -0,0 +1,44 @@
+/**
+ * @file ESP32Encoder.h
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Host shim of the ESP32Encoder library.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The count of an encoder is the count of its A pin set by the plant model,
+ * see SimHal::set_encoder_count().
+ *
+ */
+
+#ifndef SIM_ESP32_ENCODER_H
+#define SIM_ESP32_ENCODER_H
+
+#include <stdint.h>
+
+enum puType
+{
+    UP,
+    DOWN,
+    NONE
+};
+
+class ESP32Encoder
+{
+public:
+    static puType useInternalWeakPullResistors;
+
+    void attachSingleEdge(int pin_A, int pin_B);
+    void attachHalfQuad(int pin_A, int pin_B);
+    void attachFullQuad(int pin_A, int pin_B);
+    int64_t getCount();
+    void clearCount();
+    void setFilter(uint16_t value);
+
+private:
+    int pin_A_ = -1;
+    int64_t offset_ = 0;
+};
+
+#endif // SIM_ESP32_ENCODER_H
@@ -0,0 +1,179 @@
+/**
+ * @file hal.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the host shims and the SimHal class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "sim/sim_hal.hpp"
+#include <Arduino.h>
+#include <ESP32Encoder.h>
+#include <chrono>
+#include <stdarg.h>
+
+uint64_t SimHal::time_us_ = 0;
+int64_t SimHal::encoder_counts_[SimHal::PIN_COUNT] = {};
+int SimHal::pin_levels_[SimHal::PIN_COUNT] = {};
+SimHal::Interrupt SimHal::interrupts_[SimHal::PIN_COUNT] = {};
+
+uint64_t SimHal::get_time_us() { return time_us_; }
+
+void SimHal::set_time(const uint64_t time_us) { time_us_ = time_us; }
+
+void SimHal::advance_time(const uint64_t duration_us)
+{
+    time_us_ += duration_us;
+}
+
+void SimHal::set_encoder_count(const uint8_t pin_A, const int64_t count)
+{
+    if (pin_A < PIN_COUNT)
+    {
+        encoder_counts_[pin_A] = count;
+    }
+}
+
+int64_t SimHal::get_encoder_count(const uint8_t pin_A)
+{
+    return pin_A < PIN_COUNT ? encoder_counts_[pin_A] : 0;
+}
+
+void SimHal::set_pin_level(const uint8_t pin, const int level)
+{
+    if (pin < PIN_COUNT)
+    {
+        pin_levels_[pin] = level;
+    }
+}
+
+int SimHal::get_pin_level(const uint8_t pin)
+{
+    return pin < PIN_COUNT ? pin_levels_[pin] : LOW;
+}
+
+void SimHal::attach_interrupt(const uint8_t pin, void (*handler)(void*),
+                              void* argument)
+{
+    if (pin < PIN_COUNT)
+    {
+        interrupts_[pin] = Interrupt{handler, argument};
+    }
+}
+
+void SimHal::trigger_interrupt(const uint8_t pin)
+{
+    if (pin < PIN_COUNT && interrupts_[pin].handler != nullptr)
+    {
+        interrupts_[pin].handler(interrupts_[pin].argument);
+    }
+}
+
+void SimHal::reset()
+{
+    time_us_ = 0;
+    for (uint8_t i = 0; i < PIN_COUNT; i++)
+    {
+        encoder_counts_[i] = 0;
+        pin_levels_[i] = LOW;
+        interrupts_[i] = Interrupt{nullptr, nullptr};
+    }
+}
+
+// Arduino.h
+
+unsigned long micros() { return (unsigned long)SimHal::get_time_us(); }
+
+unsigned long millis() { return (unsigned long)(SimHal::get_time_us() / 1000); }
+
+void delay(uint32_t ms) { SimHal::advance_time(uint64_t(ms) * 1000); }
+
+void delayMicroseconds(uint32_t us) { SimHal::advance_time(us); }
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+
+void digitalWrite(uint8_t pin, uint8_t value) {}
+
+int digitalRead(uint8_t pin) { return SimHal::get_pin_level(pin); }
+
+uint32_t analogReadMilliVolts(uint8_t pin) { return 0; }
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg,
+                        int mode)
+{
+    SimHal::attach_interrupt(pin, handler, arg);
+}
+
+void detachInterrupt(uint8_t pin)
+{
+    SimHal::attach_interrupt(pin, nullptr, nullptr);
+}
+
+HardwareSerial Serial;
+
+void HardwareSerial::begin(unsigned long baud) {}
+
+size_t HardwareSerial::print(const char* text)
+{
+    return size_t(fputs(text, stdout) >= 0 ? strlen(text) : 0);
+}
+
+size_t HardwareSerial::print(double value)
+{
+    return size_t(::printf("%.2f", value));
+}
+
+size_t HardwareSerial::println(const char* text)
+{
+    return print(text) + print("\n");
+}
+
+size_t HardwareSerial::println(double value)
+{
+    return print(value) + print("\n");
+}
+
+size_t HardwareSerial::printf(const char* format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    const int length = vprintf(format, arguments);
+    va_end(arguments);
+    return length > 0 ? size_t(length) : 0;
+}
+
+EspClass ESP;
+
+uint32_t EspClass::getCycleCount()
+{
+    return uint32_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count());
+}
+
+uint32_t EspClass::getCpuFreqMHz() { return 1000; }
+
+// ESP32Encoder.h
+
+puType ESP32Encoder::useInternalWeakPullResistors = DOWN;
+
+void ESP32Encoder::attachSingleEdge(int pin_A, int pin_B) { pin_A_ = pin_A; }
+
+void ESP32Encoder::attachHalfQuad(int pin_A, int pin_B) { pin_A_ = pin_A; }
+
+void ESP32Encoder::attachFullQuad(int pin_A, int pin_B) { pin_A_ = pin_A; }
+
+int64_t ESP32Encoder::getCount()
+{
+    return SimHal::get_encoder_count(uint8_t(pin_A_)) - offset_;
+}
+
+void ESP32Encoder::clearCount()
+{
+    offset_ = SimHal::get_encoder_count(uint8_t(pin_A_));
+}
+
+void ESP32Encoder::setFilter(uint16_t value) {}
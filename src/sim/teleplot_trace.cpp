@@ -0,0 +1,132 @@
+/**
+ * @file teleplot_trace.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the Teleplot CSV reader.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "sim/teleplot_trace.hpp"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const int MAX_COLUMNS = 16;
+
+/**
+ * @brief Split a line at the commas and strip the quotes of the fields. Empty
+ * fields stay empty strings.
+ *
+ * @return int The number of fields.
+ */
+static int split_row(char* line, char* (&fields)[MAX_COLUMNS])
+{
+    int count = 0;
+    char* field = line;
+    while (count < MAX_COLUMNS)
+    {
+        char* end = field + strcspn(field, ",\r\n");
+        const bool last = *end != ',';
+        *end = '\0';
+        if (*field == '"')
+        {
+            field++;
+            char* quote = strchr(field, '"');
+            if (quote != nullptr)
+            {
+                *quote = '\0';
+            }
+        }
+        fields[count++] = field;
+        if (last)
+        {
+            break;
+        }
+        field = end + 1;
+    }
+    return count;
+}
+
+double TeleplotTrace::get_duration() const
+{
+    double duration = 0;
+    if (!setpoints.empty())
+    {
+        duration = std::max(duration, setpoints.back().time);
+    }
+    if (!measurements.empty())
+    {
+        duration = std::max(duration, measurements.back().time);
+    }
+    return duration;
+}
+
+bool load_teleplot_trace(const char* path, TeleplotTrace& trace)
+{
+    FILE* file = fopen(path, "r");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    trace.setpoints.clear();
+    trace.measurements.clear();
+    char line[512];
+    char* fields[MAX_COLUMNS];
+    int setpoint_column = -1;
+    int measured_column = -1;
+    if (fgets(line, sizeof(line), file) != nullptr)
+    {
+        const int count = split_row(line, fields);
+        for (int i = 1; i < count; i++)
+        {
+            if (strcmp(fields[i], "setpoint") == 0)
+            {
+                setpoint_column = i;
+            }
+            else if (strcmp(fields[i], "measured") == 0)
+            {
+                measured_column = i;
+            }
+        }
+    }
+
+    // Teleplot writes the time in s despite the "(ms)" in the header
+    bool first = true;
+    double start = 0;
+    while (setpoint_column > 0 && fgets(line, sizeof(line), file) != nullptr)
+    {
+        const int count = split_row(line, fields);
+        if (count < 2 || *fields[0] == '\0')
+        {
+            continue;
+        }
+        const double time = strtod(fields[0], nullptr);
+        if (first)
+        {
+            start = time;
+            first = false;
+        }
+
+        TimedValue value;
+        value.time = time - start;
+        if (setpoint_column < count && *fields[setpoint_column] != '\0')
+        {
+            value.value = scalar_t(strtod(fields[setpoint_column], nullptr));
+            trace.setpoints.push_back(value);
+        }
+        if (measured_column > 0 && measured_column < count &&
+            *fields[measured_column] != '\0')
+        {
+            value.value = scalar_t(strtod(fields[measured_column], nullptr));
+            trace.measurements.push_back(value);
+        }
+    }
+
+    fclose(file);
+    return setpoint_column > 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file autotune_storage.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the AutotuneStorage class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "utils/autotune_storage.hpp"
+#include <Preferences.h>
+#include <stdio.h>
+
+static const char* NAMESPACE = "autotune";
+
+/**
+ * @brief Layout of a stored result.
+ */
+struct StoredResult
+{
+    uint16_t version;
+    uint16_t size; // Differs between float and double builds
+    AutotuneResult result;
+};
+
+/**
+ * @brief Get the key of a motor, "m0" to "m9".
+ */
+static void get_key(const uint8_t motor_index, char (&key)[8])
+{
+    snprintf(key, sizeof(key), "m%u", unsigned(motor_index));
+}
+
+bool AutotuneStorage::save(const uint8_t motor_index,
+                           const AutotuneResult& result)
+{
+    Preferences preferences;
+    if (!preferences.begin(NAMESPACE, false))
+    {
+        return false;
+    }
+    char key[8];
+    get_key(motor_index, key);
+    const StoredResult stored = {VERSION, uint16_t(sizeof(StoredResult)),
+                                 result};
+    const bool written = preferences.putBytes(key, &stored, sizeof(stored)) ==
+                         sizeof(stored);
+    preferences.end();
+    return written;
+}
+
+bool AutotuneStorage::load(const uint8_t motor_index, AutotuneResult& result)
+{
+    Preferences preferences;
+    if (!preferences.begin(NAMESPACE, true))
+    {
+        return false;
+    }
+    char key[8];
+    get_key(motor_index, key);
+    StoredResult stored;
+    const bool valid =
+        preferences.getBytesLength(key) == sizeof(stored) &&
+        preferences.getBytes(key, &stored, sizeof(stored)) == sizeof(stored) &&
+        stored.version == VERSION && stored.size == sizeof(stored);
+    preferences.end();
+    if (valid)
+    {
+        result = stored.result;
+    }
+    return valid;
+}
+
+bool AutotuneStorage::clear()
+{
+    Preferences preferences;
+    if (!preferences.begin(NAMESPACE, false))
+    {
+        return false;
+    }
+    const bool cleared = preferences.clear();
+    preferences.end();
+    return cleared;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file config_store.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the ConfigStore class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "utils/config_store.hpp"
+#include <Preferences.h>
+
+static const char* NAMESPACE = "config";
+static const char* KEY = "robot";
+
+bool ConfigStore::clear()
+{
+    Preferences preferences;
+    if (!preferences.begin(NAMESPACE, false))
+    {
+        return false;
+    }
+    const bool cleared = preferences.clear();
+    preferences.end();
+    return cleared;
+}
+
+bool ConfigStore::write(const void* data, const size_t size)
+{
+    Preferences preferences;
+    if (!preferences.begin(NAMESPACE, false))
+    {
+        return false;
+    }
+    const bool written = preferences.putBytes(KEY, data, size) == size;
+    preferences.end();
+    return written;
+}
+
+bool ConfigStore::read(void* data, const size_t size)
+{
+    Preferences preferences;
+    if (!preferences.begin(NAMESPACE, true))
+    {
+        return false;
+    }
+    const bool valid = preferences.getBytesLength(KEY) == size &&
+                       preferences.getBytes(KEY, data, size) == size;
+    preferences.end();
+    return valid;
+}
@@ -10,58 +10,111 @@
  */
 
 #include "utils/controllers.hpp"
+#include <algorithm>
 
-PIDController::PIDController(double kp, double ki, double kd,
-                             double max_expected_sampling_time, double max_integral)
+PIDController::PIDController(scalar_t kp, scalar_t ki, scalar_t kd,
+                             scalar_t max_expected_sampling_time, scalar_t max_integral,
+                             scalar_t derivative_cutoff_frequency)
     : kp_(kp), ki_(ki), kd_(kd),
       max_expected_sampling_time_(max_expected_sampling_time), integral_(0.0),
-      previous_error_(0.0),
-      derivative_filter_(1.0 /
-                             (1.0 + 2.0 * PI * kd * max_expected_sampling_time),
+      previous_input_(0.0),
+      derivative_filter_(derivative_cutoff_frequency,
                          max_expected_sampling_time),
         max_integral_(max_integral)
 {
-    last_update_time_ = micros();
 }
 
-double PIDController::update(double setpoint, double input)
+scalar_t PIDController::update(scalar_t setpoint, scalar_t input, scalar_t dt)
 {
-    double sampling_time = (micros() - last_update_time_) * 1e-6;
-    last_update_time_ = micros();
-    double error = setpoint - input;
+    scalar_t error = setpoint - input;
+    p_term_ = kp_ * error;
+    if (dt <= 0)
+    {
+        // The integral and the derivative are undefined without a time step
+        previous_input_ = input;
+        return p_term_ + i_term_ + d_term_;
+    }
+    const scalar_t sampling_time = std::min(dt, max_expected_sampling_time_);
 
     integral_ += error * sampling_time;
-    
+
     // Enforce the maximum integral limit
     if (integral_ > max_integral_) {
         integral_ = max_integral_;
     } else if (integral_ < -max_integral_) {
         integral_ = -max_integral_;
     }
-    double derivative =
-        derivative_filter_.update((error - previous_error_) / sampling_time);
-    previous_error_ = error;
+    // The derivative acts on the measurement, so the setpoint steps of the
+    // slower rate groups do not kick the derivative term
+    scalar_t derivative = derivative_filter_.update(
+        -(input - previous_input_) / sampling_time, sampling_time);
+    previous_input_ = input;
 
-    double output = kp_ * error + ki_ * integral_ + kd_ * derivative;
+    i_term_ = ki_ * integral_;
+    d_term_ = kd_ * derivative;
 
-    return output;
+    return p_term_ + i_term_ + d_term_;
 }
 
 void PIDController::reset()
 {
     integral_ = 0.0;
-    previous_error_ = 0.0;
+    previous_input_ = 0.0;
     derivative_filter_.reset();
 }
 
-double PIDController::get_kp() { return kp_; }
+scalar_t PIDController::get_kp() { return kp_; }
+
+scalar_t PIDController::get_ki() { return ki_; }
+
+scalar_t PIDController::get_kd() { return kd_; }
 
-double PIDController::get_ki() { return ki_; }
+void PIDController::set_kp(scalar_t kp) { kp_ = kp; }
 
-double PIDController::get_kd() { return kd_; }
+void PIDController::set_ki(scalar_t ki) { ki_ = ki; }
+
+void PIDController::set_kd(scalar_t kd) { kd_ = kd; }
+
+PIDGains PIDController::get_gains() const
+{
+    PIDGains gains;
+    gains.kp = kp_;
+    gains.ki = ki_;
+    gains.kd = kd_;
+    return gains;
+}
+
+void PIDController::set_gains(const PIDGains& gains)
+{
+    // Keep ki * integral constant. If the old or the new integral gain is
+    // zero, the integral term starts again from zero.
+    if (gains.ki != ki_)
+    {
+        if (gains.ki > 0 && ki_ > 0)
+        {
+            integral_ *= ki_ / gains.ki;
+        }
+        else
+        {
+            integral_ = 0.0;
+        }
+
+        if (integral_ > max_integral_)
+        {
+            integral_ = max_integral_;
+        }
+        else if (integral_ < -max_integral_)
+        {
+            integral_ = -max_integral_;
+        }
+    }
+    kp_ = gains.kp;
+    ki_ = gains.ki;
+    kd_ = gains.kd;
+}
 
-void PIDController::set_kp(double kp) { kp_ = kp; }
+scalar_t PIDController::get_p_term() const { return p_term_; }
 
-void PIDController::set_ki(double ki) { ki_ = ki; }
+scalar_t PIDController::get_i_term() const { return i_term_; }
 
-void PIDController::set_kd(double kd) { kd_ = kd; }
\ No newline at end of file
+scalar_t PIDController::get_d_term() const { return d_term_; }
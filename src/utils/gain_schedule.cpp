@@ -0,0 +1,147 @@
+/**
+ * @file gain_schedule.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the GainSchedule class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "utils/gain_schedule.hpp"
+#include <cmath>
+
+GainSchedule::GainSchedule(const PIDGains& gains,
+                           const scalar_t max_wheel_speed,
+                           const scalar_t max_twist_magnitude,
+                           const scalar_t rotation_radius)
+    : rotation_radius_(rotation_radius)
+{
+    for (uint8_t i = 0; i < BREAKPOINTS; i++)
+    {
+        wheel_speeds_[i] = max_wheel_speed * i / (BREAKPOINTS - 1);
+        twist_breakpoints_[i] = max_twist_magnitude * i / (BREAKPOINTS - 1);
+        for (uint8_t j = 0; j < BREAKPOINTS; j++)
+        {
+            gains_[i][j] = gains;
+        }
+    }
+}
+
+PIDGains GainSchedule::evaluate(const scalar_t wheel_speed,
+                                const scalar_t twist_magnitude) const
+{
+    scalar_t u, v;
+    const uint8_t i = find_segment(wheel_speeds_, std::abs(wheel_speed), u);
+    const uint8_t j =
+        find_segment(twist_breakpoints_, std::abs(twist_magnitude), v);
+
+    const PIDGains& g00 = gains_[i][j];
+    const PIDGains& g01 = gains_[i][j + 1];
+    const PIDGains& g10 = gains_[i + 1][j];
+    const PIDGains& g11 = gains_[i + 1][j + 1];
+    const scalar_t w00 = (1 - u) * (1 - v);
+    const scalar_t w01 = (1 - u) * v;
+    const scalar_t w10 = u * (1 - v);
+    const scalar_t w11 = u * v;
+
+    PIDGains gains;
+    gains.kp = w00 * g00.kp + w01 * g01.kp + w10 * g10.kp + w11 * g11.kp;
+    gains.ki = w00 * g00.ki + w01 * g01.ki + w10 * g10.ki + w11 * g11.ki;
+    gains.kd = w00 * g00.kd + w01 * g01.kd + w10 * g10.kd + w11 * g11.kd;
+    return gains;
+}
+
+scalar_t GainSchedule::get_twist_magnitude(const Vector3& twist) const
+{
+    return std::sqrt(twist(0) * twist(0) + twist(1) * twist(1)) +
+           rotation_radius_ * std::abs(twist(2));
+}
+
+bool GainSchedule::is_valid() const
+{
+    for (uint8_t i = 0; i + 1 < BREAKPOINTS; i++)
+    {
+        // Also fails for NaN
+        if (!(wheel_speeds_[i] < wheel_speeds_[i + 1]) ||
+            !(twist_breakpoints_[i] < twist_breakpoints_[i + 1]))
+        {
+            return false;
+        }
+    }
+    for (uint8_t i = 0; i < BREAKPOINTS; i++)
+    {
+        for (uint8_t j = 0; j < BREAKPOINTS; j++)
+        {
+            const PIDGains& gains = gains_[i][j];
+            if (!(gains.kp >= 0) || !(gains.ki >= 0) || !(gains.kd >= 0))
+            {
+                return false;
+            }
+        }
+    }
+    return rotation_radius_ >= 0;
+}
+
+scalar_t GainSchedule::get_wheel_speed(const uint8_t index) const
+{
+    return wheel_speeds_[index];
+}
+
+void GainSchedule::set_wheel_speed(const uint8_t index,
+                                   const scalar_t wheel_speed)
+{
+    wheel_speeds_[index] = wheel_speed;
+}
+
+scalar_t GainSchedule::get_twist_breakpoint(const uint8_t index) const
+{
+    return twist_breakpoints_[index];
+}
+
+void GainSchedule::set_twist_breakpoint(const uint8_t index,
+                                        const scalar_t twist_magnitude)
+{
+    twist_breakpoints_[index] = twist_magnitude;
+}
+
+const PIDGains& GainSchedule::get_gains(const uint8_t wheel_speed_index,
+                                        const uint8_t twist_index) const
+{
+    return gains_[wheel_speed_index][twist_index];
+}
+
+void GainSchedule::set_gains(const uint8_t wheel_speed_index,
+                             const uint8_t twist_index, const PIDGains& gains)
+{
+    gains_[wheel_speed_index][twist_index] = gains;
+}
+
+scalar_t GainSchedule::get_rotation_radius() const { return rotation_radius_; }
+
+void GainSchedule::set_rotation_radius(const scalar_t rotation_radius)
+{
+    rotation_radius_ = rotation_radius;
+}
+
+uint8_t GainSchedule::find_segment(const scalar_t* breakpoints,
+                                   const scalar_t value, scalar_t& weight)
+{
+    uint8_t i = 0;
+    while (i + 2 < BREAKPOINTS && value > breakpoints[i + 1])
+    {
+        i++;
+    }
+
+    weight = (value - breakpoints[i]) / (breakpoints[i + 1] - breakpoints[i]);
+    if (weight < 0)
+    {
+        weight = 0;
+    }
+    else if (weight > 1)
+    {
+        weight = 1;
+    }
+    return i;
+}
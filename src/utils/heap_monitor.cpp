@@ -0,0 +1,72 @@
+/**
+ * @file heap_monitor.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the HeapMonitor class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "utils/heap_monitor.hpp"
+#include <Arduino.h>
+#include <atomic>
+#include <esp_heap_caps.h>
+
+static TaskHandle_t watched_task = nullptr;
+static std::atomic<uint32_t> allocation_count(0);
+
+static inline void count_allocation()
+{
+    if (watched_task != nullptr && xTaskGetCurrentTaskHandle() == watched_task)
+    {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+extern "C"
+{
+    void* __real_malloc(size_t size);
+    void* __real_calloc(size_t count, size_t size);
+    void* __real_realloc(void* pointer, size_t size);
+
+    void* __wrap_malloc(size_t size)
+    {
+        count_allocation();
+        return __real_malloc(size);
+    }
+
+    void* __wrap_calloc(size_t count, size_t size)
+    {
+        count_allocation();
+        return __real_calloc(count, size);
+    }
+
+    void* __wrap_realloc(void* pointer, size_t size)
+    {
+        count_allocation();
+        return __real_realloc(pointer, size);
+    }
+}
+
+void HeapMonitor::watch_current_task()
+{
+    allocation_count.store(0, std::memory_order_relaxed);
+    watched_task = xTaskGetCurrentTaskHandle();
+}
+
+uint32_t HeapMonitor::get_allocation_count()
+{
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+uint32_t HeapMonitor::get_free_heap()
+{
+    return heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+}
+
+uint32_t HeapMonitor::get_free_heap_watermark()
+{
+    return heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file instrumentation.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the latency instrumentation.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "utils/instrumentation.hpp"
+
+uint32_t CycleCounter::to_us(const uint32_t cycles)
+{
+    static const uint32_t cycles_per_us = ESP.getCpuFreqMHz();
+    return cycles / cycles_per_us;
+}
+
+LatencyHistogram::LatencyHistogram(const uint32_t bucket_width_us)
+    : bucket_width_us_(bucket_width_us > 0 ? bucket_width_us : 1)
+{
+    reset();
+}
+
+void LatencyHistogram::record(const uint32_t duration_us)
+{
+    uint32_t bucket = duration_us / bucket_width_us_;
+    if (bucket > BUCKET_COUNT)
+    {
+        bucket = BUCKET_COUNT;
+    }
+    buckets_[bucket]++;
+
+    count_++;
+    sum_us_ += duration_us;
+    if (duration_us < min_us_)
+    {
+        min_us_ = duration_us;
+    }
+    if (duration_us > max_us_)
+    {
+        max_us_ = duration_us;
+    }
+}
+
+uint32_t LatencyHistogram::get_count() const { return count_; }
+
+LatencySummary LatencyHistogram::get_summary() const
+{
+    LatencySummary summary;
+    if (count_ == 0)
+    {
+        return summary;
+    }
+
+    summary.count = count_;
+    summary.min_us = min_us_;
+    summary.max_us = max_us_;
+    summary.mean_us = uint32_t(sum_us_ / count_);
+
+    // Smallest rank that covers 99 % of the values
+    const uint32_t rank = uint32_t((uint64_t(count_) * 99 + 99) / 100);
+    uint32_t cumulative = 0;
+    summary.p99_us = max_us_;
+    for (uint8_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        cumulative += buckets_[i];
+        if (cumulative >= rank)
+        {
+            const uint32_t upper_bound = (i + 1) * bucket_width_us_;
+            summary.p99_us = upper_bound < max_us_ ? upper_bound : max_us_;
+            break;
+        }
+    }
+
+    return summary;
+}
+
+void LatencyHistogram::reset()
+{
+    for (uint8_t i = 0; i <= BUCKET_COUNT; i++)
+    {
+        buckets_[i] = 0;
+    }
+    count_ = 0;
+    min_us_ = UINT32_MAX;
+    max_us_ = 0;
+    sum_us_ = 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file setpoint_generator.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the SetpointGenerator class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "utils/setpoint_generator.hpp"
+#include <algorithm>
+#include <cmath>
+
+SetpointGenerator::SetpointGenerator(const SetpointLimits& limits)
+    : limits_(limits)
+{
+}
+
+void SetpointGenerator::set_target(const Vector3& target,
+                                   const unsigned long timestamp_us)
+{
+    target_ = target;
+    target_time_us_ = timestamp_us;
+    has_target_ = true;
+}
+
+const Vector3& SetpointGenerator::update(const ControlTick& tick)
+{
+    timed_out_ = has_target_ && limits_.timeout_us > 0 &&
+                 tick.timestamp_us - target_time_us_ > limits_.timeout_us;
+    const scalar_t dt = tick.dt;
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        const scalar_t target = timed_out_ ? scalar_t(0.0) : target_(i);
+        const scalar_t max_acceleration = limits_.max_acceleration(i);
+        const scalar_t max_jerk = limits_.max_jerk(i);
+        const scalar_t error = target - velocity_(i);
+
+        if (max_acceleration <= 0 || dt <= 0)
+        {
+            // Unlimited, or no time to move in
+            acceleration_(i) = 0;
+            velocity_(i) = max_acceleration <= 0 ? target : velocity_(i);
+            continue;
+        }
+
+        // The acceleration from which the target is reached without overshoot.
+        // The change of this cycle is taken off the remaining difference, so
+        // the discrete acceleration does not lag behind and stays within the
+        // jerk limit up to the target.
+        scalar_t desired = std::copysign(max_acceleration, error);
+        if (max_jerk > 0)
+        {
+            const scalar_t remaining = std::max(
+                std::abs(error) - std::abs(acceleration_(i)) * dt,
+                scalar_t(0.0));
+            desired = std::copysign(
+                std::min(max_acceleration,
+                         std::sqrt(2 * max_jerk * remaining)),
+                error);
+            const scalar_t step = max_jerk * dt;
+            acceleration_(i) += std::clamp(desired - acceleration_(i), -step,
+                                           step);
+        }
+        else
+        {
+            acceleration_(i) = desired;
+        }
+
+        const scalar_t change = acceleration_(i) * dt;
+        if (std::abs(change) >= std::abs(error) && change * error >= 0)
+        {
+            // Arrived
+            velocity_(i) = target;
+            acceleration_(i) = 0;
+        }
+        else
+        {
+            velocity_(i) += change;
+        }
+    }
+    return velocity_;
+}
+
+const Vector3& SetpointGenerator::get_velocity() const { return velocity_; }
+
+const Vector3& SetpointGenerator::get_acceleration() const
+{
+    return acceleration_;
+}
+
+bool SetpointGenerator::is_timed_out() const { return timed_out_; }
+
+void SetpointGenerator::set_limits(const SetpointLimits& limits)
+{
+    limits_ = limits;
+}
+
+const SetpointLimits& SetpointGenerator::get_limits() const { return limits_; }
+
+void SetpointGenerator::reset()
+{
+    target_ = Vector3::Zero();
+    velocity_ = Vector3::Zero();
+    acceleration_ = Vector3::Zero();
+    has_target_ = false;
+    timed_out_ = false;
+}
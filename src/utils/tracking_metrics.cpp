@@ -0,0 +1,138 @@
+/**
+ * @file tracking_metrics.cpp
+ * @author Jakob Friedl (friedl.jak@gmail.com)
+ * @brief Implementation of the TrackingMetrics class.
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "utils/tracking_metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdio.h>
+
+TrackingMetrics::TrackingMetrics(const scalar_t min_step,
+                                 const scalar_t settling_band)
+    : min_step_(min_step), settling_band_(settling_band)
+{
+}
+
+void TrackingMetrics::record(const scalar_t setpoint, const scalar_t measured,
+                             const scalar_t dt)
+{
+    if (samples_ > 0 && std::abs(setpoint - previous_setpoint_) >= min_step_)
+    {
+        finish_step();
+        in_step_ = true;
+        step_size_ = setpoint - previous_setpoint_;
+        step_time_ = 0;
+        last_outside_ = 0;
+        step_overshoot_ = 0;
+    }
+    else if (in_step_)
+    {
+        step_time_ += dt;
+    }
+    previous_setpoint_ = setpoint;
+
+    const scalar_t error = measured - setpoint;
+    samples_++;
+    squared_error_sum_ += double(error) * double(error);
+    max_error_ = std::max(max_error_, std::abs(error));
+
+    if (in_step_)
+    {
+        const scalar_t step_magnitude = std::abs(step_size_);
+        const scalar_t overshoot = step_size_ > 0 ? error : -error;
+        step_overshoot_ = std::max(step_overshoot_, overshoot / step_magnitude);
+        inside_ = std::abs(error) <= settling_band_ * step_magnitude;
+        if (!inside_)
+        {
+            last_outside_ = step_time_;
+        }
+    }
+}
+
+TrackingResult TrackingMetrics::get_result() const
+{
+    // Finish the current step on a copy, recording may go on
+    TrackingMetrics metrics = *this;
+    metrics.finish_step();
+
+    TrackingResult result;
+    result.samples = metrics.samples_;
+    if (metrics.samples_ > 0)
+    {
+        result.rmse =
+            scalar_t(std::sqrt(metrics.squared_error_sum_ / metrics.samples_));
+    }
+    result.max_error = metrics.max_error_;
+    result.steps = metrics.steps_;
+    result.max_overshoot = metrics.max_overshoot_;
+    if (metrics.settled_steps_ > 0)
+    {
+        result.mean_settling_time = scalar_t(metrics.settling_time_sum_ /
+                                             metrics.settled_steps_);
+    }
+    result.max_settling_time = metrics.max_settling_time_;
+    result.unsettled_steps = metrics.steps_ - metrics.settled_steps_;
+    return result;
+}
+
+void TrackingMetrics::reset()
+{
+    samples_ = 0;
+    squared_error_sum_ = 0;
+    max_error_ = 0;
+    previous_setpoint_ = 0;
+    in_step_ = false;
+    steps_ = 0;
+    settled_steps_ = 0;
+    settling_time_sum_ = 0;
+    max_settling_time_ = 0;
+    max_overshoot_ = 0;
+}
+
+void TrackingMetrics::finish_step()
+{
+    if (!in_step_)
+    {
+        return;
+    }
+    in_step_ = false;
+    steps_++;
+    max_overshoot_ = std::max(max_overshoot_, step_overshoot_);
+    if (inside_)
+    {
+        settled_steps_++;
+        settling_time_sum_ += last_outside_;
+        max_settling_time_ = std::max(max_settling_time_, last_outside_);
+    }
+}
+
+int format_tracking_json(const TrackingResult& result, char* buffer,
+                         const size_t size)
+{
+    // A settling time of 0 would read as an instant settling
+    char mean_settling_time[16] = "null";
+    char max_settling_time[16] = "null";
+    if (result.steps > result.unsettled_steps)
+    {
+        snprintf(mean_settling_time, sizeof(mean_settling_time), "%.4f",
+                 double(result.mean_settling_time));
+        snprintf(max_settling_time, sizeof(max_settling_time), "%.4f",
+                 double(result.max_settling_time));
+    }
+    return snprintf(buffer, size,
+                    "{\"samples\":%u,\"rmse\":%.4f,\"max_error\":%.4f,"
+                    "\"steps\":%u,\"max_overshoot\":%.4f,"
+                    "\"mean_settling_time\":%s,"
+                    "\"max_settling_time\":%s,\"unsettled_steps\":%u}",
+                    unsigned(result.samples), double(result.rmse),
+                    double(result.max_error), unsigned(result.steps),
+                    double(result.max_overshoot), mean_settling_time,
+                    max_settling_time, unsigned(result.unsettled_steps));
+}
@@ -10,58 +10,227 @@
  */
 
 #include "velocity_controller.hpp"
+#include <algorithm>
+#include <cmath>
 
-VelocityController::VelocityController(MotorControllerManager& motor_manager,
-                                       Kinematics* kinematics_model)
+template <int WheelCount>
+VelocityController<WheelCount>::VelocityController(
+    MotorControllerManager& motor_manager,
+    Kinematics<WheelCount>* kinematics_model)
     : motor_manager_(motor_manager), kinematics_model_(kinematics_model)
 {
     // Initialize latest_command and odometry_ to default values here
-    latest_command_ = Eigen::Vector3d::Zero();
-    robot_velocity_ = Eigen::Vector3d::Zero();
+    latest_command_ = Vector3::Zero();
+    robot_velocity_ = Vector3::Zero();
+    set_wheel_velocities_ = WheelVector::Zero();
+    actual_wheel_velocities_ = WheelVector::Zero();
 }
 
-void VelocityController::update()
+template <int WheelCount>
+void VelocityController<WheelCount>::update(const ControlTick& tick)
 {
-    Eigen::VectorXd desired_wheel_speeds =
-        kinematics_model_->calculate_wheel_velocity(latest_command_);
+    update_wheel_setpoints();
+    update_motors(tick);
+    update_robot_velocity();
+}
 
-    int motor_count = motor_manager_.get_motor_count();
-    if (desired_wheel_speeds.size() != motor_count)
+template <int WheelCount>
+void VelocityController<WheelCount>::update_wheel_setpoints()
+{
+    if (!has_all_motors())
     {
-        Serial.println("Not enough motor controllers");
         return;
     }
 
-    for (int i = 0; i < motor_count; ++i)
+    set_wheel_velocities_ =
+        kinematics_model_->calculate_wheel_velocity(latest_command_);
+    saturate();
+
+    for (int i = 0; i < WheelCount; ++i)
+    {
+        motor_manager_.set_motor_speed(i, set_wheel_velocities_(i));
+    }
+}
+
+template <int WheelCount>
+void VelocityController<WheelCount>::update_motors(const ControlTick& tick)
+{
+    if (!has_all_motors())
     {
-        motor_manager_.set_motor_speed(i, desired_wheel_speeds(i));
+        return;
     }
-    motor_manager_.update();
 
-    Eigen::VectorXd actual_wheel_speeds(motor_count);
-    for (int i = 0; i < motor_count; ++i)
+    motor_manager_.update(tick);
+
+    for (int i = 0; i < WheelCount; ++i)
     {
-        actual_wheel_speeds(i) = motor_manager_.get_motor_speed(i);
+        actual_wheel_velocities_(i) = motor_manager_.get_motor_speed(i);
     }
+}
 
+template <int WheelCount>
+void VelocityController<WheelCount>::update_robot_velocity()
+{
     robot_velocity_ =
-        kinematics_model_->calculate_robot_velocity(actual_wheel_speeds);
+        kinematics_model_->calculate_robot_velocity(actual_wheel_velocities_);
 }
 
-Eigen::Vector3d VelocityController::get_robot_velocity()
+template <int WheelCount>
+bool VelocityController<WheelCount>::has_all_motors() const
+{
+    if (motor_manager_.get_motor_count() != WheelCount)
+    {
+        Serial.println("Not enough motor controllers");
+        return false;
+    }
+    return true;
+}
+
+template <int WheelCount>
+Vector3 VelocityController<WheelCount>::get_robot_velocity()
 {
     // Return the latest odometry data
     return robot_velocity_;
 }
 
-Eigen::VectorXd VelocityController::get_set_wheel_velocities()
+template <int WheelCount>
+typename VelocityController<WheelCount>::WheelVector
+VelocityController<WheelCount>::get_set_wheel_velocities()
 {
     // Return the latest set wheel velocities
-    return kinematics_model_->calculate_wheel_velocity(latest_command_);
+    return set_wheel_velocities_;
 }
 
-void VelocityController::set_latest_command(
-    const Eigen::Vector3d& latest_command)
+template <int WheelCount>
+typename VelocityController<WheelCount>::WheelVector
+VelocityController<WheelCount>::get_actual_wheel_velocities()
+{
+    return actual_wheel_velocities_;
+}
+
+template <int WheelCount>
+void VelocityController<WheelCount>::set_latest_command(
+    const Vector3& latest_command)
 {
     latest_command_ = latest_command;
 }
+
+template <int WheelCount>
+void VelocityController<WheelCount>::set_wheel_speed_limits(
+    const WheelVector& max_wheel_speeds)
+{
+    max_wheel_speeds_ = max_wheel_speeds;
+}
+
+template <int WheelCount>
+void VelocityController<WheelCount>::set_saturation_policy(
+    const SaturationPolicy policy)
+{
+    saturation_policy_ = policy;
+}
+
+template <int WheelCount>
+scalar_t VelocityController<WheelCount>::get_saturation_scale() const
+{
+    return saturation_scale_;
+}
+
+template <int WheelCount>
+scalar_t
+VelocityController<WheelCount>::get_scale(const WheelVector& fixed,
+                                          const WheelVector& scaled) const
+{
+    scalar_t scale = 1;
+    for (int i = 0; i < WheelCount; ++i)
+    {
+        const scalar_t limit = max_wheel_speeds_(i);
+        const scalar_t magnitude = std::abs(scaled(i));
+        if (limit <= 0 || magnitude <= 0)
+        {
+            continue;
+        }
+        const scalar_t headroom =
+            limit - (scaled(i) > 0 ? fixed(i) : -fixed(i));
+        scale = std::min(scale, headroom / magnitude);
+    }
+    return std::max(scale, scalar_t(0.0));
+}
+
+template <int WheelCount>
+void VelocityController<WheelCount>::saturate()
+{
+    saturation_scale_ = 1;
+    if (saturation_policy_ == SaturationPolicy::NONE)
+    {
+        return;
+    }
+
+    // The parts of a twist can only be split with linear kinematics
+    const WheelVector none = WheelVector::Zero();
+    if (saturation_policy_ == SaturationPolicy::UNIFORM ||
+        !kinematics_model_->is_linear())
+    {
+        saturation_scale_ = get_scale(none, set_wheel_velocities_);
+        set_wheel_velocities_ *= saturation_scale_;
+        return;
+    }
+
+    // Split the command into the prioritized and the secondary part, the
+    // kinematics are linear in the twist
+    const bool rotation = saturation_policy_ ==
+                          SaturationPolicy::PRIORITIZE_ROTATION;
+    const Vector3 primary_command =
+        rotation ? Vector3(0, 0, latest_command_(2))
+                 : Vector3(latest_command_(0), latest_command_(1), 0);
+    const WheelVector primary =
+        kinematics_model_->calculate_wheel_velocity(primary_command);
+    const WheelVector secondary = set_wheel_velocities_ - primary;
+
+    const scalar_t primary_scale = get_scale(none, primary);
+    if (primary_scale < 1)
+    {
+        // Not even the prioritized part fits, drop the rest
+        saturation_scale_ = primary_scale;
+        set_wheel_velocities_ = primary * primary_scale;
+        return;
+    }
+    saturation_scale_ = get_scale(primary, secondary);
+    set_wheel_velocities_ = primary + secondary * saturation_scale_;
+}
+
+template <int WheelCount>
+void VelocityController<WheelCount>::get_motor_telemetry(
+    const uint8_t wheel_index, MotorTelemetry& telemetry) const
+{
+    motor_manager_.get_telemetry(wheel_index, telemetry);
+}
+
+template <int WheelCount>
+void VelocityController<WheelCount>::set_output_override(
+    const uint8_t wheel_index, const scalar_t output)
+{
+    motor_manager_.set_output_override(wheel_index, output);
+}
+
+template <int WheelCount>
+void VelocityController<WheelCount>::clear_output_override(
+    const uint8_t wheel_index)
+{
+    motor_manager_.clear_output_override(wheel_index);
+}
+
+template <int WheelCount>
+uint8_t VelocityController<WheelCount>::get_motor_faults(
+    const uint8_t wheel_index) const
+{
+    return motor_manager_.get_faults(wheel_index);
+}
+
+template <int WheelCount>
+void VelocityController<WheelCount>::clear_motor_faults()
+{
+    motor_manager_.clear_faults();
+}
+
+// Supported wheel counts
+template class VelocityController<4>;